@@ -22,12 +22,12 @@ void EEAIF_Task(void)
     EED_Task();
 }
 
-bool EEAIF_BeginRead(uint16_t offset_in_eeprom, uint8_t *dest, uint16_t size)
+bool EEAIF_BeginRead(MEEM_eepromOffset_t offset_in_eeprom, uint8_t *dest, MEEM_eepromSize_t size)
 {
     return EED_BeginRead(offset_in_eeprom, dest, size);
 }
 
-bool EEAIF_BeginWrite(uint16_t offset_in_eeprom, const uint8_t *source, uint16_t size)
+bool EEAIF_BeginWrite(MEEM_eepromOffset_t offset_in_eeprom, const uint8_t *source, MEEM_eepromSize_t size)
 {
     return EED_BeginWrite(offset_in_eeprom, source, size);
 }
@@ -13,6 +13,131 @@
 #include "MEEM_Internal.h"
 #include <assert.h>
 #include <string.h>
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+#include <stdatomic.h>
+#endif
+
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+/******************************************************************************/
+/*    Private macros                                                          */
+/******************************************************************************/
+#define MEEM_REQUEST_WORD_COUNT      ((MEEM_BLOCK_COUNT + 31u) / 32u)
+#define MEEM_REQUEST_WORD(block_id)  ((block_id) / 32u)
+#define MEEM_REQUEST_MASK(block_id)  ((uint_least32_t) 1u << ((block_id) % 32u))
+#endif
+#if (MEEM_USING_WRITE_TICKETS == true)
+/* A ticket holds the block's ID + 1 (so it's never 0) and the generation of the request */
+#define MEEM_MakeTicket(block_id, generation)        ((((MEEM_ticket_t) (block_id) + 1u) << 16) | (MEEM_ticket_t) (generation))
+#define MEEM_GetTicketBlockId(ticket)                ((uint8_t) (((ticket) >> 16) - 1u))
+#define MEEM_GetTicketGeneration(ticket)             ((uint16_t) (ticket))
+#define MEEM_IsGenerationReached(generation, target) ((int16_t) (uint16_t) ((generation) - (target)) >= 0)
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+#define MEEM_LoadGeneration(generation)              ((uint16_t) atomic_load_explicit(&(generation), memory_order_acquire))
+#define MEEM_StoreGeneration(generation, value)      atomic_store_explicit(&(generation), (value), memory_order_release)
+#else
+#define MEEM_LoadGeneration(generation)              (generation)
+#define MEEM_StoreGeneration(generation, value)      ((generation) = (value))
+#endif
+#endif
+#if (MEEM_USING_WRITE_THROTTLING == true)
+#if (MEEM_USING_SPECIALIZED_CORE == true)
+#define MEEM_ThrottledBlock(n)       (MEEM_throttled_blocks[(n)])
+#else
+/* Each block is visited by the throttling task. A block without limits is never throttled anyway. */
+#define MEEM_THROTTLED_BLOCK_COUNT   MEEM_BLOCK_COUNT
+#define MEEM_ThrottledBlock(n)       (n)
+#endif
+#endif
+#if (MEEM_USING_STREAMED_WRITES == true)
+/* A streamed instance's checksum is written last, to the first page of the instance again. Byte-wise writes cost nothing extra. */
+#define MEEM_CHECKSUM_PAGE_WRITES    1u
+#else
+#define MEEM_CHECKSUM_PAGE_WRITES    0u
+#endif
+
+#if (MEEM_USING_WRITE_BEHIND == true)
+/******************************************************************************/
+/*    Private variables                                                       */
+/******************************************************************************/
+/* Task periods until the automatic write of a dirty block. 0 - the block is clean. */
+static uint16_t MEEM_write_behind_timer[MEEM_BLOCK_COUNT];
+#endif
+
+#if (MEEM_USING_WRITE_THROTTLING == true)
+/******************************************************************************/
+/*    Private variables                                                       */
+/******************************************************************************/
+/* Task periods until the next write of a block may start. Requests in the meantime are merged into one deferred write. */
+static uint16_t MEEM_coalescing_timer[MEEM_BLOCK_COUNT];
+
+/* Writes, which a block with a write budget may start now. Each physical write consumes one. */
+static uint16_t MEEM_write_tokens[MEEM_BLOCK_COUNT];
+
+/* Task periods since the last earned write token */
+static uint32_t MEEM_write_budget_timer[MEEM_BLOCK_COUNT];
+
+/* Set by MEEM_Flush() to lift the limits until all pending writes are done */
+static bool MEEM_flush_requested;
+
+#if (MEEM_USING_SPECIALIZED_CORE == true)
+/* Blocks with a coalescing window or a write budget */
+static const uint8_t MEEM_throttled_blocks[MEEM_THROTTLED_BLOCK_COUNT] = MEEM_THROTTLED_BLOCK_IDS;
+#endif
+#endif
+
+#if (MEEM_USING_WRITE_TICKETS == true)
+/******************************************************************************/
+/*    Private variables                                                       */
+/******************************************************************************/
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+typedef atomic_uint_least16_t MEEM_generation_t;
+#else
+typedef uint16_t MEEM_generation_t;
+#endif
+
+/* Incremented by each ticketed request, before the request itself */
+static MEEM_generation_t MEEM_requested_generation[MEEM_BLOCK_COUNT];
+
+/* Generation, taken by the write in progress, along with the cache. Used by MEEM_PeriodicTask() only. */
+static uint16_t MEEM_started_generation[MEEM_BLOCK_COUNT];
+
+/* Generations, taken by the last completed write, and by the last successful one */
+static MEEM_generation_t MEEM_completed_generation[MEEM_BLOCK_COUNT];
+static MEEM_generation_t MEEM_persisted_generation[MEEM_BLOCK_COUNT];
+#endif
+
+#if (MEEM_USING_COMPLETION_QUEUE == true)
+/******************************************************************************/
+/*    Private variables                                                       */
+/******************************************************************************/
+static MEEM_completionEvent_t MEEM_completion_queue[MEEM_COMPLETION_QUEUE_SIZE];
+static uint8_t                MEEM_completion_queue_head;  /* Index of the oldest event */
+static uint8_t                MEEM_completion_queue_count;
+static bool                   MEEM_completion_events_lost; /* Set if an event was dropped since the last queued one */
+#endif
+
+#if (MEEM_USING_FLUSH_PLANNER == true)
+/******************************************************************************/
+/*    Private variables                                                       */
+/******************************************************************************/
+/* Set during MEEM_EmergencyFlush(), so each write is planned separately, without batching */
+static bool MEEM_emergency_flush_active;
+#endif
+
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+
+/******************************************************************************/
+/*    Private variables                                                       */
+/******************************************************************************/
+/* Write requests, submitted by any thread. Only set bits with atomic fetch-or. */
+static atomic_uint_least32_t MEEM_write_requests[MEEM_REQUEST_WORD_COUNT];
+
+/* Write requests, claimed by MEEM_PeriodicTask() with atomic exchange and not processed yet. Written by MEEM_PeriodicTask() only. */
+static atomic_uint_least32_t MEEM_claimed_write_requests[MEEM_REQUEST_WORD_COUNT];
+
+/* Profile switchover and range read requests. Set by any thread with atomic fetch-or, cleared by MEEM_PeriodicTask() with atomic fetch-and. */
+static atomic_uint_least32_t MEEM_fetch_requests[MEEM_REQUEST_WORD_COUNT];
+#endif
 
 /******************************************************************************/
 /*    Private operations prototypes                                           */
@@ -20,18 +145,68 @@
 static bool    MEEM_ProcessCurrentRequest(void);
 static void    MEEM_TryProcessNextRequest(void);
 static uint8_t MEEM_GetNextBlockToProcess(void);
+static bool    MEEM_IsAnyRequestPending(void);
+static void    MEEM_StartBlockWrite(uint8_t block_id);
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+static void    MEEM_ClaimWriteRequests(void);
+#endif
+#if (MEEM_USING_LAZY_BACKUP_VERIFY == true)
+static void    MEEM_TryStartBackupCopyVerification(void);
+#endif
+#if (MEEM_USING_SCRUBBING == true)
+static void    MEEM_TryScrubInIdleTime(void);
+#endif
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+static void    MEEM_TryEraseInIdleTime(void);
+#endif
+#if (MEEM_USING_WRITE_BEHIND == true)
+static void    MEEM_WriteBehindTask(void);
+#endif
+#if (MEEM_USING_WRITE_THROTTLING == true)
+static void    MEEM_WriteThrottlingTask(void);
+static bool    MEEM_IsWriteAllowed(uint8_t block_id);
+static void    MEEM_ConsumeWriteAllowance(uint8_t block_id);
+#define MEEM_IsWriteDue(block_id) (MEEM_IsWritePending(block_id) && MEEM_IsWriteAllowed(block_id))
+#else
+#define MEEM_IsWriteDue(block_id) MEEM_IsWritePending(block_id)
+#endif
+#if (MEEM_USING_FLUSH_PLANNER == true)
+static uint32_t MEEM_EstimateWriteTime(uint8_t device_id, MEEM_eepromOffset_t offset_in_eeprom, MEEM_eepromSize_t size);
+static uint32_t MEEM_EstimateBlockWriteTime(uint8_t block_id);
+static uint32_t MEEM_EstimateCurrentWriteTime(void);
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+static uint32_t MEEM_EstimateRangeWriteTime(uint8_t block_id);
+#endif
+static uint8_t  MEEM_SelectBlockToFlush(uint32_t budget_us);
+static void     MEEM_CompleteCurrentRequest(void);
+#endif
+#if (MEEM_USING_COMPLETION_QUEUE == true)
+static void    MEEM_PushCompletionEvent(uint8_t block_id, uint16_t generation, bool failed);
+#endif
+#if (MEEM_USING_WRITE_BATCHING == true)
+static bool    MEEM_IsFollowingBasicBlock(uint8_t block_id);
+static uint8_t MEEM_FindStartOfWriteBatch(uint8_t block_id);
+#endif
 
 /******************************************************************************/
 /*    Public operations                                                       */
 /******************************************************************************/
 void MEEM_Init(void)
 {
-    MEEM_ValidateConfiguration();
-    EEAIF_Init();
+    for (uint8_t lane = 0; lane < MEEM_DEVICE_COUNT; lane++)
+    {
+        MEEM_SelectLane(lane);
+        MEEM_DeviceInit();
+    }
+#if (MEEM_USING_TRANSACTIONS == true)
+    MEEM_SelectLane(0u); /* The journal is in the primary device */
+    MEEM_LoadTransactionRecord();
+#endif
 
     for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
     {
-        switch (MEEM_block_config[i].management_type)
+        MEEM_SelectLane(MEEM_BlockDevice(i));
+        switch (MEEM_ManagementType(&MEEM_block_config[i]))
         {
 #if (MEEM_USING_BASIC_BLOCKS == true)
             case MEEM_MGMT_BASIC:
@@ -48,6 +223,16 @@ void MEEM_Init(void)
                 MEEM_InitializeWearLevelingBlock(i);
                 break;
 #endif
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+            case MEEM_MGMT_FLASH_EMULATION:
+                MEEM_InitializeFlashEmulationBlock(i);
+                break;
+#endif
+#if (MEEM_USING_MEMORY_MAPPED_BLOCKS == true)
+            case MEEM_MGMT_MEMORY_MAPPED:
+                MEEM_InitializeMemoryMappedBlock(i);
+                break;
+#endif
 #if (MEEM_USING_MULTI_PROFILE_BLOCKS == true)
             case MEEM_MGMT_MULTI_PROFILE:
                 MEEM_block_status[i].index_of_active_instance = MEEM_SelectInitiallyActiveProfile(i);
@@ -61,55 +246,141 @@ void MEEM_Init(void)
             default:
                 break;
         }
+#if (MEEM_USING_TRANSACTIONS == true)
+        MEEM_ReplayJournaledBlock(i);
+#endif
         MEEM_OnBlockInitComplete(i);
     }
 
-    MEEM_global_status.current_operation     = MEEM_OPR_NONE;
-    MEEM_global_status.next_block_to_process = (MEEM_BLOCK_COUNT - 1u);
+    for (uint8_t lane = 0; lane < MEEM_DEVICE_COUNT; lane++)
+    {
+        MEEM_lane_status[lane].current_operation     = MEEM_OPR_NONE;
+        MEEM_lane_status[lane].next_block_to_process = (MEEM_BLOCK_COUNT - 1u);
+    }
+    MEEM_SelectLane(0u);
+#if (MEEM_USING_SCRUBBING == true)
+    memset(&MEEM_global_status.scrub, 0, sizeof(MEEM_global_status.scrub));
+#endif
+#if (MEEM_USING_WRITE_THROTTLING == true)
+    /* The budget lives in RAM - a single token after each start keeps the write count bounded even with frequent resets */
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        MEEM_coalescing_timer[i]   = 0;
+        MEEM_write_tokens[i]       = (MEEM_block_config[i].write_budget > 0u) ? 1u : 0u;
+        MEEM_write_budget_timer[i] = 0;
+    }
+    MEEM_flush_requested = false;
+#endif
 }
 
 void MEEM_DeInit(void)
 {
-    EEAIF_DeInit();
+    for (uint8_t lane = 0; lane < MEEM_DEVICE_COUNT; lane++)
+    {
+        MEEM_SelectLane(lane);
+        MEEM_CloseReadSink(); /* A fetch, cut short, mustn't leave its cache update open */
+        MEEM_DeviceDeInit();
+    }
+    MEEM_SelectLane(0u);
 
     memset(&MEEM_global_status, 0, sizeof(MEEM_global_status));
-    memset(MEEM_work_buffer, 0, sizeof(MEEM_work_buffer));
+    memset(MEEM_lane_status, 0, sizeof(MEEM_lane_status));
+    memset(MEEM_lane_work_buffer, 0, sizeof(MEEM_lane_work_buffer));
+
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+    for (uint8_t w = 0; w < MEEM_REQUEST_WORD_COUNT; w++)
+    {
+        atomic_store(&MEEM_write_requests[w], 0u);
+        atomic_store(&MEEM_claimed_write_requests[w], 0u);
+        atomic_store(&MEEM_fetch_requests[w], 0u);
+    }
+#endif
 
     for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
     {
-        memset(MEEM_block_config[i].cache, 0, MEEM_block_config[i].data_size);
+#if ((MEEM_USING_READ_THROUGH_BLOCKS == true) || (MEEM_USING_MEMORY_MAPPED_BLOCKS == true))
+        if (NULL != MEEM_block_config[i].cache) /* 'read-through' and 'memory-mapped' blocks have none */
+#endif
+        {
+            memset(MEEM_block_config[i].cache, 0, MEEM_CacheSize(&MEEM_block_config[i]));
+        }
         memset(&MEEM_block_status[i], 0, sizeof(MEEM_block_status));
     }
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+    memset(MEEM_range_request, 0, sizeof(MEEM_range_request));
+#endif
+#if (MEEM_USING_WRITE_BEHIND == true)
+    memset(MEEM_write_behind_timer, 0, sizeof(MEEM_write_behind_timer));
+#endif
+#if (MEEM_USING_WRITE_THROTTLING == true)
+    memset(MEEM_coalescing_timer, 0, sizeof(MEEM_coalescing_timer));
+    memset(MEEM_write_tokens, 0, sizeof(MEEM_write_tokens));
+    memset(MEEM_write_budget_timer, 0, sizeof(MEEM_write_budget_timer));
+    MEEM_flush_requested = false;
+#endif
+#if (MEEM_USING_TRANSACTIONS == true)
+    MEEM_global_status.transaction.stage = MEEM_TX_IDLE;
+#endif
+#if (MEEM_USING_WRITE_TICKETS == true)
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        MEEM_StoreGeneration(MEEM_requested_generation[i], 0u);
+        MEEM_StoreGeneration(MEEM_completed_generation[i], 0u);
+        MEEM_StoreGeneration(MEEM_persisted_generation[i], 0u);
+        MEEM_started_generation[i] = 0;
+    }
+#endif
+#if (MEEM_USING_COMPLETION_QUEUE == true)
+    MEEM_completion_queue_head  = 0;
+    MEEM_completion_queue_count = 0;
+    MEEM_completion_events_lost = false;
+#endif
 }
 
 void MEEM_PeriodicTask(void)
 {
-    if (false == MEEM_ProcessCurrentRequest())
+#if (MEEM_USING_WRITE_BEHIND == true)
+    MEEM_WriteBehindTask();
+#endif
+#if (MEEM_USING_WRITE_THROTTLING == true)
+    MEEM_WriteThrottlingTask();
+#endif
+    /* Each device has its own lane, so a slow device doesn't hold back the requests to the others */
+    for (uint8_t lane = 0; lane < MEEM_DEVICE_COUNT; lane++)
+    {
+        MEEM_SelectLane(lane);
+
+        if (false == MEEM_ProcessCurrentRequest())
+        {
+            MEEM_TryProcessNextRequest();
+#if (MEEM_USING_SCRUBBING == true)
+            if (0u == lane)
+            {
+                MEEM_TryScrubInIdleTime(); /* Only the primary device is scrubbed */
+            }
+#endif
+        }
+        MEEM_DeviceTask();
+    }
+    MEEM_SelectLane(0u);
+#if (MEEM_USING_WRITE_THROTTLING == true)
+    if (!MEEM_IsBusy())
     {
-        MEEM_TryProcessNextRequest();
+        MEEM_flush_requested = false; /* Everything flushed */
     }
-    EEAIF_Task();
+#endif
 }
 
 bool MEEM_IsBusy(void)
 {
-    if (MEEM_OPR_NONE != MEEM_global_status.current_operation)
-    {
-        return true;
-    }
-
-    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    for (uint8_t lane = 0; lane < MEEM_DEVICE_COUNT; lane++)
     {
-        if (
-#if (MEEM_USING_MULTI_PROFILE_BLOCKS == true)
-            MEEM_block_status[i].fetch_pending ||
-#endif
-            MEEM_block_status[i].write_pending)
+        if (MEEM_OPR_NONE != MEEM_lane_status[lane].current_operation)
         {
             return true;
         }
     }
-    return false;
+    return MEEM_IsAnyRequestPending();
 }
 
 void MEEM_Resume(void)
@@ -122,12 +393,59 @@ void MEEM_Suspend(void)
     MEEM_global_status.accept_new_requests = false;
 }
 
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+bool MEEM_InitiateBlockWrite(uint8_t block_id)
+{
+    assert(block_id < MEEM_BLOCK_COUNT);
+
+    if (!MEEM_global_status.accept_new_requests || MEEM_IsReadOnly(block_id))
+    {
+        return false;
+    }
+#if ((MEEM_USING_MULTI_PROFILE_BLOCKS == true) || (MEEM_USING_READ_THROUGH_BLOCKS == true))
+    if (MEEM_IsFetchPending(block_id))
+    {
+        return false;
+    }
+#endif
+
+    /* The release ordering publishes the cache changes, made by this thread before the request */
+    const uint_least32_t previous =
+        atomic_fetch_or_explicit(&MEEM_write_requests[MEEM_REQUEST_WORD(block_id)], MEEM_REQUEST_MASK(block_id), memory_order_release);
+
+    return (0u == (previous & MEEM_REQUEST_MASK(block_id)));
+}
+
+MEEM_blockStatus_t MEEM_GetBlockStatus(uint8_t block_id)
+{
+    assert(block_id < MEEM_BLOCK_COUNT);
+    MEEM_blockStatusPrivate_t status = MEEM_block_status[block_id];
+
+    /* The user never writes the status, so the flags, cleared by a request, are cleared here until the core takes the request */
+    status.write_pending = MEEM_IsWritePending(block_id);
+    status.fetch_pending = MEEM_IsFetchPending(block_id);
+    if (status.write_pending
+#if (MEEM_USING_TRANSACTIONS == true)
+        || MEEM_IsInCommittedTransaction(block_id)
+#endif
+    )
+    {
+        status.write_complete = false; /* The core clears it at the actual start of the write */
+    }
+    if (status.fetch_pending)
+    {
+        status.recovered = false; /* The core clears it at the start of the fetch */
+    }
+    return *((MEEM_blockStatus_t*) &status);
+}
+#else
 bool MEEM_InitiateBlockWrite(uint8_t block_id)
 {
     assert(block_id < MEEM_BLOCK_COUNT);
     bool accepted = false;
 
-    if (MEEM_global_status.accept_new_requests && !MEEM_block_status[block_id].write_pending && !MEEM_block_status[block_id].fetch_pending)
+    if (MEEM_global_status.accept_new_requests && !MEEM_block_status[block_id].write_pending && !MEEM_IsFetchPending(block_id) &&
+        !MEEM_IsReadOnly(block_id))
     {
         MEEM_block_status[block_id].write_pending  = true;
         MEEM_block_status[block_id].write_complete = false;
@@ -141,88 +459,1072 @@ MEEM_blockStatus_t MEEM_GetBlockStatus(uint8_t block_id)
     assert(block_id < MEEM_BLOCK_COUNT);
     return *((MEEM_blockStatus_t*) &MEEM_block_status[block_id]);
 }
+#endif
 
-/******************************************************************************/
-/*    Private operations                                                      */
-/******************************************************************************/
-/*!
- * \retval true if a request is currently being processed
- * \retval false no request is being processed now
- */
-static bool MEEM_ProcessCurrentRequest(void)
+void MEEM_Flush(void)
 {
-    if (MEEM_OPR_WRITE == MEEM_global_status.current_operation)
+#if (MEEM_USING_WRITE_BEHIND == true)
+    MEEM_EnterCriticalSection();
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
     {
-        if (MEEM_WriteTask())
+        if (0u != MEEM_write_behind_timer[i])
         {
-            MEEM_global_status.current_operation = MEEM_OPR_NONE;
-            MEEM_OnBlockWriteComplete(MEEM_global_status.block_id);
+            MEEM_write_behind_timer[i] = 1u; /* Expires on the next tick */
         }
     }
-#if (MEEM_USING_MULTI_PROFILE_BLOCKS == true)
-    else if (MEEM_OPR_INIT == MEEM_global_status.current_operation)
+    MEEM_ExitCriticalSection();
+#endif
+#if (MEEM_USING_WRITE_THROTTLING == true)
+    MEEM_flush_requested = true;
+#endif
+}
+
+#if (MEEM_USING_WRITE_TICKETS == true)
+MEEM_ticket_t MEEM_InitiateBlockWriteEx(uint8_t block_id)
+{
+    assert(block_id < MEEM_BLOCK_COUNT);
+    MEEM_ticket_t ticket = MEEM_INVALID_TICKET;
+
+    if (MEEM_global_status.accept_new_requests && !MEEM_IsFetchPending(block_id) && !MEEM_IsReadOnly(block_id))
     {
-        if (MEEM_InitMultiProfileBlockTask())
-        {
-            MEEM_global_status.current_operation = MEEM_OPR_NONE;
-            MEEM_OnMultiProfileBlockFetchComplete(MEEM_global_status.block_id);
-        }
+        /* Counted before the request, so the write, which takes the request, can't take an older generation */
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+        const uint16_t generation = (uint16_t) (atomic_fetch_add_explicit(&MEEM_requested_generation[block_id], 1u, memory_order_relaxed) + 1u);
+
+        MEEM_SubmitWriteRequest(block_id); /* Merged into the pending one, if any */
+#else
+        uint16_t generation;
+
+        /* The status byte and the 16-bit generation are shared with the periodic task */
+        MEEM_EnterCriticalSection();
+        generation                                 = ++MEEM_requested_generation[block_id];
+        MEEM_block_status[block_id].write_complete = false;
+        MEEM_SubmitWriteRequest(block_id); /* Merged into the pending one, if any */
+        MEEM_ExitCriticalSection();
+#endif
+        ticket = MEEM_MakeTicket(block_id, generation);
+    }
+    return ticket;
+}
+
+MEEM_ticketStatus_t MEEM_GetTicketStatus(MEEM_ticket_t ticket)
+{
+    if (MEEM_INVALID_TICKET == ticket)
+    {
+        return MEEM_TICKET_FAILED;
     }
+
+    const uint8_t  block_id   = MEEM_GetTicketBlockId(ticket);
+    const uint16_t generation = MEEM_GetTicketGeneration(ticket);
+    assert(block_id < MEEM_BLOCK_COUNT);
+
+    /* The completed generation is stored last, so once it's reached, the persisted one is up to date */
+#if (MEEM_USING_LOCK_FREE_REQUESTS != true)
+    MEEM_EnterCriticalSection();
 #endif
-    return (MEEM_global_status.current_operation != MEEM_OPR_NONE);
+    const uint16_t completed = MEEM_LoadGeneration(MEEM_completed_generation[block_id]);
+    const uint16_t persisted = MEEM_LoadGeneration(MEEM_persisted_generation[block_id]);
+#if (MEEM_USING_LOCK_FREE_REQUESTS != true)
+    MEEM_ExitCriticalSection();
+#endif
+
+    if (MEEM_IsGenerationReached(persisted, generation))
+    {
+        return MEEM_TICKET_DONE;
+    }
+    return MEEM_IsGenerationReached(completed, generation) ? MEEM_TICKET_FAILED : MEEM_TICKET_PENDING;
 }
 
-static void MEEM_TryProcessNextRequest(void)
+bool MEEM_IsTicketDone(MEEM_ticket_t ticket)
+{
+    return (MEEM_TICKET_PENDING != MEEM_GetTicketStatus(ticket));
+}
+
+MEEM_ticketStatus_t MEEM_WaitTicket(MEEM_ticket_t ticket)
 {
-    if (EEAIF_BUSY != EEAIF_GetStatus())
+    MEEM_ticketStatus_t status;
+
+    while (MEEM_TICKET_PENDING == (status = MEEM_GetTicketStatus(ticket)))
     {
-        uint8_t i = MEEM_GetNextBlockToProcess();
+        MEEM_PeriodicTask();
+    }
+    return status;
+}
+#endif
 
-        if (i < UINT8_MAX)
+#if (MEEM_USING_COMPLETION_QUEUE == true)
+bool MEEM_GetCompletionEvent(MEEM_completionEvent_t* event)
+{
+    bool taken = false;
+
+    MEEM_EnterCriticalSection();
+
+    if (0u != MEEM_completion_queue_count)
+    {
+        *event                     = MEEM_completion_queue[MEEM_completion_queue_head];
+        MEEM_completion_queue_head = MEEM_IncrementAndWrapAround(MEEM_completion_queue_head, MEEM_COMPLETION_QUEUE_SIZE);
+        MEEM_completion_queue_count--;
+        taken = true;
+    }
+
+    MEEM_ExitCriticalSection();
+    return taken;
+}
+#endif
+
+#if (MEEM_USING_WRITE_BEHIND == true)
+void MEEM_MarkBlockDirty(uint8_t block_id)
+{
+    assert(block_id < MEEM_BLOCK_COUNT);
+
+    MEEM_EnterCriticalSection();
+
+    /* The delay starts at the first change, so the data is never persisted later than the configured delay */
+    if (0u == MEEM_write_behind_timer[block_id])
+    {
+        MEEM_write_behind_timer[block_id] = (MEEM_block_config[block_id].write_behind_delay > 0u) ? MEEM_block_config[block_id].write_behind_delay : 1u;
+    }
+
+    MEEM_ExitCriticalSection();
+}
+#endif
+
+#if (MEEM_USING_SEQLOCK == true)
+/*!
+ * \brief      Copies a region of a block's cache without a critical section.
+ * \details    The copy is retried while the block's sequence counter shows a concurrent cache update, waiting for the writer in between.
+ *             MEEM_SEQLOCK_READ_ATTEMPTS limits the copies, so a reader, preempting a writer of the same block, doesn't spin forever.
+ * \param[in]  block_id - ID of the block, whose cache contains the region
+ * \param[in]  source - start of the region
+ * \param[out] destination - target of the copy
+ * \param[in]  size - size of the region in bytes
+ * \retval     true - the copy is consistent
+ * \retval     false - the cache was being updated during all attempts, the copy is unusable
+ */
+bool MEEM_ReadConsistent(uint8_t block_id, const volatile void* source, void* destination, uint16_t size)
+{
+    assert(block_id < MEEM_BLOCK_COUNT);
+
+    const volatile uint8_t* src = (const volatile uint8_t*) source;
+    uint8_t*                dst = (uint8_t*) destination;
+
+#if (MEEM_SEQLOCK_READ_ATTEMPTS == 0)
+    for (;;)
+#else
+    for (uint16_t attempt = 0; attempt < MEEM_SEQLOCK_READ_ATTEMPTS; attempt++)
+#endif
+    {
+        const uint8_t sequence = MEEM_block_sequence[block_id];
+        if (0u == (sequence & 1u)) /* Else an update is in progress */
         {
-            if (MEEM_block_status[i].write_pending)
+            MEEM_MemoryBarrier();
+
+            for (uint16_t i = 0; i < size; i++)
             {
-                MEEM_block_status[i].write_pending   = false; /* Clear as early as possible to allow further write requests to be registered */
-                MEEM_global_status.current_operation = MEEM_OPR_WRITE;
-                MEEM_StartWriteOperationCachedBlock(i);
-                MEEM_OnBlockWriteStarted(i);
+                dst[i] = src[i];
             }
-#if (MEEM_USING_MULTI_PROFILE_BLOCKS == true)
-            else if (MEEM_block_status[i].fetch_pending)
-            {
-                MEEM_block_status[i].fetch_pending   = false;
-                MEEM_global_status.current_operation = MEEM_OPR_INIT;
 
-                MEEM_StartReadOperation(i);
-                (void) MEEM_InitMultiProfileBlockTask();
-                MEEM_OnMultiProfileBlockFetchStarted(i);
+            MEEM_MemoryBarrier();
+            if (sequence == MEEM_block_sequence[block_id])
+            {
+                return true;
             }
-#endif
         }
+        MEEM_SeqlockWait();
     }
+    return false;
 }
+#endif
 
-/*!
- * \retval UINT8_MAX - if there's no pending block to process
- * \retval [0..MEEM_BLOCK_COUNT) - index of block to process
- */
-static uint8_t MEEM_GetNextBlockToProcess(void)
+#if (MEEM_USING_FLUSH_PLANNER == true)
+uint32_t MEEM_EstimateFlushTime(void)
 {
-    for (uint8_t c = 0; c < MEEM_BLOCK_COUNT; c++)
-    {
-        /* Always increment the index to ensure every block has a chance to be processed: */
-        MEEM_global_status.next_block_to_process = MEEM_IncrementAndWrapAround(MEEM_global_status.next_block_to_process, MEEM_BLOCK_COUNT);
-        uint8_t i                                = MEEM_global_status.next_block_to_process;
+    uint32_t time_us = MEEM_EstimateCurrentWriteTime();
 
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
         if (
-#if (MEEM_USING_MULTI_PROFILE_BLOCKS == true)
-            MEEM_block_status[i].fetch_pending ||
+#if (MEEM_USING_WRITE_BEHIND == true)
+            (0u != MEEM_write_behind_timer[i]) ||
 #endif
-            MEEM_block_status[i].write_pending)
+            MEEM_IsWritePending(i))
         {
-            return i;
+            time_us += MEEM_EstimateBlockWriteTime(i);
         }
     }
+    return time_us;
+}
 
-    return UINT8_MAX;
+uint8_t MEEM_EmergencyFlush(uint32_t budget_us)
+{
+    uint8_t written_count = 0;
+    uint8_t block_id;
+
+    MEEM_Suspend();
+    MEEM_Flush(); /* Lifts the write throttling */
+#if (MEEM_USING_WRITE_BEHIND == true)
+    MEEM_WriteBehindTask(); /* Turns all dirty blocks into pending writes */
+#endif
+
+    /* The operations in progress can't be aborted. Their whole writes are charged, as their progress is unknown. */
+    const uint32_t current_write_us = MEEM_EstimateCurrentWriteTime();
+    budget_us -= (current_write_us < budget_us) ? current_write_us : budget_us;
+    for (uint8_t lane = 0; lane < MEEM_DEVICE_COUNT; lane++)
+    {
+        MEEM_SelectLane(lane);
+        MEEM_CompleteCurrentRequest();
+    }
+
+    /* The writes are planned one after another, even on different devices, so the estimate holds for any driver */
+    MEEM_emergency_flush_active = true;
+    while (UINT8_MAX != (block_id = MEEM_SelectBlockToFlush(budget_us)))
+    {
+        const uint32_t write_us = MEEM_EstimateBlockWriteTime(block_id);
+
+        MEEM_SelectLane(MEEM_BlockDevice(block_id));
+        MEEM_StartBlockWrite(block_id);
+        if (MEEM_OPR_NONE != MEEM_lane.current_operation)
+        {
+            budget_us -= write_us; /* Skipped writes of unchanged data cost nothing, and are not counted */
+            written_count++;
+        }
+        MEEM_CompleteCurrentRequest();
+    }
+    MEEM_emergency_flush_active = false;
+    MEEM_SelectLane(0u);
+
+    return written_count;
+}
+#endif
+
+/******************************************************************************/
+/*    Internal operations                                                     */
+/******************************************************************************/
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+/*!
+ * \brief     Registers a write request on behalf of the core (e.g. write-behind of a dirty block).
+ * \param[in] block_id - ID of the block to write
+ */
+void MEEM_SubmitWriteRequest(uint8_t block_id)
+{
+    (void) atomic_fetch_or_explicit(&MEEM_write_requests[MEEM_REQUEST_WORD(block_id)], MEEM_REQUEST_MASK(block_id), memory_order_release);
 }
+
+/*!
+ * \brief     Registers a repair write request on behalf of the core (e.g. repair after init).
+ * \param[in] block_id - ID of the block to write
+ */
+void MEEM_SetWritePending(uint8_t block_id)
+{
+    MEEM_ForgetPersistedData(block_id);
+    MEEM_SubmitWriteRequest(block_id);
+}
+
+/*!
+ * \brief     Removes a block's write request, as its processing is about to start.
+ * \pre       Call from MEEM_PeriodicTask() context only!
+ * \param[in] block_id - ID of the block to write
+ */
+void MEEM_ClearWritePending(uint8_t block_id)
+{
+    /* Claim first, so a request which is not claimed yet can't cause a second write of the same data */
+    MEEM_ClaimWriteRequests();
+
+    atomic_fetch_and_explicit(&MEEM_claimed_write_requests[MEEM_REQUEST_WORD(block_id)], ~MEEM_REQUEST_MASK(block_id), memory_order_relaxed);
+    MEEM_block_status[block_id].write_complete = false;
+}
+
+/*!
+ * \retval true if the block has a submitted or claimed write request
+ * \retval false otherwise
+ */
+bool MEEM_IsWritePending(uint8_t block_id)
+{
+    const uint_least32_t requests = atomic_load_explicit(&MEEM_write_requests[MEEM_REQUEST_WORD(block_id)], memory_order_relaxed) |
+                                    atomic_load_explicit(&MEEM_claimed_write_requests[MEEM_REQUEST_WORD(block_id)], memory_order_relaxed);
+
+    return (0u != (requests & MEEM_REQUEST_MASK(block_id)));
+}
+
+/*!
+ * \brief     Registers a profile switchover or a range read of a block. Its parameters must be stored before the call.
+ * \param[in] block_id - ID of the block to fetch
+ */
+void MEEM_SubmitFetchRequest(uint8_t block_id)
+{
+    /* The release ordering publishes the request's parameters (e.g. the target profile) to MEEM_PeriodicTask() */
+    (void) atomic_fetch_or_explicit(&MEEM_fetch_requests[MEEM_REQUEST_WORD(block_id)], MEEM_REQUEST_MASK(block_id), memory_order_release);
+}
+
+/*!
+ * \brief     Removes a block's fetch request, as it's taken or completed.
+ * \pre       Call from MEEM_PeriodicTask() context only!
+ * \param[in] block_id - ID of the fetched block
+ */
+void MEEM_ClearFetchPending(uint8_t block_id)
+{
+    /* The release ordering publishes the fetched data (e.g. the range read) to the user */
+    (void) atomic_fetch_and_explicit(&MEEM_fetch_requests[MEEM_REQUEST_WORD(block_id)], ~MEEM_REQUEST_MASK(block_id), memory_order_release);
+}
+
+/*!
+ * \retval true if the block has a pending fetch request
+ * \retval false otherwise
+ */
+bool MEEM_IsFetchPending(uint8_t block_id)
+{
+    return (0u != (atomic_load_explicit(&MEEM_fetch_requests[MEEM_REQUEST_WORD(block_id)], memory_order_acquire) & MEEM_REQUEST_MASK(block_id)));
+}
+#endif
+
+#if (MEEM_USING_WRITE_BATCHING == true)
+/*!
+ * \brief  Appends the write images of the following 'basic' blocks to the one in the work buffer, while they are adjacent in the EEPROM,
+ *         their writes are due and the batch fits in MEEM_WRITE_BATCH_SIZE. The whole batch is then written with a single driver request.
+ * \pre    The image of the first block is ready, including its checksum.
+ */
+void MEEM_ExtendWriteBatch(void)
+{
+    if (MEEM_MGMT_BASIC != MEEM_ManagementType(&MEEM_block_config[MEEM_lane.block_id]))
+    {
+        return;
+    }
+#if (MEEM_USING_FLUSH_PLANNER == true)
+    if (MEEM_emergency_flush_active)
+    {
+        return; /* The planner accounts each block's write separately */
+    }
+#endif
+
+    for (uint8_t i = MEEM_lane.block_id + 1u; (i < MEEM_BLOCK_COUNT) && MEEM_IsFollowingBasicBlock(i) && MEEM_IsWriteDue(i); i++)
+    {
+        const MEEM_blockConfig_t* block_cfg  = &MEEM_block_config[i];
+        const uint16_t            image_size = sizeof(MEEM_checksum_t) + block_cfg->data_size;
+        uint8_t*                  image      = &MEEM_work_buffer[MEEM_lane.io_request.size];
+        MEEM_checksum_t           checksum;
+
+        if ((MEEM_lane.io_request.size + image_size) > MEEM_WRITE_BATCH_SIZE)
+        {
+            break;
+        }
+
+        MEEM_ClearWritePending(i);
+        MEEM_CaptureWriteGeneration(i);
+        MEEM_EnterCriticalSection();
+        MEEM_PackCache(i, &image[sizeof(MEEM_checksum_t)]);
+        MEEM_ExitCriticalSection();
+
+        /* Images in a batch are not aligned to the checksum's size */
+        checksum = MEEM_CalculateChecksum(&image[sizeof(MEEM_checksum_t)], block_cfg->data_size);
+        (void) memcpy(image, &checksum, sizeof(MEEM_checksum_t));
+
+        MEEM_RememberPersistedData(i, &image[sizeof(MEEM_checksum_t)]); /* Confirmed or forgotten when the batch completes */
+#if (MEEM_USING_WRITE_SKIPPING == true)
+        MEEM_block_status[i].write_skipped = false;
+#endif
+#if (MEEM_USING_WRITE_THROTTLING == true)
+        MEEM_ConsumeWriteAllowance(i);
+#endif
+        MEEM_lane.io_request.size += image_size;
+        MEEM_lane.batch_last_block_id = i; /* Reported as started, once the first block's write completes */
+    }
+}
+#endif
+
+#if (MEEM_USING_WRITE_TICKETS == true)
+/*!
+ * \brief     Captures the generation of the block's requests, which the cache holds now.
+ * \pre       Call after the block's write request is cleared, and before its cache is copied.
+ * \param[in] block_id - ID of the block to write
+ */
+void MEEM_CaptureWriteGeneration(uint8_t block_id)
+{
+#if (MEEM_USING_LOCK_FREE_REQUESTS != true)
+    MEEM_EnterCriticalSection();
+#endif
+    MEEM_started_generation[block_id] = MEEM_LoadGeneration(MEEM_requested_generation[block_id]);
+#if (MEEM_USING_LOCK_FREE_REQUESTS != true)
+    MEEM_ExitCriticalSection();
+#endif
+}
+
+/*!
+ * \brief     Completes the tickets, served by the write of a block, and notifies the user.
+ * \param[in] block_id - ID of the written block
+ */
+void MEEM_CompleteBlockWrite(uint8_t block_id)
+{
+    const uint16_t generation = MEEM_started_generation[block_id];
+    const bool     failed     = MEEM_lane.write_error;
+
+#if (MEEM_USING_LOCK_FREE_REQUESTS != true)
+    MEEM_EnterCriticalSection();
+#endif
+    if (!failed)
+    {
+        MEEM_StoreGeneration(MEEM_persisted_generation[block_id], generation);
+    }
+    MEEM_StoreGeneration(MEEM_completed_generation[block_id], generation);
+#if (MEEM_USING_LOCK_FREE_REQUESTS != true)
+    MEEM_ExitCriticalSection();
+#endif
+
+#if (MEEM_USING_COMPLETION_QUEUE == true)
+    MEEM_PushCompletionEvent(block_id, generation, failed);
+#else
+    MEEM_OnBlockWriteComplete(block_id);
+#endif
+}
+#endif
+
+/******************************************************************************/
+/*    Private operations                                                      */
+/******************************************************************************/
+/*!
+ * \retval true if a request is currently being processed
+ * \retval false no request is being processed now
+ */
+static bool MEEM_ProcessCurrentRequest(void)
+{
+    if (MEEM_OPR_WRITE == MEEM_lane.current_operation)
+    {
+        if (MEEM_WriteTask())
+        {
+            MEEM_lane.current_operation = MEEM_OPR_NONE;
+            MEEM_CompleteBlockWrite(MEEM_lane.block_id);
+#if (MEEM_USING_WRITE_BATCHING == true)
+            for (uint8_t i = MEEM_lane.block_id + 1u; i <= MEEM_lane.batch_last_block_id; i++)
+            {
+                /* The callbacks of the blocks, appended to the batch, follow the first block's, as if they were written alone */
+                MEEM_OnBlockWriteStarted(i);
+                MEEM_CompleteBlockWrite(i);
+            }
+#endif
+        }
+    }
+#if (MEEM_USING_MULTI_PROFILE_BLOCKS == true)
+    else if (MEEM_OPR_INIT == MEEM_lane.current_operation)
+    {
+        if (MEEM_InitMultiProfileBlockTask())
+        {
+            MEEM_lane.current_operation = MEEM_OPR_NONE;
+            MEEM_OnMultiProfileBlockFetchComplete(MEEM_lane.block_id);
+        }
+    }
+#endif
+#if (MEEM_USING_LAZY_BACKUP_VERIFY == true)
+    else if (MEEM_OPR_VERIFY == MEEM_lane.current_operation)
+    {
+        if (MEEM_VerifyBackupCopyTask())
+        {
+            MEEM_lane.current_operation = MEEM_OPR_NONE;
+        }
+    }
+#endif
+#if (MEEM_USING_TRANSACTIONS == true)
+    else if (MEEM_OPR_TRANSACTION == MEEM_lane.current_operation)
+    {
+        if (MEEM_TransactionTask())
+        {
+            MEEM_lane.current_operation = MEEM_OPR_NONE;
+        }
+    }
+#endif
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+    else if (MEEM_OPR_ERASE == MEEM_lane.current_operation)
+    {
+        if (MEEM_SectorEraseTask())
+        {
+            MEEM_lane.current_operation = MEEM_OPR_NONE;
+        }
+    }
+#endif
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+    else if (MEEM_OPR_READ_THROUGH == MEEM_lane.current_operation)
+    {
+        if (MEEM_ReadThroughTask())
+        {
+            MEEM_lane.current_operation = MEEM_OPR_NONE;
+        }
+    }
+#endif
+    return (MEEM_lane.current_operation != MEEM_OPR_NONE);
+}
+
+static void MEEM_TryProcessNextRequest(void)
+{
+    if (EEAIF_BUSY != MEEM_DeviceGetStatus())
+    {
+#if (MEEM_USING_TRANSACTIONS == true)
+        if ((0u == MEEM_active_lane) && MEEM_IsTransactionPending())
+        {
+            MEEM_StartTransaction(); /* Goes first, so the blocks of the transaction are written back-to-back */
+            return;
+        }
+#endif
+        uint8_t i = MEEM_GetNextBlockToProcess();
+
+        if (i < UINT8_MAX)
+        {
+            if (MEEM_IsWriteDue(i))
+            {
+#if (MEEM_USING_WRITE_BATCHING == true)
+                i = MEEM_FindStartOfWriteBatch(i);
+#endif
+                MEEM_StartBlockWrite(i);
+            }
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+            else if ((MEEM_MGMT_READ_THROUGH == MEEM_ManagementType(&MEEM_block_config[i])) && MEEM_IsFetchPending(i))
+            {
+                MEEM_block_status[i].recovered = false;
+                MEEM_lane.current_operation    = MEEM_OPR_READ_THROUGH;
+                MEEM_StartReadThroughOperation(i); /* fetch_pending is cleared, once the data is in the destination */
+            }
+#endif
+#if (MEEM_USING_MULTI_PROFILE_BLOCKS == true)
+            else if (MEEM_IsFetchPending(i))
+            {
+                MEEM_block_status[i].recovered = false;
+                MEEM_ClearFetchPending(i);
+                MEEM_lane.current_operation = MEEM_OPR_INIT;
+                MEEM_ForgetPersistedData(i); /* Another profile becomes active */
+
+                MEEM_StartReadOperation(i);
+                (void) MEEM_InitMultiProfileBlockTask();
+                MEEM_OnMultiProfileBlockFetchStarted(i);
+            }
+#endif
+        }
+#if ((MEEM_USING_LAZY_BACKUP_VERIFY == true) || (MEEM_USING_FLASH_EMULATION_BLOCKS == true))
+        else
+        {
+#if (MEEM_USING_LAZY_BACKUP_VERIFY == true)
+            MEEM_TryStartBackupCopyVerification(); /* Lowest priority - only if there are no user requests */
+#endif
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+            MEEM_TryEraseInIdleTime();
+#endif
+        }
+#endif
+    }
+}
+
+/*!
+ * \brief     Starts the write of a block with a pending write request. Completes it at once, if the write is redundant.
+ * \param[in] block_id - ID of the block to write
+ */
+static void MEEM_StartBlockWrite(uint8_t block_id)
+{
+    MEEM_ClearWritePending(block_id); /* Clear as early as possible to allow further write requests to be registered */
+    MEEM_CaptureWriteGeneration(block_id);
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+    if (MEEM_MGMT_READ_THROUGH == MEEM_ManagementType(&MEEM_block_config[block_id]))
+    {
+        /* Writes only the requested range. Never skipped - the block's data isn't known - nor throttled. */
+        MEEM_OnBlockWriteStarted(block_id);
+        MEEM_lane.current_operation = MEEM_OPR_READ_THROUGH;
+        MEEM_StartReadThroughOperation(block_id);
+        return;
+    }
+#endif
+#if (MEEM_USING_LAZY_BACKUP_VERIFY == true)
+    MEEM_block_status[block_id].verify_pending = false; /* Both copies will be written anyway */
+#endif
+    MEEM_lane.current_operation = MEEM_OPR_WRITE;
+    MEEM_StartWriteOperationCachedBlock(block_id);
+    MEEM_OnBlockWriteStarted(block_id);
+#if (MEEM_USING_WRITE_SKIPPING == true)
+    if (MEEM_IsWriteRedundant(block_id))
+    {
+        /* The EEPROM already holds this data - complete without touching it */
+        MEEM_block_status[block_id].write_skipped  = true;
+        MEEM_block_status[block_id].write_complete = true;
+        MEEM_lane.current_operation                = MEEM_OPR_NONE;
+        MEEM_CompleteBlockWrite(block_id);
+    }
+    else
+    {
+        MEEM_block_status[block_id].write_skipped = false;
+#if (MEEM_USING_WRITE_THROTTLING == true)
+        MEEM_ConsumeWriteAllowance(block_id);
+#endif
+    }
+#elif (MEEM_USING_WRITE_THROTTLING == true)
+    MEEM_ConsumeWriteAllowance(block_id);
+#endif
+}
+
+/*!
+ * \retval UINT8_MAX - if there's no pending block to process on the active lane
+ * \retval [0..MEEM_BLOCK_COUNT) - index of block to process
+ */
+static uint8_t MEEM_GetNextBlockToProcess(void)
+{
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+    MEEM_ClaimWriteRequests();
+#endif
+
+    for (uint8_t c = 0; c < MEEM_BLOCK_COUNT; c++)
+    {
+        /* Always increment the index to ensure every block has a chance to be processed: */
+        MEEM_lane.next_block_to_process = MEEM_IncrementAndWrapAround(MEEM_lane.next_block_to_process, MEEM_BLOCK_COUNT);
+        uint8_t i                       = MEEM_lane.next_block_to_process;
+
+        if (!MEEM_IsOnActiveLane(i))
+        {
+            continue; /* Processed by the lane of its own device */
+        }
+        if (
+#if ((MEEM_USING_MULTI_PROFILE_BLOCKS == true) || (MEEM_USING_READ_THROUGH_BLOCKS == true))
+            MEEM_IsFetchPending(i) ||
+#endif
+            MEEM_IsWriteDue(i))
+        {
+            return i;
+        }
+    }
+
+    return UINT8_MAX;
+}
+
+/*!
+ * \retval true if at least one block has a pending write, fetch or verification request
+ * \retval false otherwise
+ */
+static bool MEEM_IsAnyRequestPending(void)
+{
+#if (MEEM_USING_TRANSACTIONS == true)
+    if (MEEM_IsTransactionPending())
+    {
+        return true;
+    }
+#endif
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        if (
+#if ((MEEM_USING_MULTI_PROFILE_BLOCKS == true) || (MEEM_USING_READ_THROUGH_BLOCKS == true))
+            MEEM_IsFetchPending(i) ||
+#endif
+#if (MEEM_USING_LAZY_BACKUP_VERIFY == true)
+            MEEM_block_status[i].verify_pending ||
+#endif
+#if (MEEM_USING_WRITE_BEHIND == true)
+            (0u != MEEM_write_behind_timer[i]) ||
+#endif
+            MEEM_IsWritePending(i))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+/*!
+ * \brief  Moves all submitted write requests to the set of claimed ones, owned by MEEM_PeriodicTask().
+ */
+static void MEEM_ClaimWriteRequests(void)
+{
+    for (uint8_t w = 0; w < MEEM_REQUEST_WORD_COUNT; w++)
+    {
+        /* The acquire ordering makes the cache changes, made before the requests, visible to this thread */
+        const uint_least32_t requests = atomic_exchange_explicit(&MEEM_write_requests[w], 0u, memory_order_acquire);
+
+        if (0u != requests)
+        {
+            atomic_fetch_or_explicit(&MEEM_claimed_write_requests[w], requests, memory_order_relaxed);
+        }
+    }
+}
+#endif
+
+#if (MEEM_USING_LAZY_BACKUP_VERIFY == true)
+/*!
+ * \brief  Starts the verification of the first 'backup copy' block on the active lane, whose secondary instance has not been validated at init.
+ */
+static void MEEM_TryStartBackupCopyVerification(void)
+{
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        if (MEEM_block_status[i].verify_pending && MEEM_IsOnActiveLane(i))
+        {
+            MEEM_block_status[i].verify_pending = false;
+            MEEM_lane.current_operation         = MEEM_OPR_VERIFY;
+            MEEM_StartBackupCopyVerification(i);
+            return;
+        }
+    }
+}
+#endif
+
+#if (MEEM_USING_WRITE_BEHIND == true)
+/*!
+ * \brief  Counts down the delays of dirty blocks, and requests the write of those, whose delay has expired.
+ * \note   Dirty blocks are written even if the mEEM is suspended, as their changes precede the suspension.
+ */
+static void MEEM_WriteBehindTask(void)
+{
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        /* Most blocks are clean, so only a running timer is locked. A timer, started during the check, is counted from the next tick. */
+        if (0u == MEEM_write_behind_timer[i])
+        {
+            continue;
+        }
+
+        MEEM_EnterCriticalSection();
+
+        if ((0u != MEEM_write_behind_timer[i]) && (0u == --MEEM_write_behind_timer[i]))
+        {
+            /* A pending write will take the changes anyway. A pending profile switchover discards them, as the next profile is already active. */
+            if (
+#if (MEEM_USING_MULTI_PROFILE_BLOCKS == true)
+                !MEEM_IsFetchPending(i) &&
+#endif
+                !MEEM_IsWritePending(i))
+            {
+                MEEM_SubmitWriteRequest(i);
+            }
+        }
+
+        MEEM_ExitCriticalSection();
+    }
+}
+#endif
+
+#if (MEEM_USING_WRITE_THROTTLING == true)
+/*!
+ * \brief  Counts down the coalescing windows and earns the write tokens of blocks with a write budget.
+ */
+static void MEEM_WriteThrottlingTask(void)
+{
+    for (uint8_t n = 0; n < MEEM_THROTTLED_BLOCK_COUNT; n++)
+    {
+        const uint8_t i = MEEM_ThrottledBlock(n);
+
+        if (0u != MEEM_coalescing_timer[i])
+        {
+            MEEM_coalescing_timer[i]--;
+        }
+
+        if (MEEM_write_tokens[i] < MEEM_block_config[i].write_budget)
+        {
+            if (++MEEM_write_budget_timer[i] >= MEEM_block_config[i].write_budget_period)
+            {
+                MEEM_write_budget_timer[i] = 0;
+                MEEM_write_tokens[i]++;
+            }
+        }
+    }
+}
+
+/*!
+ * \retval true if a pending write of the block may start now
+ * \retval false if it stays deferred - further requests are merged into it
+ */
+static bool MEEM_IsWriteAllowed(uint8_t block_id)
+{
+    if (MEEM_flush_requested || !MEEM_global_status.accept_new_requests)
+    {
+        return true; /* Don't hold back anything before a shutdown */
+    }
+    return (0u == MEEM_coalescing_timer[block_id]) && ((0u == MEEM_block_config[block_id].write_budget) || (0u != MEEM_write_tokens[block_id]));
+}
+
+/*!
+ * \brief  Called when a physical write of the block starts
+ */
+static void MEEM_ConsumeWriteAllowance(uint8_t block_id)
+{
+    MEEM_coalescing_timer[block_id] = MEEM_block_config[block_id].coalescing_window;
+
+    if (0u != MEEM_write_tokens[block_id])
+    {
+        MEEM_write_tokens[block_id]--; /* May be zero already, if the write was forced by a flush */
+    }
+}
+#endif
+
+#if (MEEM_USING_FLUSH_PLANNER == true)
+/*!
+ * \brief     Estimates the time of a single EEPROM write from the count of pages it touches.
+ * \param[in] device_id - EEPROM device, which is written
+ * \param[in] offset_in_eeprom - start of the written area
+ * \param[in] size - size of the written area, in bytes
+ * \return    Estimated time, in microseconds
+ */
+static uint32_t MEEM_EstimateWriteTime(uint8_t device_id, MEEM_eepromOffset_t offset_in_eeprom, MEEM_eepromSize_t size)
+{
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+    const MEEM_deviceConfig_t* device_cfg = &MEEM_device_config[device_id];
+    const uint32_t             page_count = (device_cfg->page_size > 0u)
+                                                ? ((((uint32_t) offset_in_eeprom + size - 1u) / device_cfg->page_size) - (offset_in_eeprom / device_cfg->page_size) + 1u +
+                                                   MEEM_CHECKSUM_PAGE_WRITES)
+                                                : size;
+
+    return page_count * device_cfg->page_write_time_us;
+#else
+    (void) device_id;
+#if (MEEM_EEPROM_PAGE_SIZE > 0u)
+    const uint32_t page_count =
+        (((uint32_t) offset_in_eeprom + size - 1u) / MEEM_EEPROM_PAGE_SIZE) - (offset_in_eeprom / MEEM_EEPROM_PAGE_SIZE) + 1u + MEEM_CHECKSUM_PAGE_WRITES;
+#else
+    const uint32_t page_count = size; /* Byte-wise writes */
+    (void) offset_in_eeprom;
+#endif
+    return page_count * MEEM_PAGE_WRITE_TIME_US;
+#endif
+}
+
+/*!
+ * \brief     Estimates the time of the next write of a block, from the instances it will write.
+ * \param[in] block_id - ID of the block
+ * \return    Estimated time, in microseconds
+ */
+static uint32_t MEEM_EstimateBlockWriteTime(uint8_t block_id)
+{
+    const MEEM_blockConfig_t* block_cfg  = &MEEM_block_config[block_id];
+    const uint16_t            image_size = sizeof(MEEM_checksum_t) + block_cfg->data_size;
+    const uint8_t             device_id  = MEEM_BlockDevice(block_id);
+
+    switch (MEEM_ManagementType(block_cfg))
+    {
+        case MEEM_MGMT_BACKUP_COPY:
+            return MEEM_EstimateWriteTime(device_id, block_cfg->offset_in_eeprom, image_size) +
+                   MEEM_EstimateWriteTime(device_id, block_cfg->offset_in_eeprom + image_size, image_size);
+
+        case MEEM_MGMT_BASIC:
+            return MEEM_EstimateWriteTime(device_id, block_cfg->offset_in_eeprom, image_size);
+
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+        case MEEM_MGMT_READ_THROUGH:
+            return MEEM_EstimateRangeWriteTime(block_id);
+#endif
+
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+        case MEEM_MGMT_FLASH_EMULATION:
+            /* Normally, the sector is erased in idle time already */
+            return MEEM_EstimateWriteTime(device_id, block_cfg->offset_in_eeprom + MEEM_GetFlashSlotOffset(block_id, MEEM_block_status[block_id].index_of_active_instance), image_size) +
+                   (MEEM_IsEraseBeforeWriteNeeded(block_id) ? MEEM_SECTOR_ERASE_TIME_US : 0u);
+#endif
+
+#if (MEEM_USING_WEAR_LEVELING_BLOCKS == true)
+        case MEEM_MGMT_WEAR_LEVELING:
+            /* The next instance is written. The index is moved to it already, once the last written one is found on init and after each write. */
+            return MEEM_EstimateWriteTime(device_id, block_cfg->offset_in_eeprom + (image_size * (MEEM_eepromOffset_t) MEEM_block_status[block_id].index_of_active_instance),
+                                          image_size);
+#endif
+
+        default:
+            /* 'multi-profile' blocks write the active profile */
+            return MEEM_EstimateWriteTime(device_id, block_cfg->offset_in_eeprom + (image_size * (MEEM_eepromOffset_t) MEEM_block_status[block_id].index_of_active_instance),
+                                          image_size);
+    }
+}
+
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+/*!
+ * \brief     Estimates the time of the range write of a 'read-through' block, from the chunks it touches.
+ * \param[in] block_id - ID of the block
+ * \return    Estimated time, in microseconds. 0 if the block has no range write.
+ */
+static uint32_t MEEM_EstimateRangeWriteTime(uint8_t block_id)
+{
+    const MEEM_blockConfig_t*  block_cfg = &MEEM_block_config[block_id];
+    const MEEM_rangeRequest_t* request   = &MEEM_range_request[block_id];
+    const uint16_t             chunk_end = (0u == request->size) ? 0u : (uint16_t) (((request->offset + request->size - 1u) / block_cfg->chunk_size) + 1u);
+    uint32_t                   time_us   = 0;
+
+    if (!request->write)
+    {
+        return 0;
+    }
+    for (uint16_t chunk = request->offset / block_cfg->chunk_size; chunk < chunk_end; chunk++)
+    {
+        const uint16_t chunk_start = chunk * block_cfg->chunk_size;
+        const uint16_t remaining   = block_cfg->data_size - chunk_start;
+
+        time_us += MEEM_EstimateWriteTime(MEEM_BlockDevice(block_id),
+                                          block_cfg->offset_in_eeprom + ((MEEM_eepromOffset_t) chunk * (sizeof(MEEM_checksum_t) + block_cfg->chunk_size)),
+                                          sizeof(MEEM_checksum_t) + ((remaining < block_cfg->chunk_size) ? remaining : block_cfg->chunk_size));
+    }
+    return time_us;
+}
+#endif
+
+/*!
+ * \return Estimated time of the writes and erases in progress on all lanes, in microseconds. 0 if there are none.
+ */
+static uint32_t MEEM_EstimateCurrentWriteTime(void)
+{
+    uint32_t time_us = 0;
+
+    for (uint8_t lane = 0; lane < MEEM_DEVICE_COUNT; lane++)
+    {
+        const MEEM_laneStatus_t* lane_status = &MEEM_lane_status[lane];
+
+        if (MEEM_OPR_WRITE == lane_status->current_operation)
+        {
+            time_us += MEEM_EstimateBlockWriteTime(lane_status->block_id);
+#if (MEEM_USING_WRITE_BATCHING == true)
+            for (uint8_t i = lane_status->block_id + 1u; i <= lane_status->batch_last_block_id; i++)
+            {
+                time_us += MEEM_EstimateBlockWriteTime(i);
+            }
+#endif
+        }
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+        else if (MEEM_OPR_ERASE == lane_status->current_operation)
+        {
+            time_us += MEEM_SECTOR_ERASE_TIME_US;
+        }
+#endif
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+        else if (MEEM_OPR_READ_THROUGH == lane_status->current_operation)
+        {
+            time_us += MEEM_EstimateRangeWriteTime(lane_status->block_id); /* 0 for reads */
+        }
+#endif
+    }
+    return time_us;
+}
+
+/*!
+ * \brief     Selects the most critical pending block, whose write fits in the budget. Within the same priority, the shortest write wins,
+ *            so the most blocks are written.
+ * \param[in] budget_us - the rest of the time budget, in microseconds
+ * \retval    UINT8_MAX - if no pending write fits in the budget
+ * \retval    [0..MEEM_BLOCK_COUNT) - ID of the block to write next
+ */
+static uint8_t MEEM_SelectBlockToFlush(uint32_t budget_us)
+{
+    uint8_t  selected_id = UINT8_MAX;
+    uint32_t selected_us = 0;
+
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        if (MEEM_IsWritePending(i))
+        {
+            const uint32_t write_us = MEEM_EstimateBlockWriteTime(i);
+
+            if ((write_us <= budget_us) &&
+                ((UINT8_MAX == selected_id) || (MEEM_block_config[i].flush_priority > MEEM_block_config[selected_id].flush_priority) ||
+                 ((MEEM_block_config[i].flush_priority == MEEM_block_config[selected_id].flush_priority) && (write_us < selected_us))))
+            {
+                selected_id = i;
+                selected_us = write_us;
+            }
+        }
+    }
+    return selected_id;
+}
+
+/*!
+ * \brief  Runs the operation in progress on the active lane to its end, synchronously.
+ */
+static void MEEM_CompleteCurrentRequest(void)
+{
+    while (MEEM_ProcessCurrentRequest())
+    {
+        MEEM_DeviceTask();
+    }
+}
+#endif
+
+#if (MEEM_USING_COMPLETION_QUEUE == true)
+/*!
+ * \brief     Queues a write completion event. If the queue is full, the event is dropped.
+ * \param[in] block_id - ID of the written block
+ * \param[in] generation - generation of the requests, served by the write
+ * \param[in] failed - true if the write has failed
+ */
+static void MEEM_PushCompletionEvent(uint8_t block_id, uint16_t generation, bool failed)
+{
+    MEEM_EnterCriticalSection();
+
+    if (MEEM_completion_queue_count < MEEM_COMPLETION_QUEUE_SIZE)
+    {
+        MEEM_completionEvent_t* event = &MEEM_completion_queue[((uint16_t) MEEM_completion_queue_head + MEEM_completion_queue_count) % MEEM_COMPLETION_QUEUE_SIZE];
+
+        event->ticket      = MEEM_MakeTicket(block_id, generation);
+        event->block_id    = block_id;
+        event->failed      = failed;
+        event->lost_before = MEEM_completion_events_lost;
+        event->reserved    = 0;
+
+        MEEM_completion_queue_count++;
+        MEEM_completion_events_lost = false;
+    }
+    else
+    {
+        MEEM_completion_events_lost = true;
+    }
+
+    MEEM_ExitCriticalSection();
+}
+#endif
+
+#if (MEEM_USING_WRITE_BATCHING == true)
+/*!
+ * \retval true if the block is a 'basic' one and follows the previous 'basic' block in the same EEPROM device without a gap
+ * \retval false otherwise
+ */
+static bool MEEM_IsFollowingBasicBlock(uint8_t block_id)
+{
+    if (0u == block_id)
+    {
+        return false;
+    }
+
+    const MEEM_blockConfig_t* block_cfg    = &MEEM_block_config[block_id];
+    const MEEM_blockConfig_t* previous_cfg = &MEEM_block_config[block_id - 1u];
+
+    return (MEEM_MGMT_BASIC == MEEM_ManagementType(block_cfg)) && (MEEM_MGMT_BASIC == MEEM_ManagementType(previous_cfg)) &&
+           (MEEM_BlockDevice(block_id) == MEEM_BlockDevice(block_id - 1u)) && (block_cfg->offset_in_eeprom == (previous_cfg->offset_in_eeprom + sizeof(MEEM_checksum_t) + previous_cfg->data_size));
+}
+
+/*!
+ * \brief     Walks back from a block with a due write to the first one of the run of adjacent 'basic' blocks with due writes.
+ * \details   A batch grows towards higher addresses only, so starting at the lowest address writes the whole run at once.
+ * \param[in] block_id - ID of a block with a due write
+ * \return    ID of the block to start the write with
+ */
+static uint8_t MEEM_FindStartOfWriteBatch(uint8_t block_id)
+{
+    while (MEEM_IsFollowingBasicBlock(block_id) && MEEM_IsWriteDue(block_id - 1u))
+    {
+        block_id--;
+    }
+    return block_id;
+}
+#endif
+
+#if (MEEM_USING_SCRUBBING == true)
+/*!
+ * \brief  Runs a scrubbing step if there's nothing else to do. Any pending or started request aborts the scrubbing immediately.
+ */
+static void MEEM_TryScrubInIdleTime(void)
+{
+    if ((MEEM_OPR_NONE == MEEM_lane.current_operation) && MEEM_global_status.accept_new_requests && !MEEM_IsAnyRequestPending())
+    {
+        MEEM_ScrubTask();
+    }
+    else
+    {
+        MEEM_AbortScrub();
+    }
+}
+#endif
+
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+/*!
+ * \brief  Erases the sectors of 'flash emulation' blocks ahead of need, so their writes don't wait for it. Only the primary device holds such blocks.
+ */
+static void MEEM_TryEraseInIdleTime(void)
+{
+    if ((0u == MEEM_active_lane) && (MEEM_OPR_NONE == MEEM_lane.current_operation) && MEEM_global_status.accept_new_requests && MEEM_TryStartSectorErase())
+    {
+        MEEM_lane.current_operation = MEEM_OPR_ERASE;
+    }
+}
+#endif
@@ -3,6 +3,7 @@
  * \brief   Management routines, specific to 'backup copy' blocks.
  * These blocks have 1 parameter cache instance and 2 identical checksum-protected instances in the EEPROM.
  * At startup, the mEEM finds the first valid instance and uses it to initialize its parameter cache.
+ * With lazy verification, the secondary instance is read at startup only if the primary one is invalid. Otherwise it's verified later, in the background.
  * On each write, both EEPROM instances are written.
  * \author  Kaloyan Dimitrov
  * \copyright Copyright (c) 2025 Kaloyan Dimitrov
@@ -28,12 +29,11 @@
  */
 void MEEM_InitializeBackupCopyBlock(uint8_t block_id)
 {
-    const MEEM_blockConfig_t*  block_config = &MEEM_block_config[block_id];
-    MEEM_blockStatusPrivate_t* block_status = &MEEM_block_status[block_id];
-    uint8_t                    index_of_current_instance;
-    uint8_t                    instance_validity_mask;
-    bool                       cache_initialized;
-    MEEM_initStage_t           init_stage = MEEM_INIT_PREPARE;
+    const MEEM_blockConfig_t* block_config = &MEEM_block_config[block_id];
+    uint8_t                   index_of_current_instance;
+    uint8_t                   instance_validity_mask;
+    bool                      cache_initialized;
+    MEEM_initStage_t          init_stage = MEEM_INIT_PREPARE;
 
     do
     {
@@ -51,8 +51,9 @@ void MEEM_InitializeBackupCopyBlock(uint8_t block_id)
                 MEEM_status_t read_status;
 
                 MEEM_StartReadOperation(block_id);
-                MEEM_global_status.io_request.offset_in_eeprom =
-                    block_config->offset_in_eeprom + ((block_config->data_size + sizeof(MEEM_checksum_t)) * (uint16_t) index_of_current_instance);
+                MEEM_lane.io_request.offset_in_eeprom =
+                    block_config->offset_in_eeprom + ((block_config->data_size + sizeof(MEEM_checksum_t)) * (MEEM_eepromOffset_t) index_of_current_instance);
+                MEEM_SetReadSink(cache_initialized ? NULL : block_config->cache); /* Streamed until a valid instance is found */
                 do
                 {
                     read_status = MEEM_ReadOperationTask();
@@ -79,9 +80,24 @@ void MEEM_InitializeBackupCopyBlock(uint8_t block_id)
                     if (!cache_initialized)
                     {
                         cache_initialized = true;
-
-                        (void) memcpy(block_config->cache, &MEEM_work_buffer[sizeof(MEEM_checksum_t)], block_config->data_size);
+#if (MEEM_USING_STREAMING_IO != true)
+                        MEEM_BeginCacheUpdate(block_id);
+                        MEEM_UnpackCache(block_id, &MEEM_work_buffer[sizeof(MEEM_checksum_t)]);
+                        MEEM_EndCacheUpdate(block_id);
+                        MEEM_RememberPersistedData(block_id, &MEEM_work_buffer[sizeof(MEEM_checksum_t)]); /* Forgotten, if a copy turns out to need a repair */
+#else
+                        MEEM_RememberPersistedData(block_id, block_config->cache); /* Forgotten, if a copy turns out to need a repair */
+#endif
+                    }
+#if (MEEM_USING_LAZY_BACKUP_VERIFY == true)
+                    if (index_of_current_instance == 0)
+                    {
+                        /* The primary copy is valid, the secondary one will be verified in the background */
+                        MEEM_block_status[block_id].verify_pending = true;
+                        init_stage                                 = MEEM_INIT_READY;
+                        break;
                     }
+#endif
                 }
 
                 index_of_current_instance++;
@@ -105,13 +121,13 @@ void MEEM_InitializeBackupCopyBlock(uint8_t block_id)
                         break;
                     case 0:
                         /* Both invalid, repair. */
-                        block_status->write_pending = true; /* The write procedure will update both copies. */
-                        init_stage                  = MEEM_INIT_RECOVER_DATA;
+                        MEEM_SetWritePending(block_id); /* The write procedure will update both copies. */
+                        init_stage = MEEM_INIT_RECOVER_DATA;
                         break;
                     default:
                         /* Only one is valid, repair. */
-                        block_status->write_pending = true; /* The write procedure will update both copies. */
-                        init_stage                  = MEEM_INIT_READY;
+                        MEEM_SetWritePending(block_id); /* The write procedure will update both copies. */
+                        init_stage = MEEM_INIT_READY;
                         break;
                 }
                 break;
@@ -126,3 +142,44 @@ void MEEM_InitializeBackupCopyBlock(uint8_t block_id)
         }
     } while (MEEM_INIT_READY != init_stage);
 }
+
+#if (MEEM_USING_LAZY_BACKUP_VERIFY == true)
+/*!
+ * \brief    Initiates async read of the secondary instance of a 'backup copy' block, whose primary instance is already validated.
+ * \param[in] block_id of the block to verify
+ */
+void MEEM_StartBackupCopyVerification(uint8_t block_id)
+{
+    const MEEM_blockConfig_t* block_config = &MEEM_block_config[block_id];
+
+    MEEM_StartReadOperation(block_id);
+    MEEM_lane.io_request.offset_in_eeprom = block_config->offset_in_eeprom + block_config->data_size + sizeof(MEEM_checksum_t);
+    (void) MEEM_ReadOperationTask();
+}
+
+/*!
+ * \brief    Validates the secondary instance, fetched by #MEEM_StartBackupCopyVerification(), and schedules a repair if needed.
+ * \retval   true if verification completed
+ * \retval   false if verification is in progress
+ */
+bool MEEM_VerifyBackupCopyTask(void)
+{
+    switch (MEEM_ReadOperationTask())
+    {
+        case MEEM_OK:
+            if (!MEEM_IsDataValid(MEEM_lane.block_id))
+            {
+                MEEM_EnterCriticalSection();
+                MEEM_SetWritePending(MEEM_lane.block_id); /* The write procedure will update both copies. */
+                MEEM_ExitCriticalSection();
+            }
+            return true;
+
+        case MEEM_NOK:
+            return true; /* Can't read the EEPROM, nothing is known to be wrong with the copy */
+
+        default:
+            return false; /* Still busy */
+    }
+}
+#endif
@@ -25,8 +25,7 @@
  */
 void MEEM_InitializeBasicBlock(uint8_t block_id)
 {
-    const MEEM_blockConfig_t* block_cfg  = &MEEM_block_config[block_id];
-    MEEM_initStage_t          init_stage = MEEM_INIT_FETCH_INSTANCE;
+    MEEM_initStage_t init_stage = MEEM_INIT_FETCH_INSTANCE;
 
     MEEM_StartReadOperation(block_id);
 
@@ -61,8 +60,16 @@ void MEEM_InitializeBasicBlock(uint8_t block_id)
                 break;
 
             case MEEM_INIT_CACHE:
+#if (MEEM_USING_STREAMING_IO != true)
                 /* Just copy the content of the work buffer to data cache */
-                (void) memcpy(block_cfg->cache, &MEEM_work_buffer[sizeof(MEEM_checksum_t)], block_cfg->data_size);
+                MEEM_BeginCacheUpdate(block_id);
+                MEEM_UnpackCache(block_id, &MEEM_work_buffer[sizeof(MEEM_checksum_t)]);
+                MEEM_EndCacheUpdate(block_id);
+                MEEM_RememberPersistedData(block_id, &MEEM_work_buffer[sizeof(MEEM_checksum_t)]);
+#else /* The data is already streamed to the cache */
+                MEEM_RememberPersistedData(block_id, MEEM_block_config[block_id].cache);
+                MEEM_CloseReadSink();
+#endif
                 init_stage = MEEM_INIT_READY;
                 break;
 
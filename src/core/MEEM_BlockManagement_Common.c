@@ -16,12 +16,53 @@
 #include <string.h>
 #include <assert.h>
 
+/******************************************************************************/
+/*    Macros                                                                  */
+/******************************************************************************/
+#define MEEM_FINGERPRINT_SEED 2166136261u /* FNV-1a offset basis */
+#if (MEEM_USING_ZERO_COPY_WRITES == true)
+/* Limits the repetitions of a write, so a cache, updated more often than it can be written, doesn't occupy the lane forever */
+#define MEEM_ZERO_COPY_MAX_ATTEMPTS 4u
+#endif
+
 /******************************************************************************/
 /*    Internal variables                                                      */
 /******************************************************************************/
 MEEM_globalStatus_t       MEEM_global_status;
+MEEM_laneStatus_t         MEEM_lane_status[MEEM_DEVICE_COUNT];
 MEEM_blockStatusPrivate_t MEEM_block_status[MEEM_BLOCK_COUNT];
-uint8_t                   MEEM_work_buffer[MEEM_WORKBUFFER_SIZE];
+uint8_t                   MEEM_lane_work_buffer[MEEM_DEVICE_COUNT][MEEM_WORKBUFFER_SIZE];
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+uint8_t                   MEEM_active_lane;
+#endif
+#if (MEEM_USING_WRITE_SKIPPING == true)
+uint32_t                  MEEM_persisted_fingerprint[MEEM_BLOCK_COUNT];
+#endif
+
+/******************************************************************************/
+/*    Private operations prototypes                                           */
+/******************************************************************************/
+#if (MEEM_USING_WRITE_SKIPPING == true)
+static uint32_t MEEM_UpdateFingerprint(uint32_t fingerprint, const uint8_t* data, uint16_t data_size);
+static uint32_t MEEM_CalculateFingerprint(uint8_t block_id, const uint8_t* data);
+#endif
+static void     MEEM_LoadDefaults(uint8_t block_id);
+static bool     MEEM_BeginRead(void);
+#if (MEEM_USING_STREAMING_IO == true)
+static uint8_t* MEEM_GetReadChunk(MEEM_eepromSize_t* size);
+static bool     MEEM_ConsumeReadChunk(void);
+#endif
+#if (MEEM_USING_STREAMED_WRITES == true)
+static void     MEEM_WriteNextChunk(void);
+static void     MEEM_CopyCacheChunk(const MEEM_blockConfig_t* block_cfg, uint16_t position, uint16_t size);
+#if (MEEM_USING_WRITE_SKIPPING == true)
+static uint32_t MEEM_FingerprintCacheChunk(uint32_t fingerprint, const MEEM_blockConfig_t* block_cfg, uint16_t position, uint16_t size);
+#endif
+#endif
+#if (MEEM_USING_ZERO_COPY_WRITES == true)
+static void           MEEM_SnapshotCacheImage(void);
+static MEEM_ioStage_t MEEM_CheckWrittenImage(void);
+#endif
 
 /******************************************************************************/
 /*    Internal operations                                                     */
@@ -35,18 +76,20 @@ void MEEM_StartReadOperation(uint8_t block_id)
 {
     const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[block_id];
 
-    MEEM_global_status.block_id          = block_id;
-    MEEM_global_status.init_stage        = MEEM_INIT_FETCH_INSTANCE;
-    MEEM_global_status.io_request.stage  = MEEM_IO_INITIATE;
-    MEEM_global_status.io_request.status = MEEM_BUSY;
-    MEEM_global_status.io_request.data   = MEEM_work_buffer;
-    MEEM_global_status.io_request.size   = block_cfg->data_size + sizeof(MEEM_checksum_t);
+    MEEM_lane.block_id          = block_id;
+    MEEM_lane.init_stage        = MEEM_INIT_FETCH_INSTANCE;
+    MEEM_lane.io_request.stage  = MEEM_IO_INITIATE;
+    MEEM_lane.io_request.status = MEEM_BUSY;
+    MEEM_lane.io_request.data   = MEEM_work_buffer;
+    MEEM_lane.io_request.size   = block_cfg->data_size + sizeof(MEEM_checksum_t);
+    MEEM_SetReadSink(NULL);
 
-    switch (block_cfg->management_type)
+    switch (MEEM_ManagementType(block_cfg))
     {
 #if (MEEM_USING_BASIC_BLOCKS == true)
         case MEEM_MGMT_BASIC:
-            MEEM_global_status.io_request.offset_in_eeprom = block_cfg->offset_in_eeprom;
+            MEEM_lane.io_request.offset_in_eeprom = block_cfg->offset_in_eeprom;
+            MEEM_SetReadSink(block_cfg->cache);
             break;
 #endif
 #if (MEEM_USING_MULTI_PROFILE_BLOCKS == true)
@@ -57,14 +100,23 @@ void MEEM_StartReadOperation(uint8_t block_id)
             /* A read can be started only if the profile is already initialized! */
             assert(block_status->index_of_active_instance != MEEM_INVALID_PROFILE_INSTANCE);
 
-            MEEM_global_status.io_request.offset_in_eeprom =
-                block_cfg->offset_in_eeprom + ((uint16_t) block_status->index_of_active_instance * MEEM_global_status.io_request.size);
+            MEEM_lane.io_request.offset_in_eeprom =
+                block_cfg->offset_in_eeprom + ((MEEM_eepromOffset_t) block_status->index_of_active_instance * MEEM_lane.io_request.size);
+            MEEM_SetReadSink(block_cfg->cache);
         }
         break;
 #endif
         default:
             break;
     }
+
+#if (MEEM_USING_STREAMING_IO == true)
+    if (NULL != MEEM_lane.io_request.sink)
+    {
+        /* Readers see an update in progress, until the fetched data is validated or replaced by the defaults */
+        MEEM_BeginCacheUpdate(block_id);
+    }
+#endif
 }
 
 /*!
@@ -74,34 +126,50 @@ void MEEM_StartReadOperation(uint8_t block_id)
  */
 MEEM_status_t MEEM_ReadOperationTask(void)
 {
-    switch (MEEM_global_status.io_request.stage)
+    switch (MEEM_lane.io_request.stage)
     {
         case MEEM_IO_INITIATE:
-            if (EEAIF_BeginRead(MEEM_global_status.io_request.offset_in_eeprom, MEEM_global_status.io_request.data, MEEM_global_status.io_request.size))
+#if (MEEM_USING_STREAMING_IO == true)
+            MEEM_lane.io_request.transferred = 0;
+            MEEM_lane.io_request.checksum    = MEEM_CalculateChecksum(MEEM_work_buffer, 0);
+#endif
+            if (MEEM_BeginRead())
             {
-                MEEM_global_status.io_request.stage = MEEM_IO_WAITING;
+                MEEM_lane.io_request.stage = MEEM_IO_WAITING;
             }
             else
             {
-                MEEM_global_status.io_request.status = MEEM_NOK;
-                MEEM_global_status.io_request.stage  = MEEM_IO_COMPLETE;
+                MEEM_lane.io_request.status = MEEM_NOK;
+                MEEM_lane.io_request.stage  = MEEM_IO_COMPLETE;
                 assert(false); /* Wrong time to put a request (development error)! */
             }
             break;
 
         case MEEM_IO_WAITING:
-            EEAIF_Task();
+            MEEM_DeviceTask();
 
-            switch (EEAIF_GetStatus())
+            switch (MEEM_DeviceGetStatus())
             {
                 case EEAIF_OK:
-                    MEEM_global_status.io_request.status = MEEM_OK;
-                    MEEM_global_status.io_request.stage  = MEEM_IO_COMPLETE;
+#if (MEEM_USING_STREAMING_IO == true)
+                    if (!MEEM_ConsumeReadChunk())
+                    {
+                        if (!MEEM_BeginRead())
+                        {
+                            MEEM_lane.io_request.status = MEEM_NOK;
+                            MEEM_lane.io_request.stage  = MEEM_IO_COMPLETE;
+                            assert(false); /* The driver must be free, after it completed the previous chunk */
+                        }
+                        break;
+                    }
+#endif
+                    MEEM_lane.io_request.status = MEEM_OK;
+                    MEEM_lane.io_request.stage  = MEEM_IO_COMPLETE;
                     break;
 
                 case EEAIF_NOK:
-                    MEEM_global_status.io_request.status = MEEM_NOK;
-                    MEEM_global_status.io_request.stage  = MEEM_IO_COMPLETE;
+                    MEEM_lane.io_request.status = MEEM_NOK;
+                    MEEM_lane.io_request.stage  = MEEM_IO_COMPLETE;
                     break;
 
                 default:
@@ -113,7 +181,7 @@ MEEM_status_t MEEM_ReadOperationTask(void)
             break; /* MEEM_IO_COMPLETE */
     }
 
-    return MEEM_global_status.io_request.status;
+    return MEEM_lane.io_request.status;
 }
 
 /*!
@@ -121,36 +189,68 @@ MEEM_status_t MEEM_ReadOperationTask(void)
  * \param[in] block_id - ID of the block to write
  */
 void MEEM_StartWriteOperationCachedBlock(uint8_t block_id)
+{
+    MEEM_PrepareWriteOperation(block_id);
+
+#if (MEEM_USING_ZERO_COPY_WRITES == true)
+    /* The image is written straight from the cache, which is preceded by the checksum */
+    MEEM_lane.io_request.data = MEEM_block_config[block_id].cache - sizeof(MEEM_checksum_t);
+#elif (MEEM_USING_STREAMED_WRITES != true)
+    /* First stage of write image preparation - copy block's data cache to the work buffer */
+    MEEM_EnterCriticalSection();
+
+    MEEM_PackCache(block_id, &MEEM_work_buffer[sizeof(MEEM_checksum_t)]);
+
+    MEEM_ExitCriticalSection();
+#endif /* Otherwise, the cache is copied chunk by chunk, while it's written */
+}
+
+/*!
+ * \brief    Sets up an async write of the block's data from the work buffer to the next instance in the EEPROM.
+ * \param[in] block_id - ID of the block to write
+ */
+void MEEM_PrepareWriteOperation(uint8_t block_id)
 {
     const MEEM_blockConfig_t*  block_cfg    = &MEEM_block_config[block_id];
     MEEM_blockStatusPrivate_t* block_status = &MEEM_block_status[block_id];
 
-    if ((block_cfg->management_type == MEEM_MGMT_BASIC) || (block_cfg->management_type == MEEM_MGMT_BACKUP_COPY))
+    if ((MEEM_ManagementType(block_cfg) == MEEM_MGMT_BASIC) || (MEEM_ManagementType(block_cfg) == MEEM_MGMT_BACKUP_COPY))
+    {
+        MEEM_lane.io_request.offset_in_eeprom  = 0;
+        block_status->index_of_active_instance = 0;
+    }
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+    else if (MEEM_ManagementType(block_cfg) == MEEM_MGMT_FLASH_EMULATION)
     {
-        MEEM_global_status.io_request.offset_in_eeprom = 0;
-        block_status->index_of_active_instance         = 0;
+        MEEM_lane.io_request.offset_in_eeprom = MEEM_GetFlashSlotOffset(block_id, block_status->index_of_active_instance);
     }
+#endif
 #if ((MEEM_USING_BACKUP_COPY_BLOCKS == true) || (MEEM_USING_WEAR_LEVELING_BLOCKS == true))
     else
     {
-        MEEM_global_status.io_request.offset_in_eeprom = (sizeof(MEEM_checksum_t) + block_cfg->data_size) * (uint16_t) block_status->index_of_active_instance;
+        MEEM_lane.io_request.offset_in_eeprom = (sizeof(MEEM_checksum_t) + block_cfg->data_size) * (MEEM_eepromOffset_t) block_status->index_of_active_instance;
     }
 #endif
 
-    MEEM_global_status.io_request.offset_in_eeprom += block_cfg->offset_in_eeprom;
-    MEEM_global_status.io_request.size   = (block_cfg->data_size + sizeof(MEEM_checksum_t));
-    MEEM_global_status.io_request.data   = MEEM_work_buffer;
-    MEEM_global_status.io_request.status = MEEM_BUSY;
+    MEEM_lane.io_request.offset_in_eeprom += block_cfg->offset_in_eeprom;
+    MEEM_lane.io_request.size   = (block_cfg->data_size + sizeof(MEEM_checksum_t));
+    MEEM_lane.io_request.data   = MEEM_work_buffer;
+    MEEM_lane.io_request.status = MEEM_BUSY;
 
-    MEEM_global_status.block_id    = block_id;
-    MEEM_global_status.write_stage = MEEM_IO_INITIATE; /* Next stage to execute */
-
-    /* First stage of write image preparation - copy block's data cache to the work buffer */
-    MEEM_EnterCriticalSection();
-
-    (void) memcpy(&MEEM_work_buffer[sizeof(MEEM_checksum_t)], block_cfg->cache, block_cfg->data_size);
-
-    MEEM_ExitCriticalSection();
+    MEEM_lane.block_id    = block_id;
+    MEEM_lane.write_stage = MEEM_IO_INITIATE; /* Next stage to execute */
+#if (MEEM_USING_WRITE_BATCHING == true)
+    MEEM_lane.batch_last_block_id = block_id;
+#endif
+#if ((MEEM_USING_WRITE_SKIPPING == true) || (MEEM_USING_WRITE_TICKETS == true) || (MEEM_USING_FLASH_EMULATION_BLOCKS == true))
+    MEEM_lane.write_error = false;
+#endif
+#if (((MEEM_USING_STREAMED_WRITES == true) || (MEEM_USING_ZERO_COPY_WRITES == true)) && (MEEM_USING_WRITE_SKIPPING == true))
+    MEEM_lane.write_torn = false;
+#endif
+#if (MEEM_USING_ZERO_COPY_WRITES == true)
+    MEEM_lane.write_attempts = 0;
+#endif
 }
 
 /*!
@@ -160,27 +260,53 @@ void MEEM_StartWriteOperationCachedBlock(uint8_t block_id)
  */
 bool MEEM_WriteTask(void)
 {
-    switch (MEEM_global_status.write_stage)
+    switch (MEEM_lane.write_stage)
     {
         case MEEM_IO_INITIATE:
-            MEEM_CalculateAndSetChecksum();
+#if (MEEM_USING_ZERO_COPY_WRITES == true)
+            if (MEEM_lane.io_request.data == MEEM_work_buffer)
+            {
+                MEEM_CalculateAndSetChecksum(); /* Otherwise, it's calculated in the cache, when each instance's write is initiated */
+            }
+#elif (MEEM_USING_STREAMED_WRITES != true)
+            MEEM_CalculateAndSetChecksum(); /* Otherwise, it's calculated along the streamed data and written last */
+#endif
+#if (MEEM_USING_WRITE_BATCHING == true)
+            if (MEEM_OPR_WRITE == MEEM_lane.current_operation)
+            {
+                MEEM_ExtendWriteBatch(); /* Transactions write their blocks one by one */
+            }
+#endif
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+            if (MEEM_BeginEraseBeforeWrite())
+            {
+                MEEM_lane.write_stage = MEEM_IO_ERASING; /* The sector wasn't erased in idle time */
+                break;
+            }
+#endif
             MEEM_WriteInitiate();
-            MEEM_global_status.write_stage = MEEM_IO_WAITING;
+            MEEM_lane.write_stage = MEEM_IO_WAITING;
             break;
 
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+        case MEEM_IO_ERASING:
+            MEEM_lane.write_stage = MEEM_WaitForEraseBeforeWrite();
+            break;
+#endif
+
         case MEEM_IO_WAITING:
-            MEEM_global_status.write_stage = MEEM_WriteWaitToComplete();
+            MEEM_lane.write_stage = MEEM_WriteWaitToComplete();
             break;
 
         case MEEM_IO_FINALIZE:
-            MEEM_global_status.write_stage = MEEM_WriteFinalize();
+            MEEM_lane.write_stage = MEEM_WriteFinalize();
             break;
 
         default:
             break; /* MEEM_IO_COMPLETE */
     }
 
-    return (MEEM_IO_COMPLETE == MEEM_global_status.write_stage);
+    return (MEEM_IO_COMPLETE == MEEM_lane.write_stage);
 }
 
 /*!
@@ -189,8 +315,8 @@ bool MEEM_WriteTask(void)
 void MEEM_CalculateAndSetChecksum(void)
 {
     /* Prepare the write image - step 2: Calculate and set the checksum */
-    *((MEEM_checksum_t*) &MEEM_work_buffer[0]) =
-        MEEM_CalculateChecksum(&MEEM_work_buffer[sizeof(MEEM_checksum_t)], (MEEM_global_status.io_request.size - sizeof(MEEM_checksum_t)));
+    *((MEEM_checksum_t*) &MEEM_lane.io_request.data[0]) =
+        MEEM_CalculateChecksum(&MEEM_lane.io_request.data[sizeof(MEEM_checksum_t)], (MEEM_lane.io_request.size - sizeof(MEEM_checksum_t)));
 }
 
 /*!
@@ -198,11 +324,27 @@ void MEEM_CalculateAndSetChecksum(void)
  */
 void MEEM_WriteInitiate(void)
 {
+#if (MEEM_USING_STREAMED_WRITES == true)
+    /* Each instance is streamed from the start of the cache */
+    MEEM_lane.io_request.transferred = 0;
+    MEEM_lane.io_request.checksum    = MEEM_CalculateChecksum(MEEM_work_buffer, 0);
+#if (MEEM_USING_WRITE_SKIPPING == true)
+    MEEM_lane.io_request.fingerprint = MEEM_FINGERPRINT_SEED;
+#endif
+    MEEM_WriteNextChunk();
+#else
+#if (MEEM_USING_ZERO_COPY_WRITES == true)
+    if (MEEM_lane.io_request.data != MEEM_work_buffer)
+    {
+        MEEM_SnapshotCacheImage(); /* For each instance, as the cache may have changed since the previous one */
+    }
+#endif
     /* Try to push a request to the driver */
-    if (!EEAIF_BeginWrite(MEEM_global_status.io_request.offset_in_eeprom, MEEM_global_status.io_request.data, MEEM_global_status.io_request.size))
+    if (!MEEM_DeviceBeginWrite(MEEM_lane.io_request.offset_in_eeprom, MEEM_lane.io_request.data, MEEM_lane.io_request.size))
     {
         assert(false); /* Wrong time to put a request (development error)! */
     }
+#endif
 }
 
 /*!
@@ -216,15 +358,36 @@ MEEM_ioStage_t MEEM_WriteWaitToComplete(void)
 {
     MEEM_ioStage_t next_stage;
 
-    switch (EEAIF_GetStatus())
+    switch (MEEM_DeviceGetStatus())
     {
         case MEEM_OK:
+#if (MEEM_USING_STREAMED_WRITES == true)
+            if (MEEM_lane.io_request.transferred < MEEM_lane.io_request.size)
+            {
+                MEEM_WriteNextChunk();
+                next_stage = MEEM_IO_WAITING;
+                break;
+            }
+            next_stage = MEEM_IO_FINALIZE;
+#elif (MEEM_USING_ZERO_COPY_WRITES == true)
+            next_stage = MEEM_CheckWrittenImage();
+#else
             next_stage = MEEM_IO_FINALIZE;
+#endif
             break;
 
         case MEEM_NOK:
-            MEEM_block_status[MEEM_global_status.block_id].write_failed = true;
-            next_stage                                                  = MEEM_IO_FINALIZE;
+            MEEM_block_status[MEEM_lane.block_id].write_failed = true;
+            next_stage                                         = MEEM_IO_FINALIZE;
+#if (MEEM_USING_WRITE_BATCHING == true)
+            for (uint8_t i = MEEM_lane.block_id + 1u; i <= MEEM_lane.batch_last_block_id; i++)
+            {
+                MEEM_block_status[i].write_failed = true;
+            }
+#endif
+#if ((MEEM_USING_WRITE_SKIPPING == true) || (MEEM_USING_WRITE_TICKETS == true) || (MEEM_USING_FLASH_EMULATION_BLOCKS == true))
+            MEEM_lane.write_error = true;
+#endif
             break;
 
         default:
@@ -235,18 +398,26 @@ MEEM_ioStage_t MEEM_WriteWaitToComplete(void)
 }
 
 /*!
- * \brief  Execute post-write actions, specific to 'backup copy' and 'wear-leveling' blocks.
+ * \brief  Execute post-write actions, specific to 'backup copy', 'wear-leveling' and 'flash emulation' blocks.
  */
 MEEM_ioStage_t MEEM_WriteFinalize(void)
 {
-    const MEEM_blockConfig_t*  block_config = &MEEM_block_config[MEEM_global_status.block_id];
-    MEEM_blockStatusPrivate_t* block_status = &MEEM_block_status[MEEM_global_status.block_id];
+    const MEEM_blockConfig_t*  block_config = &MEEM_block_config[MEEM_lane.block_id];
+    MEEM_blockStatusPrivate_t* block_status = &MEEM_block_status[MEEM_lane.block_id];
     MEEM_ioStage_t             next_stage   = MEEM_IO_COMPLETE;
 
     /* Most expected result */
     block_status->write_complete = true;
 
-    switch (block_config->management_type)
+#if ((MEEM_USING_STREAMED_WRITES == true) && (MEEM_USING_WRITE_SKIPPING == true))
+    /* The fingerprint was remembered at the start of the write, but the cache is streamed later. Each instance must match it. */
+    if (MEEM_lane.io_request.fingerprint != MEEM_persisted_fingerprint[MEEM_lane.block_id])
+    {
+        MEEM_lane.write_torn = true;
+    }
+#endif
+
+    switch (MEEM_ManagementType(block_config))
     {
 #if (MEEM_USING_BACKUP_COPY_BLOCKS == true)
         case MEEM_MGMT_BACKUP_COPY:
@@ -256,7 +427,7 @@ MEEM_ioStage_t MEEM_WriteFinalize(void)
                 /* Initiate write of the backup copy */
                 block_status->write_complete = false;
 
-                MEEM_global_status.io_request.offset_in_eeprom += (block_config->data_size + sizeof(MEEM_checksum_t));
+                MEEM_lane.io_request.offset_in_eeprom += (block_config->data_size + sizeof(MEEM_checksum_t));
                 MEEM_WriteInitiate();
                 next_stage = MEEM_IO_WAITING;
             }
@@ -266,13 +437,39 @@ MEEM_ioStage_t MEEM_WriteFinalize(void)
         case MEEM_MGMT_WEAR_LEVELING:
             /* Update the sequence counter and the active instance index */
             block_config->cache[0]                 = MEEM_IncrementAndWrapAround(block_config->cache[0], 255);
-            block_status->index_of_active_instance = MEEM_IncrementAndWrapAround(block_status->index_of_active_instance, block_config->instance_count);
+            block_status->index_of_active_instance = MEEM_IncrementAndWrapAround(block_status->index_of_active_instance, MEEM_InstanceCount(block_config));
+            break;
+#endif
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+        case MEEM_MGMT_FLASH_EMULATION:
+            MEEM_FinalizeFlashSlotWrite();
             break;
 #endif
         default:
             break;
     }
 
+#if (MEEM_USING_WRITE_SKIPPING == true)
+    /* The fingerprint was remembered at the start of the write. It's reliable only if all instances were written successfully. */
+    if (MEEM_IO_COMPLETE == next_stage)
+    {
+#if ((MEEM_USING_STREAMED_WRITES == true) || (MEEM_USING_ZERO_COPY_WRITES == true))
+        block_status->persisted_data_known = !MEEM_lane.write_error && !MEEM_lane.write_torn;
+#else
+        block_status->persisted_data_known = !MEEM_lane.write_error;
+#endif
+    }
+#endif
+#if (MEEM_USING_WRITE_BATCHING == true)
+    /* The rest of a batch are 'basic' blocks, written along with the first one */
+    for (uint8_t i = MEEM_lane.block_id + 1u; i <= MEEM_lane.batch_last_block_id; i++)
+    {
+        MEEM_block_status[i].write_complete = true;
+#if (MEEM_USING_WRITE_SKIPPING == true)
+        MEEM_block_status[i].persisted_data_known = !MEEM_lane.write_error;
+#endif
+    }
+#endif
     return next_stage;
 }
 
@@ -282,48 +479,172 @@ MEEM_ioStage_t MEEM_WriteFinalize(void)
  */
 void MEEM_RecoverBlockData(uint8_t block_id)
 {
-    MEEM_dataRecoveryStrategy_t recovery_strategy = (MEEM_dataRecoveryStrategy_t) MEEM_block_config[block_id].data_recovery_strategy;
+    MEEM_dataRecoveryStrategy_t recovery_strategy = (MEEM_dataRecoveryStrategy_t) MEEM_DataRecoveryStrategy(&MEEM_block_config[block_id]);
     MEEM_blockStatusPrivate_t*  block_status      = &MEEM_block_status[block_id];
 
     block_status->recovered = true;
+    MEEM_ForgetPersistedData(block_id);
 
     if (MEEM_RECOVER_DEFAULTS_AND_REPAIR == recovery_strategy)
     {
-        block_status->write_pending = true;
+        MEEM_SetWritePending(block_id);
+    }
+#if (MEEM_USING_STREAMING_IO == true)
+    if (NULL != MEEM_lane.io_request.sink)
+    {
+        /* The invalid data is already streamed to the cache, within the update, opened for the fetch */
+        MEEM_LoadDefaults(block_id);
+        MEEM_CloseReadSink();
+        return;
     }
+#endif
     MEEM_RestoreDefaults(block_id);
 }
 
 void MEEM_RestoreDefaults(uint8_t block_id)
 {
     assert(block_id < MEEM_BLOCK_COUNT);
+    assert(NULL != MEEM_block_config[block_id].cache); /* Not applicable to 'read-through' and 'memory-mapped' blocks */
 
-    const MEEM_blockConfig_t* block_cfg              = &MEEM_block_config[block_id];
-    uint8_t                   default_pattern_length = block_cfg->default_pattern_length;
+    MEEM_BeginCacheUpdate(block_id);
+    MEEM_LoadDefaults(block_id);
+    MEEM_EndCacheUpdate(block_id);
+}
 
-    if (default_pattern_length == 0)
+#if (MEEM_USING_STREAMING_IO == true)
+/*!
+ * \brief   Ends the cache update, opened by MEEM_StartReadOperation() for a fetch, streamed to the block's cache.
+ *          It lasts until the fetched data is validated or replaced by the defaults, so a seqlock reader never takes a partially fetched
+ *          or an invalid image.
+ */
+void MEEM_CloseReadSink(void)
+{
+    if (NULL != MEEM_lane.io_request.sink)
     {
-        (void) memcpy(block_cfg->cache, block_cfg->defaults, block_cfg->data_size);
+        MEEM_EndCacheUpdate(MEEM_lane.block_id);
+        MEEM_lane.io_request.sink = NULL;
     }
-    else
+}
+#endif
+
+#if (MEEM_USING_RUN_LENGTH_DEFAULTS == true)
+/*!
+ * \brief      Decodes a range of the run-length encoded defaults of a block. Runs are filled by memset(), literals - by memcpy().
+ *             The segments before the range are only skipped, so a range may start anywhere.
+ * \param[in]  block_cfg - configuration of the block
+ * \param[in]  position - of the range in the encoded data, which doesn't include the sequence counter of a block
+ * \param[in]  size - of the range, in bytes
+ * \param[out] dest - where the range is decoded
+ */
+void MEEM_DecodeDefaults(const MEEM_blockConfig_t* block_cfg, uint16_t position, uint16_t size, uint8_t* dest)
+{
+    const uint8_t* segment       = block_cfg->defaults;
+    uint16_t       segment_start = 0;
+    const uint16_t range_end     = position + size;
+
+    while (segment_start < range_end)
     {
-        uint16_t offset    = (block_cfg->management_type == MEEM_MGMT_WEAR_LEVELING) ? 1u : 0u;
-        uint16_t data_size = (block_cfg->data_size - offset);
+        const bool     run         = (0u != (segment[0] & 0x80u));
+        const uint16_t length      = run ? (uint16_t) ((segment[0] & 0x7Fu) + MEEM_DEFAULTS_MIN_RUN) : (uint16_t) (segment[0] + 1u);
+        const uint16_t segment_end = segment_start + length;
 
-        if (default_pattern_length == 1)
+        if (segment_end > position)
         {
-            (void) memset(&block_cfg->cache[offset], block_cfg->defaults[0], data_size);
-        }
-        else
-        {
-            for (; offset < data_size; offset += (uint16_t) default_pattern_length)
+            const uint16_t from = (segment_start > position) ? segment_start : position;
+            const uint16_t to   = (segment_end < range_end) ? segment_end : range_end;
+
+            if (run)
             {
-                (void) memcpy(&block_cfg->cache[offset], block_cfg->defaults, (size_t) default_pattern_length);
+                (void) memset(&dest[from - position], segment[1], to - from);
+            }
+            else
+            {
+                (void) memcpy(&dest[from - position], &segment[1u + (from - segment_start)], to - from);
             }
         }
+        segment       = &segment[run ? 2u : (1u + length)];
+        segment_start = segment_end;
+    }
+}
+#endif
+
+#if (MEEM_USING_WRITE_SKIPPING == true)
+/*!
+ * \brief     Continues a 32-bit FNV-1a hash over the next part of the data.
+ * \param[in] fingerprint - hash of the preceding data, or MEEM_FINGERPRINT_SEED
+ * \param[in] data - next part of the data
+ * \param[in] data_size - in bytes
+ */
+static uint32_t MEEM_UpdateFingerprint(uint32_t fingerprint, const uint8_t* data, uint16_t data_size)
+{
+    for (uint16_t i = 0; i < data_size; i++)
+    {
+        fingerprint = (fingerprint ^ data[i]) * 16777619u;
     }
+    return fingerprint;
 }
 
+/*!
+ * \brief     Calculates a 32-bit FNV-1a hash of the block's data, excluding the sequence counter of 'wear-leveling' and 'flash emulation' blocks.
+ * \details   The configured checksum may be as short as 8 bits, which is too weak to tell changed data from unchanged.
+ * \param[in] block_id - ID of the block
+ * \param[in] data - block's data, without the checksum
+ */
+static uint32_t MEEM_CalculateFingerprint(uint8_t block_id, const uint8_t* data)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[block_id];
+
+    /* The sequence counter changes on each write, so it's not a part of the data, the user cares about */
+    const uint16_t offset = MEEM_HasSequenceCounter(block_cfg) ? 1u : 0u;
+
+    return MEEM_UpdateFingerprint(MEEM_FINGERPRINT_SEED, &data[offset], (uint16_t) (block_cfg->data_size - offset));
+}
+
+/*!
+ * \brief     Remembers the fingerprint of a block's data, which is known to be valid in the EEPROM.
+ * \param[in] block_id - ID of the block
+ * \param[in] data - block's data, without the checksum
+ */
+void MEEM_RememberPersistedData(uint8_t block_id, const uint8_t* data)
+{
+    MEEM_persisted_fingerprint[block_id]             = MEEM_CalculateFingerprint(block_id, data);
+    MEEM_block_status[block_id].persisted_data_known = true;
+}
+
+/*!
+ * \brief     Checks if the write image matches the data in the EEPROM.
+ * \details   The fingerprint of the write image is remembered, but it's considered known only after a successful write.
+ *            An image in the cache is taken without a critical section. An update, racing with it, is followed by its own write request.
+ * \param[in] block_id - ID of the block
+ * \retval    true - if the write can be skipped
+ * \retval    false - otherwise
+ */
+bool MEEM_IsWriteRedundant(uint8_t block_id)
+{
+#if (MEEM_USING_STREAMED_WRITES == true)
+    /* The write image isn't assembled in the work buffer. The cache is taken through it, a chunk at a time, like it's written. */
+    const MEEM_blockConfig_t* block_cfg   = &MEEM_block_config[block_id];
+    uint32_t                  fingerprint = MEEM_FINGERPRINT_SEED;
+
+    for (uint16_t position = 0; position < block_cfg->data_size; position += MEEM_WORKBUFFER_SIZE)
+    {
+        const uint16_t size = ((block_cfg->data_size - position) < MEEM_WORKBUFFER_SIZE) ? (uint16_t) (block_cfg->data_size - position)
+                                                                                         : (uint16_t) MEEM_WORKBUFFER_SIZE;
+
+        MEEM_CopyCacheChunk(block_cfg, position, size);
+        fingerprint = MEEM_FingerprintCacheChunk(fingerprint, block_cfg, position, size);
+    }
+#else
+    const uint32_t fingerprint = MEEM_CalculateFingerprint(block_id, &MEEM_lane.io_request.data[sizeof(MEEM_checksum_t)]);
+#endif
+    const bool     redundant   = MEEM_block_status[block_id].persisted_data_known && (fingerprint == MEEM_persisted_fingerprint[block_id]);
+
+    MEEM_persisted_fingerprint[block_id]             = fingerprint;
+    MEEM_block_status[block_id].persisted_data_known = redundant;
+    return redundant;
+}
+#endif
+
 /*!
  * \brief     Checks the integrity of a block's data (fetched in the work buffer), by performing checksum verification.
  * \param[in] block_id - ID of the block
@@ -332,8 +653,13 @@ void MEEM_RestoreDefaults(uint8_t block_id)
  */
 bool MEEM_IsDataValid(uint8_t block_id)
 {
+#if (MEEM_USING_STREAMING_IO == true)
+    (void) block_id;
+    return *((const MEEM_checksum_t*) &MEEM_work_buffer[0]) == MEEM_lane.io_request.checksum; /* Accumulated, while the image was streamed */
+#else
     return *((const MEEM_checksum_t*) &MEEM_work_buffer[0]) ==
            MEEM_CalculateChecksum(&MEEM_work_buffer[sizeof(MEEM_checksum_t)], MEEM_block_config[block_id].data_size);
+#endif
 }
 
 /*!
@@ -352,3 +678,244 @@ uint8_t MEEM_IncrementAndWrapAround(uint8_t number, uint8_t exclusive_upper_limi
 
     return number;
 }
+
+/******************************************************************************/
+/*    Private operations                                                      */
+/******************************************************************************/
+/*!
+ * \brief     Loads the defaults of a block to its cache.
+ * \pre       The caller encloses it in a cache update.
+ * \param[in] block_id - ID of the block
+ */
+static void MEEM_LoadDefaults(uint8_t block_id)
+{
+    const MEEM_blockConfig_t* block_cfg              = &MEEM_block_config[block_id];
+    uint8_t                   default_pattern_length = MEEM_DefaultPatternLength(block_cfg);
+
+#if (MEEM_USING_RUN_LENGTH_DEFAULTS == true)
+    if (block_cfg->run_length_defaults)
+    {
+        uint16_t offset = MEEM_HasSequenceCounter(block_cfg) ? 1u : 0u;
+
+        MEEM_DecodeDefaults(block_cfg, 0, block_cfg->data_size - offset, &block_cfg->cache[offset]);
+    }
+    else
+#endif
+    if (default_pattern_length == 0)
+    {
+        (void) memcpy(block_cfg->cache, block_cfg->defaults, block_cfg->data_size);
+    }
+    else
+    {
+        uint16_t offset    = MEEM_HasSequenceCounter(block_cfg) ? 1u : 0u;
+        uint16_t data_size = (block_cfg->data_size - offset);
+
+        if (default_pattern_length == 1)
+        {
+            (void) memset(&block_cfg->cache[offset], block_cfg->defaults[0], data_size);
+        }
+        else
+        {
+            for (; offset < data_size; offset += (uint16_t) default_pattern_length)
+            {
+                (void) memcpy(&block_cfg->cache[offset], block_cfg->defaults, (size_t) default_pattern_length);
+            }
+        }
+    }
+#if (MEEM_USING_ALIGNED_CACHES == true)
+    MEEM_UnpackCache(block_id, block_cfg->cache); /* The defaults have the layout of the image, so they are unpacked in place */
+#endif
+}
+
+/*!
+ * \brief   Pushes the prepared read request to the driver. With streaming I/O, images in the work buffer are read chunk by chunk.
+ * \retval  true if the request is accepted
+ * \retval  false otherwise
+ */
+static bool MEEM_BeginRead(void)
+{
+#if (MEEM_USING_STREAMING_IO == true)
+    /* The other reads go directly to their destination, e.g. the cache of 'wear-leveling' blocks */
+    if (MEEM_lane.io_request.data == MEEM_work_buffer)
+    {
+        MEEM_eepromSize_t size;
+        uint8_t*          dest = MEEM_GetReadChunk(&size);
+
+        return MEEM_DeviceBeginRead(MEEM_lane.io_request.offset_in_eeprom + MEEM_lane.io_request.transferred, dest, size);
+    }
+#endif
+    return MEEM_DeviceBeginRead(MEEM_lane.io_request.offset_in_eeprom, MEEM_lane.io_request.data, MEEM_lane.io_request.size);
+}
+
+#if (MEEM_USING_STREAMING_IO == true)
+/*!
+ * \brief      Locates the next chunk of a streamed image. The first one is read at the start of the work buffer, like a whole image,
+ *             so the checksum and the sequence counter are always in place. The rest are read after them, overwriting each other.
+ * \param[out] size - byte count of the chunk
+ * \return     Destination of the chunk
+ */
+static uint8_t* MEEM_GetReadChunk(MEEM_eepromSize_t* size)
+{
+    const MEEM_eepromSize_t head      = (MEEM_lane.io_request.transferred == 0u) ? 0u : (sizeof(MEEM_checksum_t) + 1u);
+    const MEEM_eepromSize_t remaining = MEEM_lane.io_request.size - MEEM_lane.io_request.transferred;
+
+    *size = ((MEEM_WORKBUFFER_SIZE - head) < remaining) ? (MEEM_WORKBUFFER_SIZE - head) : remaining;
+    return &MEEM_work_buffer[head];
+}
+
+/*!
+ * \brief   Accumulates the checksum of a chunk, just read, and copies its data to the sink, if any.
+ *          The sink is a block's cache, whose update lasts for the whole fetch, so its readers don't see the chunks before validation.
+ * \retval  true if the whole image is read
+ * \retval  false if there are more chunks to read
+ */
+static bool MEEM_ConsumeReadChunk(void)
+{
+    MEEM_eepromSize_t size;
+    const uint8_t*    chunk;
+    MEEM_eepromSize_t position = MEEM_lane.io_request.transferred; /* Of the chunk's data in the block's data */
+
+    if (MEEM_lane.io_request.data != MEEM_work_buffer)
+    {
+        return true; /* Not streamed */
+    }
+
+    chunk = MEEM_GetReadChunk(&size);
+    MEEM_lane.io_request.transferred += size;
+    if (position == 0u)
+    {
+        chunk += sizeof(MEEM_checksum_t);
+        size  -= sizeof(MEEM_checksum_t);
+    }
+    else
+    {
+        position -= sizeof(MEEM_checksum_t);
+    }
+
+    MEEM_lane.io_request.checksum = MEEM_UpdateChecksum(MEEM_lane.io_request.checksum, chunk, (uint16_t) size);
+    if (MEEM_lane.io_request.sink != NULL)
+    {
+        (void) memcpy(&MEEM_lane.io_request.sink[position], chunk, size); /* Within the update, opened for the whole fetch */
+    }
+    return (MEEM_lane.io_request.transferred >= MEEM_lane.io_request.size);
+}
+#endif
+
+#if (MEEM_USING_STREAMED_WRITES == true)
+/*!
+ * \brief   Pushes a write of the next chunk of the image to the driver. The data is copied from the block's cache, in chunks, aligned to
+ *          the work buffer's size in the EEPROM. The checksum of all of it is written last, so an interrupted write leaves an invalid instance.
+ */
+static void MEEM_WriteNextChunk(void)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[MEEM_lane.block_id];
+    const MEEM_eepromSize_t   position  = MEEM_lane.io_request.transferred; /* In the block's data */
+    MEEM_eepromOffset_t       offset    = MEEM_lane.io_request.offset_in_eeprom;
+    MEEM_eepromSize_t         size      = sizeof(MEEM_checksum_t);
+
+    if (position < block_cfg->data_size)
+    {
+        offset += sizeof(MEEM_checksum_t) + position;
+        size    = MEEM_WORKBUFFER_SIZE - (offset % MEEM_WORKBUFFER_SIZE); /* Up to the next chunk boundary */
+        if (size > (block_cfg->data_size - position))
+        {
+            size = block_cfg->data_size - position;
+        }
+
+        MEEM_CopyCacheChunk(block_cfg, (uint16_t) position, (uint16_t) size);
+        MEEM_lane.io_request.checksum = MEEM_UpdateChecksum(MEEM_lane.io_request.checksum, MEEM_work_buffer, (uint16_t) size);
+#if (MEEM_USING_WRITE_SKIPPING == true)
+        MEEM_lane.io_request.fingerprint = MEEM_FingerprintCacheChunk(MEEM_lane.io_request.fingerprint, block_cfg, (uint16_t) position, (uint16_t) size);
+#endif
+    }
+    else
+    {
+        (void) memcpy(MEEM_work_buffer, &MEEM_lane.io_request.checksum, sizeof(MEEM_checksum_t));
+    }
+
+    MEEM_lane.io_request.transferred += size;
+    if (!MEEM_DeviceBeginWrite(offset, MEEM_work_buffer, size))
+    {
+        assert(false); /* Wrong time to put a request (development error)! */
+    }
+}
+
+/*!
+ * \brief     Copies a chunk of the block's cache to the start of the work buffer, within the critical section.
+ * \param[in] block_cfg - configuration of the block
+ * \param[in] position - of the chunk in the block's data
+ * \param[in] size - of the chunk, at most the work buffer's size
+ */
+static void MEEM_CopyCacheChunk(const MEEM_blockConfig_t* block_cfg, uint16_t position, uint16_t size)
+{
+    MEEM_EnterCriticalSection();
+    (void) memcpy(MEEM_work_buffer, &block_cfg->cache[position], size);
+    MEEM_ExitCriticalSection();
+}
+
+#if (MEEM_USING_WRITE_SKIPPING == true)
+/*!
+ * \brief     Continues the fingerprint of a block's data over a chunk, copied to the start of the work buffer.
+ * \param[in] fingerprint - of the preceding chunks, or MEEM_FINGERPRINT_SEED
+ * \param[in] block_cfg - configuration of the block
+ * \param[in] position - of the chunk in the block's data. The sequence counter of the first one is skipped, like MEEM_CalculateFingerprint() does.
+ * \param[in] size - of the chunk
+ */
+static uint32_t MEEM_FingerprintCacheChunk(uint32_t fingerprint, const MEEM_blockConfig_t* block_cfg, uint16_t position, uint16_t size)
+{
+    const uint16_t skipped = ((position == 0u) && MEEM_HasSequenceCounter(block_cfg)) ? 1u : 0u;
+
+    return MEEM_UpdateFingerprint(fingerprint, &MEEM_work_buffer[skipped], (uint16_t) (size - skipped));
+}
+#endif
+#endif
+
+#if (MEEM_USING_ZERO_COPY_WRITES == true)
+/*!
+ * \brief   Calculates the checksum of the image in the block's cache, just before an instance of it is written.
+ *          The sequence counter of the cache is remembered, to tell if the cache is updated, while the driver writes it.
+ */
+static void MEEM_SnapshotCacheImage(void)
+{
+    MEEM_lane.write_sequence = MEEM_block_sequence[MEEM_lane.block_id];
+    MEEM_MemoryBarrier();
+    MEEM_CalculateAndSetChecksum();
+#if (MEEM_USING_WRITE_SKIPPING == true)
+    /* The fingerprint was remembered at the start of the write. Each instance must match it. */
+    if (MEEM_CalculateFingerprint(MEEM_lane.block_id, &MEEM_lane.io_request.data[sizeof(MEEM_checksum_t)]) != MEEM_persisted_fingerprint[MEEM_lane.block_id])
+    {
+        MEEM_lane.write_torn = true;
+    }
+#endif
+}
+
+/*!
+ * \brief   Checks if the cache was updated, while its image was written. The instance may hold a mix of old and new data then,
+ *          so it's written again, with a new checksum. A cache, updated more often than it can be written, fails the write.
+ * \retval  MEEM_IO_WAITING - if the instance is written again
+ * \retval  MEEM_IO_FINALIZE - otherwise
+ */
+static MEEM_ioStage_t MEEM_CheckWrittenImage(void)
+{
+    const uint8_t sequence = MEEM_lane.write_sequence;
+
+    MEEM_MemoryBarrier();
+    if ((MEEM_lane.io_request.data == MEEM_work_buffer) || (((sequence & 1u) == 0u) && (sequence == MEEM_block_sequence[MEEM_lane.block_id])))
+    {
+        return MEEM_IO_FINALIZE;
+    }
+
+    MEEM_lane.write_attempts++;
+    if (MEEM_lane.write_attempts < MEEM_ZERO_COPY_MAX_ATTEMPTS)
+    {
+        MEEM_WriteInitiate();
+        return MEEM_IO_WAITING;
+    }
+
+    MEEM_block_status[MEEM_lane.block_id].write_failed = true;
+#if ((MEEM_USING_WRITE_SKIPPING == true) || (MEEM_USING_WRITE_TICKETS == true) || (MEEM_USING_FLASH_EMULATION_BLOCKS == true))
+    MEEM_lane.write_error = true;
+#endif
+    return MEEM_IO_FINALIZE;
+}
+#endif
@@ -0,0 +1,393 @@
+/*!
+ * \file    MEEM_BlockManagement_FlashEmulation.c
+ * \brief   Management routines, specific to 'flash emulation' blocks.
+ *          Flash emulation blocks occupy whole FLASH sectors. Each sector holds several checksum-protected instances (slots),
+ *          which are programmed one after another into erased space. Like with 'wear-leveling' blocks, a sequence counter tells the most recent one.
+ *          A sector is erased in idle time, ahead of need, so a write normally costs only the program time. If the sector isn't erased
+ *          yet when its first slot is written, it's erased before the write, as a fallback.
+ *          The sector with the most recent valid instance is never erased.
+ * \author  Kaloyan Dimitrov
+ * \copyright Copyright (c) 2025 Kaloyan Dimitrov
+ *            https://github.com/kaladim
+ *            SPDX-License-Identifier: MIT
+ */
+/******************************************************************************/
+/*    Dependencies                                                            */
+/******************************************************************************/
+#include <assert.h>
+#include <string.h>
+#include "MEEM_EEAIF.h"
+#include "MEEM_GenConfig.h"
+#include "MEEM_Internal.h"
+#include "MEEM.h"
+
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+/******************************************************************************/
+/*    Macros                                                                  */
+/******************************************************************************/
+#define INVALID_INSTANCE 0xFFu
+#define INVALID_INDEX    INVALID_INSTANCE
+#define NO_SECTOR        0xFFu
+#define ERASED_BYTE      0xFFu
+
+#define MEEM_GetSectorCount(block_cfg) ((uint8_t) (MEEM_InstanceCount(block_cfg) / (block_cfg)->slots_per_sector))
+#define MEEM_GetSectorOffset(block_cfg, sector) \
+    ((block_cfg)->offset_in_eeprom + ((MEEM_eepromOffset_t) (sector) * MEEM_FLASH_SECTOR_SIZE))
+
+#if (MEEM_USING_SPECIALIZED_CORE == true)
+#define MEEM_FlashEmulationBlock(n)       (MEEM_flash_emulation_blocks[(n)])
+#else
+/* Each block is visited by the idle time erase, which skips the other types */
+#define MEEM_FLASH_EMULATION_BLOCK_COUNT  MEEM_BLOCK_COUNT
+#define MEEM_FlashEmulationBlock(n)       (n)
+#endif
+
+/******************************************************************************/
+/*    Private variables                                                       */
+/******************************************************************************/
+/* Sector of each block, which is erased and not programmed since. NO_SECTOR - none is known. */
+static uint8_t MEEM_erased_sector[MEEM_BLOCK_COUNT];
+
+/* Sector of each block, which holds its most recent valid instance, so it must not be erased. NO_SECTOR - none. */
+static uint8_t MEEM_newest_sector[MEEM_BLOCK_COUNT];
+
+/* Blocks, whose idle time erase failed. Not retried until their next write, which erases before it, if needed. */
+static bool MEEM_idle_erase_failed[MEEM_BLOCK_COUNT];
+
+#if (MEEM_USING_SPECIALIZED_CORE == true)
+static const uint8_t MEEM_flash_emulation_blocks[MEEM_FLASH_EMULATION_BLOCK_COUNT] = MEEM_FLASH_EMULATION_BLOCK_IDS;
+#endif
+
+/******************************************************************************/
+/*    Private operations prototypes                                           */
+/******************************************************************************/
+static MEEM_status_t MEEM_ReadFlashArea(uint8_t block_id, MEEM_eepromOffset_t offset_in_eeprom, uint8_t* dest, MEEM_eepromSize_t size);
+static bool          MEEM_IsImageBlank(uint8_t block_id);
+static uint8_t       MEEM_GetSectorToErase(uint8_t block_id);
+
+/******************************************************************************/
+/*    Internal operations                                                     */
+/******************************************************************************/
+/*!
+ * \brief     Initializes a 'flash emulation' block: finds its most recent instance and the slot to program next.
+ * \note      This is a synchronous (blocking) operation!
+ * \param[in] block_id - ID of the block to initialize
+ */
+void MEEM_InitializeFlashEmulationBlock(uint8_t block_id)
+{
+    const MEEM_blockConfig_t*  block_cfg    = &MEEM_block_config[block_id];
+    MEEM_blockStatusPrivate_t* block_status = &MEEM_block_status[block_id];
+    const uint8_t              sps          = block_cfg->slots_per_sector;
+    const MEEM_eepromSize_t    image_size   = sizeof(MEEM_checksum_t) + block_cfg->data_size;
+    uint8_t                    sequence_counters[MEEM_MAX_WL_INSTANCE_COUNT];
+    uint8_t                    blank_slots[(MEEM_MAX_WL_INSTANCE_COUNT + 7u) / 8u];
+    uint8_t                    newest;
+    uint8_t                    next = 0;
+#if (MEEM_USING_ALIGNED_CACHES == true)
+    uint8_t* const             data = MEEM_work_buffer; /* An aligned cache is unpacked from the work buffer */
+#else
+    uint8_t* const             data = block_cfg->cache;
+#endif
+
+    MEEM_newest_sector[block_id]     = NO_SECTOR;
+    MEEM_erased_sector[block_id]     = NO_SECTOR;
+    MEEM_idle_erase_failed[block_id] = false;
+    (void) memset(blank_slots, 0, sizeof(blank_slots));
+
+    /* Scan all slots. Valid ones give their sequence counter, blank ones can be programmed without an erase. */
+    for (uint8_t slot = 0; slot < MEEM_InstanceCount(block_cfg); slot++)
+    {
+        sequence_counters[slot] = INVALID_INSTANCE;
+
+        if (MEEM_OK == MEEM_ReadFlashArea(block_id, block_cfg->offset_in_eeprom + MEEM_GetFlashSlotOffset(block_id, slot), MEEM_work_buffer, image_size))
+        {
+            if (MEEM_IsDataValid(block_id))
+            {
+                sequence_counters[slot] = MEEM_work_buffer[sizeof(MEEM_checksum_t)];
+            }
+            else if (MEEM_IsImageBlank(block_id))
+            {
+                blank_slots[slot / 8u] |= (uint8_t) (1u << (slot % 8u));
+            }
+        }
+    }
+
+    newest = MEEM_FindIndexOfMostRecentInstance(sequence_counters, MEEM_InstanceCount(block_cfg));
+
+    /* Read the most recent instance directly to the block cache, skipping the checksum */
+    if ((INVALID_INDEX != newest) && (MEEM_OK == MEEM_ReadFlashArea(block_id,
+                                                                    block_cfg->offset_in_eeprom + MEEM_GetFlashSlotOffset(block_id, newest) + sizeof(MEEM_checksum_t),
+                                                                    data, block_cfg->data_size)))
+    {
+        data[0]                      = MEEM_IncrementAndWrapAround(sequence_counters[newest], 255);
+        MEEM_newest_sector[block_id] = newest / sps;
+        MEEM_RememberPersistedData(block_id, data);
+#if (MEEM_USING_ALIGNED_CACHES == true)
+        MEEM_UnpackCache(block_id, data);
+#endif
+
+        next = MEEM_IncrementAndWrapAround(newest, MEEM_InstanceCount(block_cfg));
+    }
+    else
+    {
+        block_cfg->cache[0] = 0;
+        MEEM_RecoverBlockData(block_id);
+    }
+
+    /* A slot in the middle of a sector can be programmed only if it's blank. After a torn write, continue in the next sector. */
+    if (((next % sps) != 0u) && (0u == (blank_slots[next / 8u] & (1u << (next % 8u)))))
+    {
+        next = (uint8_t) (MEEM_IncrementAndWrapAround(next / sps, MEEM_GetSectorCount(block_cfg)) * sps);
+    }
+    block_status->index_of_active_instance = next;
+
+    /* The sector, needed next, may be erased already - e.g. in idle time before a reset */
+    const uint8_t sector = MEEM_GetSectorToErase(block_id);
+    if (NO_SECTOR != sector)
+    {
+        bool is_blank = true;
+
+        for (uint8_t slot = sector * sps; slot < ((sector + 1u) * sps); slot++)
+        {
+            is_blank = is_blank && (0u != (blank_slots[slot / 8u] & (1u << (slot % 8u))));
+        }
+        if (is_blank)
+        {
+            MEEM_erased_sector[block_id] = sector;
+        }
+    }
+}
+
+/*!
+ * \param[in] block_id - ID of a 'flash emulation' block
+ * \param[in] slot - index of the slot, in [0..instance_count)
+ * \return    Offset of the slot, relative to the start of the block's area
+ */
+MEEM_eepromOffset_t MEEM_GetFlashSlotOffset(uint8_t block_id, uint8_t slot)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[block_id];
+
+    return ((MEEM_eepromOffset_t) (slot / block_cfg->slots_per_sector) * MEEM_FLASH_SECTOR_SIZE) +
+           ((MEEM_eepromOffset_t) (slot % block_cfg->slots_per_sector) * (sizeof(MEEM_checksum_t) + block_cfg->data_size));
+}
+
+/*!
+ * \param[in] block_id - ID of the block
+ * \retval    true - if the next write of a 'flash emulation' block starts a sector, which isn't erased yet
+ * \retval    false - otherwise, also for the other block types
+ */
+bool MEEM_IsEraseBeforeWriteNeeded(uint8_t block_id)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[block_id];
+    const uint8_t             slot      = MEEM_block_status[block_id].index_of_active_instance;
+
+    return (MEEM_MGMT_FLASH_EMULATION == MEEM_ManagementType(block_cfg)) && ((slot % block_cfg->slots_per_sector) == 0u) &&
+           (MEEM_erased_sector[block_id] != (slot / block_cfg->slots_per_sector));
+}
+
+/*!
+ * \brief   Starts the erase of the sector, which the write on the active lane is about to program, if it's not erased yet.
+ * \retval  true - if the erase is started, the write must wait for it
+ * \retval  false - if the write can be started at once
+ */
+bool MEEM_BeginEraseBeforeWrite(void)
+{
+    const uint8_t             block_id  = MEEM_lane.block_id;
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[block_id];
+
+    if (!MEEM_IsEraseBeforeWriteNeeded(block_id))
+    {
+        return false;
+    }
+
+    if (!EEAIF_BeginErase(MEEM_GetSectorOffset(block_cfg, MEEM_block_status[block_id].index_of_active_instance / block_cfg->slots_per_sector), MEEM_FLASH_SECTOR_SIZE))
+    {
+        assert(false); /* Wrong time to put a request (development error)! */
+    }
+    return true;
+}
+
+/*!
+ * \brief   Waits for the erase, started by MEEM_BeginEraseBeforeWrite(), and starts the write after it.
+ * \return  Next stage of the write. If the erase fails, the write completes as failed, and the same slot is tried by the next one.
+ */
+MEEM_ioStage_t MEEM_WaitForEraseBeforeWrite(void)
+{
+    const uint8_t              block_id     = MEEM_lane.block_id;
+    const MEEM_blockConfig_t*  block_cfg    = &MEEM_block_config[block_id];
+    MEEM_blockStatusPrivate_t* block_status = &MEEM_block_status[block_id];
+    MEEM_ioStage_t             next_stage;
+
+    switch (MEEM_DeviceGetStatus())
+    {
+        case EEAIF_OK:
+            MEEM_erased_sector[block_id] = block_status->index_of_active_instance / block_cfg->slots_per_sector;
+            MEEM_WriteInitiate();
+            next_stage = MEEM_IO_WAITING;
+            break;
+
+        case EEAIF_NOK:
+            block_status->write_failed   = true;
+            block_status->write_complete = true;
+            MEEM_lane.write_error        = true;
+            next_stage                   = MEEM_IO_COMPLETE;
+            break;
+
+        default:
+            next_stage = MEEM_IO_ERASING;
+            break;
+    }
+    return next_stage;
+}
+
+/*!
+ * \brief  Post-write actions of a 'flash emulation' block: the programmed slot is used, whether the write succeeded or not.
+ */
+void MEEM_FinalizeFlashSlotWrite(void)
+{
+    const uint8_t              block_id     = MEEM_lane.block_id;
+    const MEEM_blockConfig_t*  block_cfg    = &MEEM_block_config[block_id];
+    MEEM_blockStatusPrivate_t* block_status = &MEEM_block_status[block_id];
+    const uint8_t              sector       = block_status->index_of_active_instance / block_cfg->slots_per_sector;
+
+    if (!MEEM_lane.write_error)
+    {
+        MEEM_newest_sector[block_id] = sector;
+    }
+    if (MEEM_erased_sector[block_id] == sector)
+    {
+        MEEM_erased_sector[block_id] = NO_SECTOR; /* Programmed now. Its next slots are still blank. */
+    }
+    MEEM_idle_erase_failed[block_id] = false;
+
+    /* Update the sequence counter and the active instance index */
+    block_cfg->cache[0]                    = MEEM_IncrementAndWrapAround(block_cfg->cache[0], 255);
+    block_status->index_of_active_instance = MEEM_IncrementAndWrapAround(block_status->index_of_active_instance, MEEM_InstanceCount(block_cfg));
+
+    /* After failed writes all around, don't erase the sector with the most recent valid instance - skip it */
+    if (((block_status->index_of_active_instance % block_cfg->slots_per_sector) == 0u) &&
+        ((block_status->index_of_active_instance / block_cfg->slots_per_sector) == MEEM_newest_sector[block_id]))
+    {
+        block_status->index_of_active_instance = (uint8_t) (MEEM_IncrementAndWrapAround(MEEM_newest_sector[block_id], MEEM_GetSectorCount(block_cfg)) * block_cfg->slots_per_sector);
+    }
+}
+
+/*!
+ * \brief   Starts the erase of a sector, which a 'flash emulation' block will need for its next writes. Called in idle time, on the primary lane.
+ * \retval  true - if an erase is started
+ * \retval  false - if no sector needs an erase
+ */
+bool MEEM_TryStartSectorErase(void)
+{
+    for (uint8_t n = 0; n < MEEM_FLASH_EMULATION_BLOCK_COUNT; n++)
+    {
+        const uint8_t i      = MEEM_FlashEmulationBlock(n);
+        const bool    is_due = (MEEM_MGMT_FLASH_EMULATION == MEEM_ManagementType(&MEEM_block_config[i])) && !MEEM_idle_erase_failed[i];
+        const uint8_t sector = is_due ? MEEM_GetSectorToErase(i) : NO_SECTOR;
+
+        if (NO_SECTOR != sector)
+        {
+            MEEM_lane.block_id                    = i;
+            MEEM_lane.io_request.offset_in_eeprom = MEEM_GetSectorOffset(&MEEM_block_config[i], sector);
+
+            if (!EEAIF_BeginErase(MEEM_lane.io_request.offset_in_eeprom, MEEM_FLASH_SECTOR_SIZE))
+            {
+                assert(false); /* Wrong time to put a request (development error)! */
+                return false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * \brief   Waits for the erase, started by MEEM_TryStartSectorErase(). A failed erase is retried before the next write of the block.
+ * \retval  true - if the erase is complete
+ * \retval  false - if it's in progress
+ */
+bool MEEM_SectorEraseTask(void)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[MEEM_lane.block_id];
+
+    switch (MEEM_DeviceGetStatus())
+    {
+        case EEAIF_OK:
+            MEEM_erased_sector[MEEM_lane.block_id] = (uint8_t) ((MEEM_lane.io_request.offset_in_eeprom - block_cfg->offset_in_eeprom) / MEEM_FLASH_SECTOR_SIZE);
+            return true;
+
+        case EEAIF_NOK:
+            MEEM_idle_erase_failed[MEEM_lane.block_id] = true;
+            return true;
+
+        default:
+            return false; /* Still busy */
+    }
+}
+
+/******************************************************************************/
+/*    Private operations                                                      */
+/******************************************************************************/
+/*!
+ * \brief     Reads an area of a block synchronously.
+ * \param[in] block_id - ID of the block
+ * \param[in] offset_in_eeprom - start of the area
+ * \param[out] dest - destination buffer
+ * \param[in] size - size of the area, in bytes
+ */
+static MEEM_status_t MEEM_ReadFlashArea(uint8_t block_id, MEEM_eepromOffset_t offset_in_eeprom, uint8_t* dest, MEEM_eepromSize_t size)
+{
+    MEEM_status_t read_status;
+
+    MEEM_StartReadOperation(block_id);
+    MEEM_lane.io_request.offset_in_eeprom = offset_in_eeprom;
+    MEEM_lane.io_request.data             = dest;
+    MEEM_lane.io_request.size             = size;
+
+    do
+    {
+        read_status = MEEM_ReadOperationTask();
+    } while (MEEM_BUSY == read_status);
+
+    return read_status;
+}
+
+/*!
+ * \retval true if the whole image in the work buffer is in erased state
+ * \retval false otherwise
+ */
+static bool MEEM_IsImageBlank(uint8_t block_id)
+{
+    for (uint16_t i = 0; i < (sizeof(MEEM_checksum_t) + MEEM_block_config[block_id].data_size); i++)
+    {
+        if (ERASED_BYTE != MEEM_work_buffer[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ * \brief     Finds the sector, which the next writes of a block need erased. In the middle of a sector, that's the next one.
+ * \param[in] block_id - ID of a 'flash emulation' block
+ * \return    Index of the sector, or NO_SECTOR if it's erased already or holds the most recent instance
+ */
+static uint8_t MEEM_GetSectorToErase(uint8_t block_id)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[block_id];
+    const uint8_t             slot      = MEEM_block_status[block_id].index_of_active_instance;
+    uint8_t                   sector    = slot / block_cfg->slots_per_sector;
+
+    if ((slot % block_cfg->slots_per_sector) != 0u)
+    {
+        sector = MEEM_IncrementAndWrapAround(sector, MEEM_GetSectorCount(block_cfg)); /* The rest of the current sector is blank */
+    }
+
+    if ((sector == MEEM_erased_sector[block_id]) || (sector == MEEM_newest_sector[block_id]))
+    {
+        return NO_SECTOR;
+    }
+    return sector;
+}
+#endif
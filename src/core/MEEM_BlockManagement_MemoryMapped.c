@@ -0,0 +1,55 @@
+/*!
+ * \file    MEEM_BlockManagement_MemoryMapped.c
+ * \brief   Management routines, specific to 'memory-mapped' blocks.
+ *          Memory-mapped blocks have no cache in RAM. They have 1 checksum-protected instance in a device, which the CPU reads directly,
+ *          like a memory-mapped data FLASH. Their image is validated once, at init, and the generated getters read the data from
+ *          the mapped address afterwards, or from the defaults, if the image is invalid. They are read-only - e.g. calibration tables,
+ *          programmed at production.
+ * \author  Kaloyan Dimitrov
+ * \copyright Copyright (c) 2025 Kaloyan Dimitrov
+ *            https://github.com/kaladim
+ *            SPDX-License-Identifier: MIT
+ */
+/******************************************************************************/
+/*    Dependencies                                                            */
+/******************************************************************************/
+#include <string.h>
+#include "MEEM_EEAIF.h"
+#include "MEEM_GenConfig.h"
+#include "MEEM_Internal.h"
+#include "MEEM.h"
+
+#if (MEEM_USING_MEMORY_MAPPED_BLOCKS == true)
+/******************************************************************************/
+/*    Internal operations                                                     */
+/******************************************************************************/
+/*!
+ * \brief     Validates the mapped image of a block and points the block's getters to its data, or to the defaults.
+ * \note      This is a synchronous (blocking) operation, without a request to the driver!
+ * \param[in] block_id - ID of the block to initialize
+ */
+void MEEM_InitializeMemoryMappedBlock(uint8_t block_id)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[block_id];
+    const uint8_t*            image     = EEAIF_GetMappedAddress(block_cfg->offset_in_eeprom);
+    MEEM_checksum_t           stored_checksum;
+    bool                      valid = false;
+
+    if (NULL != image)
+    {
+        (void) memcpy(&stored_checksum, image, sizeof(MEEM_checksum_t)); /* The image is not necessarily aligned */
+        valid = (stored_checksum == MEEM_CalculateChecksum(&image[sizeof(MEEM_checksum_t)], block_cfg->data_size));
+    }
+
+    if (valid)
+    {
+        MEEM_mapped_data[block_id] = &image[sizeof(MEEM_checksum_t)];
+    }
+    else
+    {
+        /* The block is read-only, so it's never repaired. Its defaults are never compressed, so they have the layout of its data. */
+        MEEM_mapped_data[block_id]            = block_cfg->defaults;
+        MEEM_block_status[block_id].recovered = true;
+    }
+}
+#endif
@@ -30,18 +30,18 @@
  */
 bool MEEM_InitMultiProfileBlockTask(void)
 {
-    switch (MEEM_global_status.init_stage)
+    switch (MEEM_lane.init_stage)
     {
         case MEEM_INIT_FETCH_INSTANCE:
             switch (MEEM_ReadOperationTask())
             {
                 case MEEM_OK:
-                    MEEM_global_status.init_stage = MEEM_INIT_EVALUATE_INSTANCE;
+                    MEEM_lane.init_stage = MEEM_INIT_EVALUATE_INSTANCE;
                     break;
 
                 case MEEM_NOK:
                     /* Can't read the EEPROM, continue with default values */
-                    MEEM_global_status.init_stage = MEEM_INIT_RECOVER_DATA;
+                    MEEM_lane.init_stage = MEEM_INIT_RECOVER_DATA;
                     break;
 
                 default:
@@ -50,42 +50,48 @@ bool MEEM_InitMultiProfileBlockTask(void)
             break;
 
         case MEEM_INIT_EVALUATE_INSTANCE:
-            if (MEEM_IsDataValid(MEEM_global_status.block_id))
+            if (MEEM_IsDataValid(MEEM_lane.block_id))
             {
-                MEEM_global_status.init_stage = MEEM_INIT_CACHE;
+                MEEM_lane.init_stage = MEEM_INIT_CACHE;
             }
             else
             {
-                MEEM_global_status.init_stage = MEEM_INIT_RECOVER_DATA;
+                MEEM_lane.init_stage = MEEM_INIT_RECOVER_DATA;
             }
             break;
 
         case MEEM_INIT_CACHE:
         {
-            const MEEM_blockConfig_t* block_config = &MEEM_block_config[MEEM_global_status.block_id];
-
+#if (MEEM_USING_STREAMING_IO != true)
             /* Just copy the content of the work buffer to data cache */
-            (void) memcpy(block_config->cache, &MEEM_work_buffer[sizeof(MEEM_checksum_t)], block_config->data_size);
-
-            MEEM_global_status.init_stage = MEEM_INIT_READY;
+            MEEM_BeginCacheUpdate(MEEM_lane.block_id);
+            MEEM_UnpackCache(MEEM_lane.block_id, &MEEM_work_buffer[sizeof(MEEM_checksum_t)]);
+            MEEM_EndCacheUpdate(MEEM_lane.block_id);
+            MEEM_RememberPersistedData(MEEM_lane.block_id, &MEEM_work_buffer[sizeof(MEEM_checksum_t)]);
+#else /* The data is already streamed to the cache */
+            MEEM_RememberPersistedData(MEEM_lane.block_id, MEEM_block_config[MEEM_lane.block_id].cache);
+            MEEM_CloseReadSink();
+#endif
+
+            MEEM_lane.init_stage = MEEM_INIT_READY;
         }
         break;
 
         case MEEM_INIT_RECOVER_DATA:
-            MEEM_RecoverBlockData(MEEM_global_status.block_id);
-            MEEM_global_status.init_stage = MEEM_INIT_READY;
+            MEEM_RecoverBlockData(MEEM_lane.block_id);
+            MEEM_lane.init_stage = MEEM_INIT_READY;
             break;
 
         default:
             break; /* MEEM_READY */
     }
 
-    return (MEEM_INIT_READY == MEEM_global_status.init_stage);
+    return (MEEM_INIT_READY == MEEM_lane.init_stage);
 }
 
 uint8_t MEEM_GetActiveProfile(uint8_t block_id)
 {
-    assert(MEEM_MGMT_MULTI_PROFILE == MEEM_block_config[block_id].management_type);
+    assert(MEEM_MGMT_MULTI_PROFILE == MEEM_ManagementType(&MEEM_block_config[block_id]));
 
     MEEM_EnterCriticalSection();
     uint8_t active_profile = MEEM_block_status[block_id].index_of_active_instance;
@@ -95,19 +101,21 @@ uint8_t MEEM_GetActiveProfile(uint8_t block_id)
 
 bool MEEM_InitiateSwitchToProfile(uint8_t block_id, uint8_t target_profile_id)
 {
-    assert(MEEM_MGMT_MULTI_PROFILE == MEEM_block_config[block_id].management_type);
-    assert(target_profile_id < MEEM_block_config[block_id].instance_count);
+    assert(MEEM_MGMT_MULTI_PROFILE == MEEM_ManagementType(&MEEM_block_config[block_id]));
+    assert(target_profile_id < MEEM_InstanceCount(&MEEM_block_config[block_id]));
 
     MEEM_blockStatusPrivate_t* block_status = &MEEM_block_status[block_id];
     bool                       accepted     = false;
 
     MEEM_EnterCriticalSection();
-    if (MEEM_global_status.accept_new_requests && !block_status->fetch_pending && (target_profile_id != block_status->index_of_active_instance))
+    if (MEEM_global_status.accept_new_requests && !MEEM_IsFetchPending(block_id) && (target_profile_id != block_status->index_of_active_instance))
     {
         block_status->index_of_active_instance = target_profile_id;
-        block_status->recovered                = false;
-        block_status->fetch_pending            = true;
-        accepted                               = true;
+#if (MEEM_USING_LOCK_FREE_REQUESTS != true)
+        block_status->recovered = false; /* Else the core clears it, as it takes the request */
+#endif
+        MEEM_SubmitFetchRequest(block_id);
+        accepted = true;
     }
     MEEM_ExitCriticalSection();
     return accepted;
@@ -115,6 +123,6 @@ bool MEEM_InitiateSwitchToProfile(uint8_t block_id, uint8_t target_profile_id)
 
 bool MEEM_IsMultiProfileBlockReady(uint8_t block_id)
 {
-    assert(MEEM_MGMT_MULTI_PROFILE == MEEM_block_config[block_id].management_type);
-    return !MEEM_block_status[block_id].fetch_pending;
+    assert(MEEM_MGMT_MULTI_PROFILE == MEEM_ManagementType(&MEEM_block_config[block_id]));
+    return !MEEM_IsFetchPending(block_id);
 }
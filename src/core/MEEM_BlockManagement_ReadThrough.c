@@ -0,0 +1,336 @@
+/*!
+ * \file    MEEM_BlockManagement_ReadThrough.c
+ * \brief   Management routines, specific to 'read-through' blocks.
+ *          Read-through blocks have no cache in RAM. Their data is split into chunks, each one protected by its own checksum.
+ *          The user reads and writes ranges of the data with MEEM_InitiateRead() and MEEM_InitiateWrite(). The core transfers
+ *          the chunks, touched by the range, one by one through the work buffer, so the RAM cost doesn't depend on the block's size.
+ *          A chunk, which is only partially written, is read and merged first. A chunk, which fails validation, is taken as defaults.
+ * \author  Kaloyan Dimitrov
+ * \copyright Copyright (c) 2025 Kaloyan Dimitrov
+ *            https://github.com/kaladim
+ *            SPDX-License-Identifier: MIT
+ */
+/******************************************************************************/
+/*    Dependencies                                                            */
+/******************************************************************************/
+#include <assert.h>
+#include <string.h>
+#include "MEEM_EEAIF.h"
+#include "MEEM_GenConfig.h"
+#include "MEEM_Internal.h"
+#include "MEEM.h"
+
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+/******************************************************************************/
+/*    Macros                                                                  */
+/******************************************************************************/
+#define MEEM_GetChunkStart(block_cfg, position) ((uint16_t) (((position) / (block_cfg)->chunk_size) * (block_cfg)->chunk_size))
+#define MEEM_GetChunkOffset(block_cfg, chunk_start) \
+    ((block_cfg)->offset_in_eeprom + ((MEEM_eepromOffset_t) ((chunk_start) / (block_cfg)->chunk_size) * (sizeof(MEEM_checksum_t) + (block_cfg)->chunk_size)))
+
+/******************************************************************************/
+/*    Internal variables                                                      */
+/******************************************************************************/
+MEEM_rangeRequest_t MEEM_range_request[MEEM_BLOCK_COUNT];
+
+/******************************************************************************/
+/*    Private operations prototypes                                           */
+/******************************************************************************/
+static uint16_t MEEM_GetChunkLength(const MEEM_blockConfig_t* block_cfg, uint16_t chunk_start);
+static void     MEEM_BeginChunkRead(void);
+static void     MEEM_ProcessChunkImage(bool valid);
+static void     MEEM_AdvanceRange(void);
+static void     MEEM_EndRangeAccess(void);
+static void     MEEM_CompleteRangeAccess(bool write);
+
+/******************************************************************************/
+/*    Public operations                                                       */
+/******************************************************************************/
+bool MEEM_InitiateRead(uint8_t block_id, uint16_t offset, uint16_t size, void* destination)
+{
+    assert(MEEM_MGMT_READ_THROUGH == MEEM_ManagementType(&MEEM_block_config[block_id]));
+    assert((size > 0u) && (((uint32_t) offset + size) <= MEEM_block_config[block_id].data_size));
+
+    MEEM_rangeRequest_t* request  = &MEEM_range_request[block_id];
+    bool                 accepted = false;
+
+    MEEM_EnterCriticalSection();
+    if (MEEM_global_status.accept_new_requests && (0u == request->size) && !MEEM_IsFetchPending(block_id) && !MEEM_IsWritePending(block_id))
+    {
+        request->data   = (uint8_t*) destination;
+        request->offset = offset;
+        request->size   = size;
+        request->write  = false;
+#if (MEEM_USING_LOCK_FREE_REQUESTS != true)
+        MEEM_block_status[block_id].recovered = false; /* Else the core clears it, as it takes the request */
+#endif
+        MEEM_SubmitFetchRequest(block_id);
+        accepted = true;
+    }
+    MEEM_ExitCriticalSection();
+    return accepted;
+}
+
+bool MEEM_InitiateWrite(uint8_t block_id, uint16_t offset, uint16_t size, const void* source)
+{
+    assert(MEEM_MGMT_READ_THROUGH == MEEM_ManagementType(&MEEM_block_config[block_id]));
+    assert((size > 0u) && (((uint32_t) offset + size) <= MEEM_block_config[block_id].data_size));
+
+    MEEM_rangeRequest_t* request  = &MEEM_range_request[block_id];
+    bool                 accepted = false;
+
+    MEEM_EnterCriticalSection();
+    if (MEEM_global_status.accept_new_requests && (0u == request->size) && !MEEM_IsFetchPending(block_id))
+    {
+        request->data   = (uint8_t*) source; /* Only read */
+        request->offset = offset;
+        request->size   = size;
+        request->write  = true;
+#if (MEEM_USING_LOCK_FREE_REQUESTS != true)
+        MEEM_block_status[block_id].write_complete = false; /* Else the core clears it, as it takes the request */
+#endif
+        MEEM_SubmitWriteRequest(block_id);
+        accepted = true;
+    }
+    MEEM_ExitCriticalSection();
+    return accepted;
+}
+
+/******************************************************************************/
+/*    Internal operations                                                     */
+/******************************************************************************/
+/*!
+ * \brief     Starts the range access, requested for a 'read-through' block, on the active lane.
+ *            A write request without a range (e.g. by MEEM_InitiateBlockWrite()) has nothing to write, so it completes at once.
+ * \param[in] block_id - ID of the block
+ */
+void MEEM_StartReadThroughOperation(uint8_t block_id)
+{
+    MEEM_EnterCriticalSection();
+    const uint16_t size = MEEM_range_request[block_id].size;
+    MEEM_ExitCriticalSection();
+
+    MEEM_lane.block_id       = block_id;
+    MEEM_lane.range_position = MEEM_range_request[block_id].offset;
+    MEEM_lane.range_stage    = MEEM_RANGE_NEXT_CHUNK;
+#if ((MEEM_USING_WRITE_SKIPPING == true) || (MEEM_USING_WRITE_TICKETS == true) || (MEEM_USING_FLASH_EMULATION_BLOCKS == true))
+    MEEM_lane.write_error = false;
+#endif
+
+    if (0u == size)
+    {
+        MEEM_CompleteRangeAccess(true);
+    }
+}
+
+/*!
+ * \brief   State machine of a range access to a 'read-through' block.
+ * \retval  true if the access is complete
+ * \retval  false if it's still in progress
+ */
+bool MEEM_ReadThroughTask(void)
+{
+    switch (MEEM_lane.range_stage)
+    {
+        case MEEM_RANGE_NEXT_CHUNK:
+            MEEM_BeginChunkRead();
+            break;
+
+        case MEEM_RANGE_READING:
+            switch (MEEM_DeviceGetStatus())
+            {
+                case EEAIF_OK:
+                {
+                    const MEEM_blockConfig_t* block_cfg    = &MEEM_block_config[MEEM_lane.block_id];
+                    const uint16_t            chunk_length = MEEM_GetChunkLength(block_cfg, MEEM_GetChunkStart(block_cfg, MEEM_lane.range_position));
+
+                    MEEM_ProcessChunkImage(*((const MEEM_checksum_t*) &MEEM_work_buffer[0]) ==
+                                           MEEM_CalculateChecksum(&MEEM_work_buffer[sizeof(MEEM_checksum_t)], chunk_length));
+                }
+                break;
+
+                case EEAIF_NOK:
+                    MEEM_ProcessChunkImage(false); /* Can't read the EEPROM, continue with default values */
+                    break;
+
+                default:
+                    break; /* Still busy */
+            }
+            break;
+
+        case MEEM_RANGE_WRITING:
+            switch (MEEM_DeviceGetStatus())
+            {
+                case EEAIF_OK:
+                    MEEM_AdvanceRange();
+                    break;
+
+                case EEAIF_NOK:
+                    /* The rest of the range is not written. The chunk may be torn, it's read as defaults then. */
+                    MEEM_block_status[MEEM_lane.block_id].write_failed = true;
+#if ((MEEM_USING_WRITE_SKIPPING == true) || (MEEM_USING_WRITE_TICKETS == true) || (MEEM_USING_FLASH_EMULATION_BLOCKS == true))
+                    MEEM_lane.write_error = true;
+#endif
+                    MEEM_EndRangeAccess();
+                    break;
+
+                default:
+                    break; /* Still busy */
+            }
+            break;
+
+        default:
+            break; /* MEEM_RANGE_COMPLETE */
+    }
+
+    return (MEEM_RANGE_COMPLETE == MEEM_lane.range_stage);
+}
+
+/******************************************************************************/
+/*    Private operations                                                      */
+/******************************************************************************/
+/*!
+ * \param[in] block_cfg - configuration of a 'read-through' block
+ * \param[in] chunk_start - position of the chunk's first byte in the block's data
+ * \return    Data bytes in the chunk. The last one may be shorter than the others.
+ */
+static uint16_t MEEM_GetChunkLength(const MEEM_blockConfig_t* block_cfg, uint16_t chunk_start)
+{
+    const uint16_t remaining = block_cfg->data_size - chunk_start;
+
+    return (remaining < block_cfg->chunk_size) ? remaining : block_cfg->chunk_size;
+}
+
+/*!
+ * \brief  Starts the read of the chunk with the next byte of the range to the work buffer.
+ *         A chunk, which is overwritten as a whole, isn't read - its image is built from the source at once.
+ */
+static void MEEM_BeginChunkRead(void)
+{
+    const MEEM_blockConfig_t*  block_cfg    = &MEEM_block_config[MEEM_lane.block_id];
+    const MEEM_rangeRequest_t* request      = &MEEM_range_request[MEEM_lane.block_id];
+    const uint16_t             chunk_start  = MEEM_GetChunkStart(block_cfg, MEEM_lane.range_position);
+    const uint16_t             chunk_length = MEEM_GetChunkLength(block_cfg, chunk_start);
+
+    if (request->write && (request->offset <= chunk_start) && (((uint32_t) request->offset + request->size) >= ((uint32_t) chunk_start + chunk_length)))
+    {
+        MEEM_ProcessChunkImage(true);
+        return;
+    }
+
+    if (!MEEM_DeviceBeginRead(MEEM_GetChunkOffset(block_cfg, chunk_start), MEEM_work_buffer, sizeof(MEEM_checksum_t) + chunk_length))
+    {
+        assert(false); /* Wrong time to put a request (development error)! */
+    }
+    MEEM_lane.range_stage = MEEM_RANGE_READING;
+}
+
+/*!
+ * \brief     Serves the range's part of the chunk in the work buffer: copies it to the destination of a read, or merges the source of a write
+ *            into it and starts the write of the chunk's image.
+ * \param[in] valid - false if the chunk's image failed validation, so its data is taken as defaults
+ */
+static void MEEM_ProcessChunkImage(bool valid)
+{
+    const uint8_t              block_id     = MEEM_lane.block_id;
+    const MEEM_blockConfig_t*  block_cfg    = &MEEM_block_config[block_id];
+    const MEEM_rangeRequest_t* request      = &MEEM_range_request[block_id];
+    const uint16_t             chunk_start  = MEEM_GetChunkStart(block_cfg, MEEM_lane.range_position);
+    const uint16_t             chunk_length = MEEM_GetChunkLength(block_cfg, chunk_start);
+    const uint16_t             range_end    = request->offset + request->size;
+    const uint16_t             part_end     = ((chunk_start + chunk_length) < range_end) ? (chunk_start + chunk_length) : range_end;
+    uint8_t*                   chunk_data   = &MEEM_work_buffer[sizeof(MEEM_checksum_t)];
+
+    if (!valid)
+    {
+#if (MEEM_USING_RUN_LENGTH_DEFAULTS == true)
+        if (block_cfg->run_length_defaults)
+        {
+            MEEM_DecodeDefaults(block_cfg, chunk_start, chunk_length, chunk_data);
+        }
+        else
+#endif
+        {
+            for (uint16_t i = 0; i < chunk_length; i++)
+            {
+                const uint16_t position = chunk_start + i;
+
+                chunk_data[i] = block_cfg->defaults[(MEEM_DefaultPatternLength(block_cfg) > 0u) ? (position % MEEM_DefaultPatternLength(block_cfg)) : position];
+            }
+        }
+        if (!request->write)
+        {
+            MEEM_block_status[block_id].recovered = true;
+        }
+    }
+
+    if (request->write)
+    {
+        (void) memcpy(&chunk_data[MEEM_lane.range_position - chunk_start], &request->data[MEEM_lane.range_position - request->offset],
+                      part_end - MEEM_lane.range_position);
+        *((MEEM_checksum_t*) &MEEM_work_buffer[0]) = MEEM_CalculateChecksum(chunk_data, chunk_length);
+
+        if (!MEEM_DeviceBeginWrite(MEEM_GetChunkOffset(block_cfg, chunk_start), MEEM_work_buffer, sizeof(MEEM_checksum_t) + chunk_length))
+        {
+            assert(false); /* Wrong time to put a request (development error)! */
+        }
+        MEEM_lane.range_stage = MEEM_RANGE_WRITING;
+    }
+    else
+    {
+        (void) memcpy(&request->data[MEEM_lane.range_position - request->offset], &chunk_data[MEEM_lane.range_position - chunk_start],
+                      part_end - MEEM_lane.range_position);
+        MEEM_AdvanceRange();
+    }
+}
+
+/*!
+ * \brief  Moves to the start of the next chunk, or completes the access at the end of the range.
+ */
+static void MEEM_AdvanceRange(void)
+{
+    const MEEM_blockConfig_t*  block_cfg = &MEEM_block_config[MEEM_lane.block_id];
+    const MEEM_rangeRequest_t* request   = &MEEM_range_request[MEEM_lane.block_id];
+
+    MEEM_lane.range_position = MEEM_GetChunkStart(block_cfg, MEEM_lane.range_position) + block_cfg->chunk_size;
+    MEEM_lane.range_stage    = MEEM_RANGE_NEXT_CHUNK;
+
+    if (MEEM_lane.range_position >= ((uint32_t) request->offset + request->size))
+    {
+        MEEM_EndRangeAccess();
+    }
+}
+
+/*!
+ * rief  Releases the range request of the block on the active lane, at the end of the range or after a failed write.
+ */
+static void MEEM_EndRangeAccess(void)
+{
+    const uint8_t block_id = MEEM_lane.block_id;
+    const bool    write    = MEEM_range_request[block_id].write;
+
+    MEEM_EnterCriticalSection();
+    MEEM_range_request[block_id].size = 0; /* The user may put the next request now */
+    if (!write)
+    {
+        MEEM_ClearFetchPending(block_id);
+    }
+    MEEM_ExitCriticalSection();
+
+    MEEM_CompleteRangeAccess(write);
+}
+
+/*!
+ * \brief     Reports the completion of the access on the active lane. A read is reported by the cleared fetch_pending flag only.
+ * \param[in] write - true if the access is a write
+ */
+static void MEEM_CompleteRangeAccess(bool write)
+{
+    if (write)
+    {
+        MEEM_block_status[MEEM_lane.block_id].write_complete = true;
+        MEEM_CompleteBlockWrite(MEEM_lane.block_id);
+    }
+    MEEM_lane.range_stage = MEEM_RANGE_COMPLETE;
+}
+#endif
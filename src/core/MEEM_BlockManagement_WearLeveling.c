@@ -79,8 +79,8 @@ void MEEM_InitializeWearLevelingBlock(uint8_t block_id)
 
                 MEEM_StartReadOperation(block_id);
 
-                MEEM_global_status.io_request.offset_in_eeprom =
-                    block_config->offset_in_eeprom + (MEEM_global_status.io_request.size * index_of_current_instance);
+                MEEM_lane.io_request.offset_in_eeprom =
+                    block_config->offset_in_eeprom + (MEEM_lane.io_request.size * index_of_current_instance);
 
                 do
                 {
@@ -109,7 +109,7 @@ void MEEM_InitializeWearLevelingBlock(uint8_t block_id)
                 }
 
                 index_of_current_instance++;
-                if (index_of_current_instance < block_config->instance_count)
+                if (index_of_current_instance < MEEM_InstanceCount(block_config))
                 {
                     init_stage = MEEM_INIT_FETCH_INSTANCE; /* More instances to scan */
                 }
@@ -122,7 +122,7 @@ void MEEM_InitializeWearLevelingBlock(uint8_t block_id)
 
             case MEEM_INIT_ANALYZE:
             {
-                uint8_t index_of_most_recent_instance = MEEM_FindIndexOfMostRecentInstance(sequence_counters, block_config->instance_count);
+                uint8_t index_of_most_recent_instance = MEEM_FindIndexOfMostRecentInstance(sequence_counters, MEEM_InstanceCount(block_config));
 
                 if (index_of_most_recent_instance == INVALID_INDEX)
                 {
@@ -140,15 +140,20 @@ void MEEM_InitializeWearLevelingBlock(uint8_t block_id)
             case MEEM_INIT_CACHE:
             {
                 MEEM_status_t read_status;
+#if (MEEM_USING_ALIGNED_CACHES == true)
+                uint8_t* const data = MEEM_work_buffer; /* An aligned cache is unpacked from the work buffer */
+#else
+                uint8_t* const data = block_config->cache;
+#endif
 
-                /* Read the last valid instance directly to the block cache */
+                /* Read the last valid instance directly to the block cache, or to the work buffer, when the cache is aligned */
                 MEEM_StartReadOperation(block_id);
 
-                MEEM_global_status.io_request.offset_in_eeprom =
+                MEEM_lane.io_request.offset_in_eeprom =
                     sizeof(MEEM_checksum_t) + /* Since we read directly to the cache, skip the checksum */
-                    block_config->offset_in_eeprom + ((sizeof(MEEM_checksum_t) + block_config->data_size) * (uint16_t) block_status->index_of_active_instance);
-                MEEM_global_status.io_request.data = block_config->cache;
-                MEEM_global_status.io_request.size = block_config->data_size;
+                    block_config->offset_in_eeprom + ((sizeof(MEEM_checksum_t) + block_config->data_size) * (MEEM_eepromOffset_t) block_status->index_of_active_instance);
+                MEEM_lane.io_request.data = data;
+                MEEM_lane.io_request.size = block_config->data_size;
 
                 do
                 {
@@ -158,8 +163,12 @@ void MEEM_InitializeWearLevelingBlock(uint8_t block_id)
                 if (MEEM_OK == read_status)
                 {
                     /* Set next instance ID and instance index for next write */
-                    block_config->cache[0]                 = MEEM_IncrementAndWrapAround(sequence_counters[block_status->index_of_active_instance], 255);
-                    block_status->index_of_active_instance = MEEM_IncrementAndWrapAround(block_status->index_of_active_instance, block_config->instance_count);
+                    data[0]                                = MEEM_IncrementAndWrapAround(sequence_counters[block_status->index_of_active_instance], 255);
+                    block_status->index_of_active_instance = MEEM_IncrementAndWrapAround(block_status->index_of_active_instance, MEEM_InstanceCount(block_config));
+                    MEEM_RememberPersistedData(block_id, data);
+#if (MEEM_USING_ALIGNED_CACHES == true)
+                    MEEM_UnpackCache(block_id, data);
+#endif
 
                     init_stage = MEEM_INIT_READY;
                 }
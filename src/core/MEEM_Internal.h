@@ -23,7 +23,17 @@
 /******************************************************************************/
 /*    Internal macros                                                         */
 /******************************************************************************/
-#define MEEM_INVALID_PROFILE_INSTANCE 0xF /* Set to 0xFF if you need more than 14 instances in the future. */
+#if (MEEM_USING_WIDE_PROFILE_INDEX == true)
+#define MEEM_INVALID_PROFILE_INSTANCE 0xFFu /* Up to 254 profiles per multi-profile block */
+#else
+#define MEEM_INVALID_PROFILE_INSTANCE 0xFu /* Up to 14 profiles per multi-profile block */
+#endif
+
+#if (MEEM_USING_TRANSACTIONS == true)
+#define MEEM_TRANSACTION_MASK_SIZE    ((MEEM_BLOCK_COUNT + 7u) / 8u) /* A bit per block in the commit record */
+#define MEEM_TRANSACTION_COMMITTED    0x5Au /* Marker of a commit record with journaled blocks to apply */
+#define MEEM_TRANSACTION_CLOSED       0x00u /* Marker of a commit record, whose blocks are already applied */
+#endif
 
 /******************************************************************************/
 /*    Internal types                                                          */
@@ -40,7 +50,10 @@ typedef enum {
     MEEM_MGMT_BASIC,
     MEEM_MGMT_BACKUP_COPY,
     MEEM_MGMT_MULTI_PROFILE,
-    MEEM_MGMT_WEAR_LEVELING
+    MEEM_MGMT_WEAR_LEVELING,
+    MEEM_MGMT_FLASH_EMULATION,
+    MEEM_MGMT_READ_THROUGH,
+    MEEM_MGMT_MEMORY_MAPPED
 } MEEM_blockManagementType_t;
 
 /** Data recovery strategy in case of initialization failure */
@@ -52,7 +65,11 @@ typedef enum {
 typedef enum {
     MEEM_OPR_NONE,
     MEEM_OPR_INIT,
-    MEEM_OPR_WRITE
+    MEEM_OPR_WRITE,
+    MEEM_OPR_VERIFY,
+    MEEM_OPR_TRANSACTION,
+    MEEM_OPR_ERASE,
+    MEEM_OPR_READ_THROUGH
 } MEEM_currentOperation_t;
 
 /** Initialization stages */
@@ -71,28 +88,114 @@ typedef enum {
     MEEM_IO_INITIATE,
     MEEM_IO_WAITING,
     MEEM_IO_FINALIZE,
-    MEEM_IO_COMPLETE
+    MEEM_IO_COMPLETE,
+    MEEM_IO_ERASING /**< 'flash emulation' blocks only: the target sector is being erased, before the write */
 } MEEM_ioStage_t;
 
+/** Stages of a range access to a 'read-through' block. Each chunk, touched by the range, passes them. */
+typedef enum {
+    MEEM_RANGE_NEXT_CHUNK, /**< Select the next chunk, and read it, unless it's overwritten as a whole */
+    MEEM_RANGE_READING,    /**< Reading the chunk's image to the work buffer */
+    MEEM_RANGE_WRITING,    /**< Writing the merged chunk's image from the work buffer */
+    MEEM_RANGE_COMPLETE
+} MEEM_rangeStage_t;
+
+/** Background scrubbing stages */
+typedef enum {
+    MEEM_SCRUB_SELECT,
+    MEEM_SCRUB_CHECK_INSTANCE,
+    MEEM_SCRUB_FETCH_OTHER_COPY,
+    MEEM_SCRUB_CHECK_OTHER_COPY,
+    MEEM_SCRUB_REPAIR_COPY,
+    MEEM_SCRUB_WAIT_REPAIR
+} MEEM_scrubStage_t;
+
+/** Multi-block transaction stages */
+typedef enum {
+    MEEM_TX_IDLE,
+    MEEM_TX_OPEN,          /**< Begun by the user, blocks are being added */
+    MEEM_TX_COMMITTED,     /**< Committed by the user, waiting for the driver */
+    MEEM_TX_RECOVERED,     /**< Commit record found at init, the journal is already written */
+    MEEM_TX_WRITE_JOURNAL, /**< Writing the blocks' data to their journal slots */
+    MEEM_TX_WRITE_RECORD,  /**< Writing the commit record - the commit point */
+    MEEM_TX_FETCH_SLOT,    /**< Reading a block's journal slot back */
+    MEEM_TX_APPLY,         /**< Writing a block from its journal slot to its own area */
+    MEEM_TX_CLOSE          /**< Writing a closed commit record */
+} MEEM_transactionStage_t;
+
+/** Status of a scheduling lane. Each EEPROM device has its own lane, so the devices process their requests in parallel. */
 typedef struct {
     MEEM_currentOperation_t current_operation;
     uint8_t                 block_id;              /**< ID of currently processed block */
     uint8_t                 next_block_to_process; /**< ID of next block to process */
 
     union {
-        MEEM_ioStage_t   write_stage;
-        MEEM_initStage_t init_stage;
+        MEEM_ioStage_t    write_stage;
+        MEEM_initStage_t  init_stage;
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+        MEEM_rangeStage_t range_stage;
+#endif
     };
-    uint8_t accept_new_requests : 1;
 
     /** Read/write request */
     struct {
-        uint8_t*       data;
-        uint16_t       offset_in_eeprom;
-        uint16_t       size;
-        MEEM_ioStage_t stage;
-        MEEM_status_t  status;
+        uint8_t*            data;
+        MEEM_eepromOffset_t offset_in_eeprom;
+        MEEM_eepromSize_t   size;
+        MEEM_ioStage_t      stage;
+        MEEM_status_t       status;
+#if (MEEM_USING_STREAMING_IO == true)
+        uint8_t*            sink;        /**< Destination of the data of a fetched image, copied chunk by chunk. NULL - validation only. */
+        MEEM_eepromSize_t   transferred; /**< Bytes of the image, transferred so far */
+        MEEM_checksum_t     checksum;    /**< Checksum of the data, transferred so far */
+#if ((MEEM_USING_STREAMED_WRITES == true) && (MEEM_USING_WRITE_SKIPPING == true))
+        uint32_t            fingerprint; /**< Fingerprint of the data, written so far */
+#endif
+#endif
     } io_request;
+#if ((MEEM_USING_WRITE_SKIPPING == true) || (MEEM_USING_WRITE_TICKETS == true) || (MEEM_USING_FLASH_EMULATION_BLOCKS == true))
+    uint8_t write_error : 1; /**< Set if the driver reported a failure during the current write operation */
+#endif
+#if (((MEEM_USING_STREAMED_WRITES == true) || (MEEM_USING_ZERO_COPY_WRITES == true)) && (MEEM_USING_WRITE_SKIPPING == true))
+    uint8_t write_torn : 1; /**< Set if the cache changed, while it was written to the EEPROM */
+#endif
+#if (MEEM_USING_ZERO_COPY_WRITES == true)
+    uint8_t write_sequence; /**< Sequence counter of the block's cache, when the checksum of the current instance was calculated */
+    uint8_t write_attempts; /**< Repetitions of the current write, because the cache was updated, while it was written */
+#endif
+#if (MEEM_USING_WRITE_BATCHING == true)
+    uint8_t batch_last_block_id; /**< ID of the last block, whose image is in the current write. Equals block_id, unless batched. */
+#endif
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+    uint16_t range_position; /**< Position in the block's data of the next byte of the range access in progress */
+#endif
+} MEEM_laneStatus_t;
+
+typedef struct {
+    uint8_t accept_new_requests : 1;
+
+#if (MEEM_USING_SCRUBBING == true)
+    /** Background scrubbing. Active only in idle ticks. */
+    struct {
+        uint32_t          credit;            /**< Accumulated I/O budget, in 1/1000 bytes */
+        uint8_t           block_id;          /**< ID of the block being scrubbed */
+        uint8_t           instance_index;    /**< Index of the instance being scrubbed */
+        MEEM_scrubStage_t stage;
+        uint16_t          pass_count;        /**< Completed passes over all blocks */
+        uint16_t          instances_checked; /**< Validated instances, including invalid ones */
+        uint16_t          errors_detected;   /**< Invalid instances found */
+        uint16_t          repairs;           /**< Repairs performed or scheduled */
+    } scrub;
+#endif
+
+#if (MEEM_USING_TRANSACTIONS == true)
+    /** Multi-block transaction. Its blocks are written back-to-back, as a single operation. */
+    struct {
+        MEEM_transactionStage_t stage;
+        uint8_t                 block_id;                            /**< ID of the block being journaled or applied */
+        uint8_t                 members[MEEM_TRANSACTION_MASK_SIZE]; /**< A bit per block, set for the blocks in the transaction */
+    } transaction;
+#endif
 } MEEM_globalStatus_t;
 
 /** Runtime block status */
@@ -100,36 +203,175 @@ typedef struct {
     uint8_t recovered                : 1; /**< Set by the core once if initialization fails and the cache is populated with defaults */
     uint8_t write_complete           : 1; /**< Set by the core when a write operation completes. Cleared at the start of operation */
     uint8_t write_failed             : 1; /**< Set once by the core when a write operation fails */
-    uint8_t write_pending            : 1; /**< Set by the user to initiate a write in the EEPROM */
-    uint8_t fetch_pending            : 1; /**< Set by the core when the user requests a read from the EEPROM. */
-    uint8_t reserved_0               : 3;
+    uint8_t write_pending            : 1; /**< Set by the user to initiate a write in the EEPROM. Unused with lock-free requests. */
+    uint8_t fetch_pending            : 1; /**< Set by the user to request a read from the EEPROM. Unused with lock-free requests. */
+    uint8_t write_skipped            : 1; /**< Set by the core if a write request is completed without EEPROM access */
+    uint8_t verify_pending           : 1; /**< Set by the core at init, if only the primary copy of a 'backup copy' block is validated */
+    uint8_t persisted_data_known     : 1; /**< Set by the core if the fingerprint of the block's data in the EEPROM is known */
+#if (MEEM_USING_WIDE_PROFILE_INDEX == true)
+    uint8_t index_of_active_instance;
+#else
+    uint8_t                          : 0; /* Starts a new memory location, as the user writes the index of a 'multi-profile' block */
     uint8_t index_of_active_instance : 4;
     uint8_t reserved_1               : 4;
+#endif
 } MEEM_blockStatusPrivate_t;
 
 /** Block's static configuration */
 typedef struct {
-    uint8_t*       cache;
-    const uint8_t* defaults;
-    uint16_t       offset_in_eeprom;
-    uint16_t       data_size;
-    uint8_t        default_pattern_length; /**< Length of default pattern, bytes  */
-    uint8_t        instance_count         : 4;
-    uint8_t        management_type        : 2;
-    uint8_t        data_recovery_strategy : 2; /**< Actions taken on init failure */
+    uint8_t*            cache;
+    const uint8_t*      defaults;
+    MEEM_eepromOffset_t offset_in_eeprom;
+    uint16_t            data_size;
+#if (MEEM_USING_ALIGNED_CACHES == true)
+    uint16_t            cache_size; /**< Size of the aligned cache, including its padding. 0 for blocks without a cache. */
+#endif
+    uint8_t             default_pattern_length; /**< Length of default pattern, bytes  */
+#if (MEEM_USING_WIDE_PROFILE_INDEX == true)
+    uint8_t             instance_count;
+#else
+    uint8_t             instance_count         : 4;
+#endif
+#if ((MEEM_USING_FLASH_EMULATION_BLOCKS == true) || (MEEM_USING_READ_THROUGH_BLOCKS == true) || (MEEM_USING_MEMORY_MAPPED_BLOCKS == true))
+    uint8_t             management_type        : 3;
+#else
+    uint8_t             management_type        : 2;
+#endif
+    uint8_t             data_recovery_strategy : 2; /**< Actions taken on init failure */
+#if (MEEM_USING_RUN_LENGTH_DEFAULTS == true)
+    uint8_t             run_length_defaults    : 1; /**< The defaults are run-length encoded - see MEEM_DecodeDefaults() */
+#endif
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+    uint8_t             slots_per_sector;           /**< Instances in a FLASH sector of a 'flash emulation' block. 0 for the other types. */
+#endif
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+    uint8_t             chunk_size;                 /**< Data bytes in a checksum-protected chunk of a 'read-through' block. 0 for the other types. */
+#endif
+#if (MEEM_USING_WRITE_BEHIND == true)
+    uint16_t            write_behind_delay;         /**< Delay of the automatic write of a dirty block, in task periods. 0 - no write-behind. */
+#endif
+#if (MEEM_USING_WRITE_THROTTLING == true)
+    uint16_t            coalescing_window;          /**< Minimum task periods between the starts of two writes. 0 - no limit. */
+    uint16_t            write_budget;               /**< Maximum writes per hour, also the maximum count of saved write tokens. 0 - no limit. */
+    uint32_t            write_budget_period;        /**< Task periods, after which the block earns a write token */
+#endif
+#if (MEEM_USING_TRANSACTIONS == true)
+    MEEM_eepromOffset_t journal_offset;             /**< Offset of the block's slot in the transaction journal. 0 - not transactional. */
+#endif
+#if (MEEM_USING_FLUSH_PLANNER == true)
+    uint8_t             flush_priority;             /**< Criticality in an emergency flush. Blocks with higher priority are written first. */
+#endif
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+    uint8_t             device_id;                  /**< EEPROM device, which stores the block. 0 - the primary one. */
+#endif
 } MEEM_blockConfig_t;
 
+/* A specialized core gets these accessors from the generator, which folds a value, the same for all blocks, into a constant */
+#if (MEEM_USING_SPECIALIZED_CORE == false)
+#define MEEM_ManagementType(block_cfg)       ((block_cfg)->management_type)
+#define MEEM_DataRecoveryStrategy(block_cfg) ((block_cfg)->data_recovery_strategy)
+#define MEEM_DefaultPatternLength(block_cfg) ((block_cfg)->default_pattern_length)
+#define MEEM_InstanceCount(block_cfg)        ((block_cfg)->instance_count)
+#endif
+
+/* Aligned caches don't have the layout of the block's data in the EEPROM, so the generated routines pack them into an image and unpack
+   them from it. A packed cache is just copied. */
+#if (MEEM_USING_ALIGNED_CACHES == true)
+EXTERN_C void MEEM_PackCache(uint8_t block_id, uint8_t* dest);
+EXTERN_C void MEEM_UnpackCache(uint8_t block_id, const uint8_t* source);
+#define MEEM_CacheSize(block_cfg) ((block_cfg)->cache_size)
+#else
+#define MEEM_PackCache(block_id, dest)     ((void) memcpy((dest), MEEM_block_config[(block_id)].cache, MEEM_block_config[(block_id)].data_size))
+#define MEEM_UnpackCache(block_id, source) ((void) memcpy(MEEM_block_config[(block_id)].cache, (source), MEEM_block_config[(block_id)].data_size))
+#define MEEM_CacheSize(block_cfg)          ((block_cfg)->data_size)
+#endif
+
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+/** EEPROM device's static configuration. The first one is the primary device, accessed with the EEAIF_ operations. */
+typedef struct {
+    void (*init)(void);
+    void (*deinit)(void);
+    void (*task)(void);
+    bool (*begin_read)(MEEM_eepromOffset_t offset_in_eeprom, uint8_t* dest, MEEM_eepromSize_t size);
+    bool (*begin_write)(MEEM_eepromOffset_t offset_in_eeprom, const uint8_t* source, MEEM_eepromSize_t size);
+    EEAIF_status_t (*get_status)(void);
+#if (MEEM_USING_FLUSH_PLANNER == true)
+    uint16_t page_size;          /**< Size of the device's write page, in bytes. 0 - byte-wise writes. */
+    uint32_t page_write_time_us; /**< Time to write a page, or a byte with byte-wise writes */
+#endif
+} MEEM_deviceConfig_t;
+#endif
+
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+/** Range access to a 'read-through' block, requested by the user */
+typedef struct {
+    uint8_t* data;   /**< Destination of a read, or source of a write */
+    uint16_t offset; /**< Position of the range in the block's data */
+    uint16_t size;   /**< Size of the range, in bytes. 0 - no request. */
+    bool     write;
+} MEEM_rangeRequest_t;
+#endif
+
 /******************************************************************************/
 /*    Internal variables                                                      */
 /******************************************************************************/
 EXTERN_C MEEM_globalStatus_t       MEEM_global_status;
+EXTERN_C MEEM_laneStatus_t         MEEM_lane_status[MEEM_DEVICE_COUNT];
 EXTERN_C MEEM_blockStatusPrivate_t MEEM_block_status[MEEM_BLOCK_COUNT];
-EXTERN_C uint8_t                   MEEM_work_buffer[MEEM_WORKBUFFER_SIZE];
+EXTERN_C uint8_t                   MEEM_lane_work_buffer[MEEM_DEVICE_COUNT][MEEM_WORKBUFFER_SIZE];
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+EXTERN_C uint8_t                   MEEM_active_lane; /**< Lane, processed by MEEM_PeriodicTask() now. The primary one otherwise. */
+#endif
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+EXTERN_C MEEM_rangeRequest_t       MEEM_range_request[MEEM_BLOCK_COUNT]; /**< Set by the user, cleared by the core when the access completes */
+#endif
+#if (MEEM_USING_WRITE_SKIPPING == true)
+EXTERN_C uint32_t                  MEEM_persisted_fingerprint[MEEM_BLOCK_COUNT]; /**< Hashes of the blocks' data in the EEPROM, valid if persisted_data_known is set */
+#endif
 
 /******************************************************************************/
 /*    Internal constants                                                      */
 /******************************************************************************/
 EXTERN_C const MEEM_blockConfig_t MEEM_block_config[MEEM_BLOCK_COUNT];
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+EXTERN_C const MEEM_deviceConfig_t MEEM_device_config[MEEM_DEVICE_COUNT];
+#endif
+
+/******************************************************************************/
+/*    Scheduling lanes                                                        */
+/******************************************************************************/
+/* The operations of the core work on the active lane - its status, work buffer and EEPROM device */
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+#define MEEM_SelectLane(lane)                    (MEEM_active_lane = (uint8_t) (lane))
+#define MEEM_BlockDevice(block_id)               (MEEM_block_config[(block_id)].device_id)
+#define MEEM_DeviceInit()                        MEEM_device_config[MEEM_active_lane].init()
+#define MEEM_DeviceDeInit()                      MEEM_device_config[MEEM_active_lane].deinit()
+#define MEEM_DeviceTask()                        MEEM_device_config[MEEM_active_lane].task()
+#define MEEM_DeviceBeginRead(offset, dest, size) MEEM_device_config[MEEM_active_lane].begin_read((offset), (dest), (size))
+#define MEEM_DeviceBeginWrite(offset, src, size) MEEM_device_config[MEEM_active_lane].begin_write((offset), (src), (size))
+#define MEEM_DeviceGetStatus()                   MEEM_device_config[MEEM_active_lane].get_status()
+#else
+#define MEEM_active_lane                         0u
+#define MEEM_SelectLane(lane)                    ((void) (lane))
+#define MEEM_BlockDevice(block_id)               0u
+#define MEEM_DeviceInit()                        EEAIF_Init()
+#define MEEM_DeviceDeInit()                      EEAIF_DeInit()
+#define MEEM_DeviceTask()                        EEAIF_Task()
+#define MEEM_DeviceBeginRead(offset, dest, size) EEAIF_BeginRead((offset), (dest), (size))
+#define MEEM_DeviceBeginWrite(offset, src, size) EEAIF_BeginWrite((offset), (src), (size))
+#define MEEM_DeviceGetStatus()                   EEAIF_GetStatus()
+#endif
+#define MEEM_lane                                (MEEM_lane_status[MEEM_active_lane])
+#define MEEM_work_buffer                         (MEEM_lane_work_buffer[MEEM_active_lane])
+#define MEEM_IsOnActiveLane(block_id)            (MEEM_BlockDevice(block_id) == MEEM_active_lane)
+
+/* 'wear-leveling' and 'flash emulation' blocks keep a sequence counter in the first byte of their data */
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+#define MEEM_HasSequenceCounter(block_cfg) \
+    ((MEEM_ManagementType(block_cfg) == MEEM_MGMT_WEAR_LEVELING) || (MEEM_ManagementType(block_cfg) == MEEM_MGMT_FLASH_EMULATION))
+#else
+#define MEEM_HasSequenceCounter(block_cfg) (MEEM_ManagementType(block_cfg) == MEEM_MGMT_WEAR_LEVELING)
+#endif
 
 /******************************************************************************/
 /*    Internal operations                                                     */
@@ -140,22 +382,137 @@ EXTERN_C void          MEEM_RecoverBlockData(uint8_t block_id);
 EXTERN_C void          MEEM_StartReadOperation(uint8_t block_id);
 EXTERN_C void          MEEM_InitializeBasicBlock(uint8_t block_id);
 EXTERN_C void          MEEM_InitializeBackupCopyBlock(uint8_t block_id);
+#if (MEEM_USING_LAZY_BACKUP_VERIFY == true)
+EXTERN_C void          MEEM_StartBackupCopyVerification(uint8_t block_id);
+EXTERN_C bool          MEEM_VerifyBackupCopyTask(void);
+#endif
 EXTERN_C void          MEEM_InitializeWearLevelingBlock(uint8_t block_id);
 EXTERN_C uint8_t       MEEM_FindIndexOfMostRecentInstance(const uint8_t sequence_counters[], uint8_t instance_count);
 EXTERN_C bool          MEEM_InitMultiProfileBlockTask(void);
 EXTERN_C MEEM_status_t MEEM_ReadOperationTask(void);
 
+/* Run-length encoded defaults. A segment starts with a header byte: 0x00..0x7F - a literal of (header + 1) bytes follows it,
+   0x80..0xFF - a run of (header - 0x80 + MEEM_DEFAULTS_MIN_RUN) copies of the single byte, which follows it. */
+#if (MEEM_USING_RUN_LENGTH_DEFAULTS == true)
+#define MEEM_DEFAULTS_MIN_RUN 3u
+EXTERN_C void MEEM_DecodeDefaults(const MEEM_blockConfig_t* block_cfg, uint16_t position, uint16_t size, uint8_t* dest);
+#endif
+
+/* 'flash emulation' blocks. Their sectors are erased in idle time, ahead of need, or before the write, as a fallback. */
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+EXTERN_C void                MEEM_InitializeFlashEmulationBlock(uint8_t block_id);
+EXTERN_C MEEM_eepromOffset_t MEEM_GetFlashSlotOffset(uint8_t block_id, uint8_t slot);
+EXTERN_C bool                MEEM_IsEraseBeforeWriteNeeded(uint8_t block_id);
+EXTERN_C bool                MEEM_BeginEraseBeforeWrite(void);
+EXTERN_C MEEM_ioStage_t      MEEM_WaitForEraseBeforeWrite(void);
+EXTERN_C void                MEEM_FinalizeFlashSlotWrite(void);
+EXTERN_C bool                MEEM_TryStartSectorErase(void);
+EXTERN_C bool                MEEM_SectorEraseTask(void);
+#endif
+
+/* 'read-through' blocks. They have no cache - each range access reads and writes the chunks it touches, one by one, through the work buffer. */
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+EXTERN_C void MEEM_StartReadThroughOperation(uint8_t block_id);
+EXTERN_C bool MEEM_ReadThroughTask(void);
+#endif
+
+/* 'memory-mapped' blocks. They have no cache - the generated getters read the data, where the device maps it, or the defaults, if it's invalid.
+   They are read-only, so their write requests are rejected. */
+#if (MEEM_USING_MEMORY_MAPPED_BLOCKS == true)
+EXTERN_C void MEEM_InitializeMemoryMappedBlock(uint8_t block_id);
+#define MEEM_IsReadOnly(block_id) (MEEM_MGMT_MEMORY_MAPPED == MEEM_ManagementType(&MEEM_block_config[(block_id)]))
+#else
+#define MEEM_IsReadOnly(block_id) false
+#endif
+
+/* Streaming I/O. Images are transferred through the work buffer chunk by chunk. The data of fetched images is copied to the sink on the fly,
+   and written images are taken from the block's cache, followed by their checksum. */
+#if (MEEM_USING_STREAMING_IO == true)
+#define MEEM_SetReadSink(dest) (MEEM_lane.io_request.sink = (dest))
+EXTERN_C void MEEM_CloseReadSink(void);
+#else
+#define MEEM_SetReadSink(dest)
+#define MEEM_CloseReadSink()
+#endif
+
 /* Block write-related operations */
 EXTERN_C void           MEEM_StartWriteOperationCachedBlock(uint8_t block_id);
+EXTERN_C void           MEEM_PrepareWriteOperation(uint8_t block_id);
 EXTERN_C void           MEEM_CalculateAndSetChecksum(void);
 EXTERN_C void           MEEM_WriteInitiate(void);
 EXTERN_C MEEM_ioStage_t MEEM_WriteWaitToComplete(void);
 EXTERN_C MEEM_ioStage_t MEEM_WriteFinalize(void);
 EXTERN_C bool           MEEM_WriteTask(void);
+#if (MEEM_USING_WRITE_BATCHING == true)
+EXTERN_C void           MEEM_ExtendWriteBatch(void);
+#endif
 
 EXTERN_C uint8_t MEEM_IncrementAndWrapAround(uint8_t number, uint8_t exclusive_upper_limit);
 
-/* Generated */
-EXTERN_C void MEEM_ValidateConfiguration(void);
+/* Skipping of redundant writes. Writes, requested by the core are repairs, so they forget the persisted data and are never skipped. */
+#if (MEEM_USING_WRITE_SKIPPING == true)
+EXTERN_C void MEEM_RememberPersistedData(uint8_t block_id, const uint8_t* data);
+EXTERN_C bool MEEM_IsWriteRedundant(uint8_t block_id);
+#define MEEM_ForgetPersistedData(block_id) (MEEM_block_status[(block_id)].persisted_data_known = false)
+#else
+#define MEEM_RememberPersistedData(block_id, data) ((void) (data))
+#define MEEM_ForgetPersistedData(block_id) ((void) 0)
+#endif
+
+/* Write requests. With lock-free requests, the pending flags live in a dedicated atomic word, instead of the block's status. */
+/* MEEM_SubmitWriteRequest() is used for the core's regular writes, and MEEM_SetWritePending() - for repairs. */
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+EXTERN_C void MEEM_SubmitWriteRequest(uint8_t block_id);
+EXTERN_C void MEEM_SetWritePending(uint8_t block_id);
+EXTERN_C void MEEM_ClearWritePending(uint8_t block_id);
+EXTERN_C bool MEEM_IsWritePending(uint8_t block_id);
+#else
+#define MEEM_SubmitWriteRequest(block_id) (MEEM_block_status[(block_id)].write_pending = true)
+#define MEEM_SetWritePending(block_id)    (MEEM_ForgetPersistedData(block_id), MEEM_SubmitWriteRequest(block_id))
+#define MEEM_ClearWritePending(block_id)  (MEEM_block_status[(block_id)].write_pending = false)
+#define MEEM_IsWritePending(block_id)     (MEEM_block_status[(block_id)].write_pending)
+#endif
+
+/* Fetch requests of 'multi-profile' and 'read-through' blocks. With lock-free requests, these pending flags live in a dedicated atomic word too. */
+#if (MEEM_USING_LOCK_FREE_REQUESTS == true)
+EXTERN_C void MEEM_SubmitFetchRequest(uint8_t block_id);
+EXTERN_C void MEEM_ClearFetchPending(uint8_t block_id);
+EXTERN_C bool MEEM_IsFetchPending(uint8_t block_id);
+#else
+#define MEEM_SubmitFetchRequest(block_id) (MEEM_block_status[(block_id)].fetch_pending = true)
+#define MEEM_ClearFetchPending(block_id)  (MEEM_block_status[(block_id)].fetch_pending = false)
+#define MEEM_IsFetchPending(block_id)     (MEEM_block_status[(block_id)].fetch_pending)
+#endif
+
+/* Write tickets. The generation of a block's requests is captured when its cache is copied for a write, and reported on completion. */
+#if (MEEM_USING_WRITE_TICKETS == true)
+EXTERN_C void MEEM_CaptureWriteGeneration(uint8_t block_id);
+EXTERN_C void MEEM_CompleteBlockWrite(uint8_t block_id);
+#else
+#define MEEM_CaptureWriteGeneration(block_id)
+#define MEEM_CompleteBlockWrite(block_id) MEEM_OnBlockWriteComplete(block_id)
+#endif
+
+/* Cache updates by the core. With seqlock, these are provided by MEEM_GenInterface.h */
+#if (MEEM_USING_SEQLOCK != true)
+#define MEEM_BeginCacheUpdate(block_id)
+#define MEEM_EndCacheUpdate(block_id)
+#endif
+
+/* Background scrubbing */
+#if (MEEM_USING_SCRUBBING == true)
+EXTERN_C void MEEM_ScrubTask(void);
+EXTERN_C void MEEM_AbortScrub(void);
+#endif
+
+/* Multi-block transactions */
+#if (MEEM_USING_TRANSACTIONS == true)
+EXTERN_C void MEEM_LoadTransactionRecord(void);
+EXTERN_C void MEEM_ReplayJournaledBlock(uint8_t block_id);
+EXTERN_C bool MEEM_IsTransactionPending(void);
+EXTERN_C bool MEEM_IsInCommittedTransaction(uint8_t block_id);
+EXTERN_C void MEEM_StartTransaction(void);
+EXTERN_C bool MEEM_TransactionTask(void);
+#endif
 
 #endif /* MEEM_INTERNAL_H */
@@ -0,0 +1,340 @@
+/*!
+ * \file    MEEM_Scrubbing.c
+ * \brief   Background scrubbing of 'backup copy' and 'wear-leveling' blocks.
+ *          In idle ticks, the EEPROM instances are re-read round-robin and their checksums are verified, within the I/O budget of
+ *          MEEM_SCRUB_BYTES_PER_SECOND. A corrupted 'backup copy' instance is overwritten with the other one, while it's still valid.
+ *          If no valid copy is left in the EEPROM, the block's cache is written instead, just like on init failure.
+ *          For 'wear-leveling' blocks, only the most recent instance is checked - older ones are never used as long as it is valid.
+ * \author  Kaloyan Dimitrov
+ * \copyright Copyright (c) 2025 Kaloyan Dimitrov
+ *            https://github.com/kaladim
+ *            SPDX-License-Identifier: MIT
+ */
+/******************************************************************************/
+/*    Dependencies                                                            */
+/******************************************************************************/
+#include "MEEM_EEAIF.h"
+#include "MEEM_GenConfig.h"
+#include "MEEM_Internal.h"
+#include "MEEM.h"
+#include <assert.h>
+
+#if (MEEM_USING_SCRUBBING == true)
+
+/******************************************************************************/
+/*    Macros                                                                  */
+/******************************************************************************/
+#define MEEM_SCRUB_CREDIT_PER_TICK ((uint32_t) MEEM_SCRUB_BYTES_PER_SECOND * MEEM_TASK_PERIOD_MS) /* In 1/1000 bytes */
+#if (MEEM_USING_STREAMING_IO == true)
+#define MEEM_SCRUB_CREDIT_LIMIT    ((uint32_t) MEEM_LARGEST_IMAGE_SIZE * 1000UL)                   /* Enough for the largest image, streamed in chunks */
+#else
+#define MEEM_SCRUB_CREDIT_LIMIT    ((uint32_t) MEEM_WORKBUFFER_SIZE * 1000UL)                      /* Prevents bursts after long busy periods */
+#endif
+
+/******************************************************************************/
+/*    Private operations prototypes                                           */
+/******************************************************************************/
+static bool                MEEM_IsScrubbable(uint8_t block_id);
+static bool                MEEM_SelectBlockToScrub(void);
+static void                MEEM_AdvanceScrubCursor(void);
+static MEEM_eepromOffset_t MEEM_GetScrubbedInstanceOffset(uint8_t instance_index);
+static uint8_t             MEEM_GetScrubbedInstanceIndex(void);
+static bool                MEEM_TryConsumeScrubCredit(void);
+static bool                MEEM_TryStartScrubRead(uint8_t instance_index);
+static void                MEEM_RequestRepairFromCache(void);
+
+/******************************************************************************/
+/*    Public operations                                                       */
+/******************************************************************************/
+MEEM_scrubStatus_t MEEM_GetScrubStatus(void)
+{
+    MEEM_scrubStatus_t status;
+
+    MEEM_EnterCriticalSection();
+    status.pass_count        = MEEM_global_status.scrub.pass_count;
+    status.block_id          = MEEM_global_status.scrub.block_id;
+    status.instances_checked = MEEM_global_status.scrub.instances_checked;
+    status.errors_detected   = MEEM_global_status.scrub.errors_detected;
+    status.repairs           = MEEM_global_status.scrub.repairs;
+    MEEM_ExitCriticalSection();
+    return status;
+}
+
+/******************************************************************************/
+/*    Internal operations                                                     */
+/******************************************************************************/
+/*!
+ * \brief   Scrubbing state machine. Executes at most one EEPROM transaction per tick.
+ * \pre     Call only in idle ticks: no ongoing operation and no pending requests.
+ */
+void MEEM_ScrubTask(void)
+{
+    MEEM_global_status.scrub.credit += MEEM_SCRUB_CREDIT_PER_TICK;
+    if (MEEM_global_status.scrub.credit > MEEM_SCRUB_CREDIT_LIMIT)
+    {
+        MEEM_global_status.scrub.credit = MEEM_SCRUB_CREDIT_LIMIT;
+    }
+
+    switch (MEEM_global_status.scrub.stage)
+    {
+        case MEEM_SCRUB_SELECT:
+            if (MEEM_SelectBlockToScrub() && MEEM_TryStartScrubRead(MEEM_GetScrubbedInstanceIndex()))
+            {
+                MEEM_global_status.scrub.stage = MEEM_SCRUB_CHECK_INSTANCE;
+            }
+            break;
+
+        case MEEM_SCRUB_CHECK_INSTANCE:
+            switch (MEEM_ReadOperationTask())
+            {
+                case MEEM_OK:
+                    MEEM_global_status.scrub.instances_checked++;
+
+                    if (MEEM_IsDataValid(MEEM_global_status.scrub.block_id))
+                    {
+                        MEEM_AdvanceScrubCursor();
+                    }
+                    else
+                    {
+                        MEEM_global_status.scrub.errors_detected++;
+#if (MEEM_USING_STREAMING_IO != true)
+                        if (MEEM_MGMT_BACKUP_COPY == MEEM_ManagementType(&MEEM_block_config[MEEM_global_status.scrub.block_id]))
+                        {
+                            MEEM_global_status.scrub.stage = MEEM_SCRUB_FETCH_OTHER_COPY;
+                        }
+                        else
+#endif /* Otherwise, the work buffer can't hold the other copy - both are rewritten from the cache */
+                        {
+                            MEEM_RequestRepairFromCache();
+                            MEEM_AdvanceScrubCursor();
+                        }
+                    }
+                    break;
+
+                case MEEM_NOK:
+                    MEEM_AdvanceScrubCursor(); /* Driver failure, not a data integrity issue. Retry on the next pass. */
+                    break;
+
+                default:
+                    break; /* Still busy */
+            }
+            break;
+
+        case MEEM_SCRUB_FETCH_OTHER_COPY:
+            if (MEEM_TryStartScrubRead(MEEM_global_status.scrub.instance_index ^ 1u))
+            {
+                MEEM_global_status.scrub.stage = MEEM_SCRUB_CHECK_OTHER_COPY;
+            }
+            break;
+
+        case MEEM_SCRUB_CHECK_OTHER_COPY:
+            switch (MEEM_ReadOperationTask())
+            {
+                case MEEM_OK:
+                    if (MEEM_IsDataValid(MEEM_global_status.scrub.block_id))
+                    {
+                        MEEM_global_status.scrub.stage = MEEM_SCRUB_REPAIR_COPY; /* The work buffer holds the valid copy now */
+                    }
+                    else
+                    {
+                        MEEM_RequestRepairFromCache();
+                        MEEM_AdvanceScrubCursor();
+                    }
+                    break;
+
+                case MEEM_NOK:
+                    MEEM_AdvanceScrubCursor();
+                    break;
+
+                default:
+                    break; /* Still busy */
+            }
+            break;
+
+        case MEEM_SCRUB_REPAIR_COPY:
+            if (MEEM_TryConsumeScrubCredit())
+            {
+                MEEM_lane.io_request.offset_in_eeprom = MEEM_GetScrubbedInstanceOffset(MEEM_global_status.scrub.instance_index);
+                MEEM_WriteInitiate();
+                MEEM_global_status.scrub.stage = MEEM_SCRUB_WAIT_REPAIR;
+            }
+            break;
+
+        case MEEM_SCRUB_WAIT_REPAIR:
+            switch (MEEM_DeviceGetStatus())
+            {
+                case EEAIF_OK:
+                    MEEM_global_status.scrub.repairs++;
+                    MEEM_AdvanceScrubCursor();
+                    break;
+
+                case EEAIF_NOK:
+                    MEEM_AdvanceScrubCursor();
+                    break;
+
+                default:
+                    break; /* Still busy */
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*!
+ * \brief   Abandons the scrubbing step in progress, so the scheduler can process a real request as soon as the driver is free.
+ * \note    The interrupted instance is scrubbed again from the beginning in the next idle period.
+ */
+void MEEM_AbortScrub(void)
+{
+    MEEM_global_status.scrub.stage = MEEM_SCRUB_SELECT;
+}
+
+/******************************************************************************/
+/*    Private operations                                                      */
+/******************************************************************************/
+/*!
+ * \retval true if the block has redundant EEPROM instances in the primary device, worth to be scrubbed
+ * \retval false otherwise, or if the block was recovered without repair (there's no valid EEPROM image to check)
+ */
+static bool MEEM_IsScrubbable(uint8_t block_id)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[block_id];
+
+    if (((MEEM_MGMT_BACKUP_COPY != MEEM_ManagementType(block_cfg)) && (MEEM_MGMT_WEAR_LEVELING != MEEM_ManagementType(block_cfg))) ||
+        (0u != MEEM_BlockDevice(block_id)))
+    {
+        return false;
+    }
+    return !(MEEM_block_status[block_id].recovered && (MEEM_RECOVER_DEFAULTS == MEEM_DataRecoveryStrategy(block_cfg)));
+}
+
+/*!
+ * \brief   Moves the scrub cursor to the next scrubbable block, starting from the current one.
+ * \retval  true if a block to scrub is found
+ * \retval  false if there's nothing to scrub
+ */
+static bool MEEM_SelectBlockToScrub(void)
+{
+    uint8_t block_id = MEEM_global_status.scrub.block_id;
+
+    for (uint8_t c = 0; c < MEEM_BLOCK_COUNT; c++)
+    {
+        if (MEEM_IsScrubbable(block_id))
+        {
+            if (block_id != MEEM_global_status.scrub.block_id)
+            {
+                if (block_id < MEEM_global_status.scrub.block_id)
+                {
+                    MEEM_global_status.scrub.pass_count++; /* Wrapped around */
+                }
+                MEEM_global_status.scrub.block_id       = block_id;
+                MEEM_global_status.scrub.instance_index = 0;
+            }
+            return true;
+        }
+        block_id = MEEM_IncrementAndWrapAround(block_id, MEEM_BLOCK_COUNT);
+    }
+    return false;
+}
+
+static void MEEM_AdvanceScrubCursor(void)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[MEEM_global_status.scrub.block_id];
+
+    MEEM_global_status.scrub.stage = MEEM_SCRUB_SELECT;
+
+    if ((MEEM_MGMT_BACKUP_COPY == MEEM_ManagementType(block_cfg)) && (MEEM_global_status.scrub.instance_index == 0))
+    {
+        MEEM_global_status.scrub.instance_index = 1;
+        return;
+    }
+
+    MEEM_global_status.scrub.instance_index = 0;
+    MEEM_global_status.scrub.block_id       = MEEM_IncrementAndWrapAround(MEEM_global_status.scrub.block_id, MEEM_BLOCK_COUNT);
+
+    if (MEEM_global_status.scrub.block_id == 0)
+    {
+        MEEM_global_status.scrub.pass_count++;
+    }
+}
+
+/*!
+ * \return Index of the instance to scrub in the current block. For 'wear-leveling' blocks - always the most recently written one.
+ */
+static uint8_t MEEM_GetScrubbedInstanceIndex(void)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[MEEM_global_status.scrub.block_id];
+
+    if (MEEM_MGMT_WEAR_LEVELING == MEEM_ManagementType(block_cfg))
+    {
+        /* The active instance is the next one to be written, so the most recent is just before it */
+        uint8_t index_of_active_instance = MEEM_block_status[MEEM_global_status.scrub.block_id].index_of_active_instance;
+
+        MEEM_global_status.scrub.instance_index =
+            (index_of_active_instance == 0) ? (uint8_t) (MEEM_InstanceCount(block_cfg) - 1u) : (uint8_t) (index_of_active_instance - 1u);
+    }
+    return MEEM_global_status.scrub.instance_index;
+}
+
+static MEEM_eepromOffset_t MEEM_GetScrubbedInstanceOffset(uint8_t instance_index)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[MEEM_global_status.scrub.block_id];
+
+    return block_cfg->offset_in_eeprom + ((block_cfg->data_size + sizeof(MEEM_checksum_t)) * (MEEM_eepromOffset_t) instance_index);
+}
+
+/*!
+ * \brief   Consumes budget for one instance transfer, if enough is accumulated and the driver is free.
+ * \retval  true if an EEPROM transaction may be started now
+ * \retval  false otherwise
+ */
+static bool MEEM_TryConsumeScrubCredit(void)
+{
+    const uint32_t cost = ((uint32_t) MEEM_block_config[MEEM_global_status.scrub.block_id].data_size + sizeof(MEEM_checksum_t)) * 1000UL;
+
+    if ((MEEM_global_status.scrub.credit < cost) || (EEAIF_BUSY == MEEM_DeviceGetStatus()))
+    {
+        return false;
+    }
+    MEEM_global_status.scrub.credit -= cost;
+    return true;
+}
+
+static bool MEEM_TryStartScrubRead(uint8_t instance_index)
+{
+    if (!MEEM_TryConsumeScrubCredit())
+    {
+        return false;
+    }
+
+    MEEM_lane.io_request.offset_in_eeprom = MEEM_GetScrubbedInstanceOffset(instance_index);
+    MEEM_lane.io_request.data             = MEEM_work_buffer;
+    MEEM_lane.io_request.size             = MEEM_block_config[MEEM_global_status.scrub.block_id].data_size + sizeof(MEEM_checksum_t);
+    MEEM_lane.io_request.stage            = MEEM_IO_INITIATE;
+    MEEM_lane.io_request.status           = MEEM_BUSY;
+    MEEM_SetReadSink(NULL);
+
+    (void) MEEM_ReadOperationTask(); /* Push the request to the driver immediately */
+    return true;
+}
+
+/*!
+ * \brief   Schedules a regular write of the block's cache, if the configured data recovery strategy allows repairs.
+ */
+static void MEEM_RequestRepairFromCache(void)
+{
+    uint8_t block_id = MEEM_global_status.scrub.block_id;
+
+    if (MEEM_RECOVER_DEFAULTS_AND_REPAIR == MEEM_DataRecoveryStrategy(&MEEM_block_config[block_id]))
+    {
+        MEEM_EnterCriticalSection();
+        MEEM_SetWritePending(block_id);
+        MEEM_ExitCriticalSection();
+
+        MEEM_global_status.scrub.repairs++;
+    }
+}
+
+#endif /* MEEM_USING_SCRUBBING */
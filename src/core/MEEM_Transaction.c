@@ -0,0 +1,446 @@
+/*!
+ * \file    MEEM_Transaction.c
+ * \brief   Multi-block transactions with a redo journal.
+ *          On commit, the data of all blocks in the transaction is written to their slots in the journal, followed by a commit record,
+ *          which lists them. Only then the blocks are written to their own areas, and finally the record is closed.
+ *          If the init finds a committed record, the journaled data replaces the blocks' data and is applied again. So after a power
+ *          loss, either all or none of the blocks in the transaction have their new data.
+ * \author  Kaloyan Dimitrov
+ * \copyright Copyright (c) 2025 Kaloyan Dimitrov
+ *            https://github.com/kaladim
+ *            SPDX-License-Identifier: MIT
+ */
+/******************************************************************************/
+/*    Dependencies                                                            */
+/******************************************************************************/
+#include "MEEM_EEAIF.h"
+#include "MEEM_GenConfig.h"
+#include "MEEM_Internal.h"
+#include "MEEM.h"
+#include <assert.h>
+#include <string.h>
+
+#if (MEEM_USING_TRANSACTIONS == true)
+
+/******************************************************************************/
+/*    Macros                                                                  */
+/******************************************************************************/
+#define MEEM_TRANSACTION_RECORD_SIZE (sizeof(MEEM_checksum_t) + 1u + MEEM_TRANSACTION_MASK_SIZE)
+#define MEEM_IsTransactionMember(block_id) \
+    (0u != (MEEM_global_status.transaction.members[(block_id) / 8u] & (uint8_t) (1u << ((block_id) % 8u))))
+
+/******************************************************************************/
+/*    Private operations prototypes                                           */
+/******************************************************************************/
+static bool MEEM_SelectNextTransactionMember(uint8_t first_candidate);
+static void MEEM_StartJournalWrite(void);
+static void MEEM_StartRecordWrite(uint8_t marker);
+static void MEEM_StartSlotRead(void);
+static void MEEM_StartApply(void);
+static bool MEEM_ReadSynchronously(MEEM_eepromOffset_t offset_in_eeprom, MEEM_eepromSize_t size);
+
+/******************************************************************************/
+/*    Public operations                                                       */
+/******************************************************************************/
+bool MEEM_BeginTransaction(void)
+{
+    bool accepted = false;
+
+    MEEM_EnterCriticalSection();
+    if (MEEM_global_status.accept_new_requests && (MEEM_TX_IDLE == MEEM_global_status.transaction.stage))
+    {
+        (void) memset(MEEM_global_status.transaction.members, 0, sizeof(MEEM_global_status.transaction.members));
+        MEEM_global_status.transaction.stage = MEEM_TX_OPEN;
+        accepted                             = true;
+    }
+    MEEM_ExitCriticalSection();
+
+    return accepted;
+}
+
+bool MEEM_AddToTransaction(uint8_t block_id)
+{
+    assert(block_id < MEEM_BLOCK_COUNT);
+
+    bool accepted = false;
+
+    MEEM_EnterCriticalSection();
+    if ((MEEM_TX_OPEN == MEEM_global_status.transaction.stage) && (0u != MEEM_block_config[block_id].journal_offset))
+    {
+        MEEM_global_status.transaction.members[block_id / 8u] |= (uint8_t) (1u << (block_id % 8u));
+        accepted = true;
+    }
+    MEEM_ExitCriticalSection();
+
+    return accepted;
+}
+
+bool MEEM_CommitTransaction(void)
+{
+    bool accepted = false;
+
+    MEEM_EnterCriticalSection();
+    if (MEEM_TX_OPEN == MEEM_global_status.transaction.stage)
+    {
+        MEEM_global_status.transaction.stage = MEEM_TX_IDLE;
+
+        if (MEEM_global_status.accept_new_requests)
+        {
+            for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+            {
+                if (MEEM_IsTransactionMember(i))
+                {
+#if (MEEM_USING_LOCK_FREE_REQUESTS != true)
+                    MEEM_block_status[i].write_complete = false; /* Else the core clears it, as it starts the transaction */
+#endif
+                    MEEM_global_status.transaction.stage = MEEM_TX_COMMITTED;
+                    accepted                             = true;
+                }
+            }
+        }
+    }
+    MEEM_ExitCriticalSection();
+
+    return accepted;
+}
+
+/******************************************************************************/
+/*    Internal operations                                                     */
+/******************************************************************************/
+/*!
+ * \brief   Reads the commit record. If it's committed, the transaction is resumed from the journal.
+ * \note    This is a synchronous (blocking) operation! Call at init, before the blocks are initialized.
+ */
+void MEEM_LoadTransactionRecord(void)
+{
+    MEEM_global_status.transaction.stage = MEEM_TX_IDLE;
+
+    if (MEEM_ReadSynchronously(MEEM_TRANSACTION_RECORD_OFFSET, MEEM_TRANSACTION_RECORD_SIZE) &&
+        (MEEM_TRANSACTION_COMMITTED == MEEM_work_buffer[sizeof(MEEM_checksum_t)]) &&
+        (*((const MEEM_checksum_t*) &MEEM_work_buffer[0]) ==
+         MEEM_CalculateChecksum(&MEEM_work_buffer[sizeof(MEEM_checksum_t)], MEEM_TRANSACTION_RECORD_SIZE - sizeof(MEEM_checksum_t))))
+    {
+        (void) memcpy(MEEM_global_status.transaction.members, &MEEM_work_buffer[sizeof(MEEM_checksum_t) + 1u], MEEM_TRANSACTION_MASK_SIZE);
+        MEEM_global_status.transaction.stage = MEEM_TX_RECOVERED;
+
+        /* Don't trust the record blindly - only transactional blocks have journal slots */
+        for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+        {
+            if (0u == MEEM_block_config[i].journal_offset)
+            {
+                MEEM_global_status.transaction.members[i / 8u] &= (uint8_t) ~(1u << (i % 8u));
+            }
+        }
+    }
+}
+
+/*!
+ * \brief     Replaces the block's data with the journaled one, if the block is a part of a recovered transaction.
+ * \note      This is a synchronous (blocking) operation! Call at init, after the block is initialized.
+ * \param[in] block_id - ID of the initialized block
+ */
+void MEEM_ReplayJournaledBlock(uint8_t block_id)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[block_id];
+
+    if ((MEEM_TX_RECOVERED != MEEM_global_status.transaction.stage) || !MEEM_IsTransactionMember(block_id))
+    {
+        return;
+    }
+
+    if (MEEM_ReadSynchronously(block_cfg->journal_offset, sizeof(MEEM_checksum_t) + block_cfg->data_size) && MEEM_IsDataValid(block_id))
+    {
+        /* The sequence counter of 'wear-leveling' blocks is already set by their initialization */
+        if (MEEM_MGMT_WEAR_LEVELING == MEEM_ManagementType(block_cfg))
+        {
+            MEEM_work_buffer[sizeof(MEEM_checksum_t)] = block_cfg->cache[0];
+        }
+
+        MEEM_BeginCacheUpdate(block_id);
+        MEEM_UnpackCache(block_id, &MEEM_work_buffer[sizeof(MEEM_checksum_t)]);
+        MEEM_EndCacheUpdate(block_id);
+        MEEM_ForgetPersistedData(block_id);
+        MEEM_block_status[block_id].recovered = false; /* Even if the block's own area was torn by the interrupted apply */
+    }
+}
+
+/*!
+ * \retval true if a transaction waits to be started
+ * \retval false otherwise
+ */
+bool MEEM_IsTransactionPending(void)
+{
+    return (MEEM_TX_COMMITTED == MEEM_global_status.transaction.stage) || (MEEM_TX_RECOVERED == MEEM_global_status.transaction.stage);
+}
+
+/*!
+ * \retval true if the block is a member of a transaction, committed by the user and not started yet
+ * \retval false otherwise
+ */
+bool MEEM_IsInCommittedTransaction(uint8_t block_id)
+{
+    return (MEEM_TX_COMMITTED == MEEM_global_status.transaction.stage) && MEEM_IsTransactionMember(block_id);
+}
+
+/*!
+ * \brief   Starts the pending transaction as the current operation. A recovered one continues with the apply stage.
+ * \pre     The driver must be free.
+ */
+void MEEM_StartTransaction(void)
+{
+    const bool journaled = (MEEM_TX_RECOVERED == MEEM_global_status.transaction.stage);
+
+    MEEM_lane.current_operation = MEEM_OPR_TRANSACTION;
+
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        if (MEEM_IsTransactionMember(i))
+        {
+            MEEM_block_status[i].write_complete = false;
+        }
+    }
+
+    if (!MEEM_SelectNextTransactionMember(0))
+    {
+        MEEM_StartRecordWrite(MEEM_TRANSACTION_CLOSED); /* Nothing to apply */
+    }
+    else if (journaled)
+    {
+        MEEM_StartSlotRead();
+    }
+    else
+    {
+        MEEM_StartJournalWrite();
+    }
+}
+
+/*!
+ * \brief   Transaction state machine. Executes at most one EEPROM transfer per call.
+ * \retval  true if the transaction is completed
+ * \retval  false if it's still in progress
+ */
+bool MEEM_TransactionTask(void)
+{
+    switch (MEEM_global_status.transaction.stage)
+    {
+        case MEEM_TX_WRITE_JOURNAL:
+            switch (MEEM_DeviceGetStatus())
+            {
+                case EEAIF_OK:
+                    if (MEEM_SelectNextTransactionMember(MEEM_global_status.transaction.block_id + 1u))
+                    {
+                        MEEM_StartJournalWrite();
+                    }
+                    else
+                    {
+                        MEEM_StartRecordWrite(MEEM_TRANSACTION_COMMITTED);
+                    }
+                    break;
+
+                case EEAIF_NOK:
+                    /* Not committed yet, so the EEPROM still holds the old data of all blocks. Abandon the transaction. */
+                    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+                    {
+                        if (MEEM_IsTransactionMember(i))
+                        {
+                            MEEM_block_status[i].write_failed = true;
+                        }
+                    }
+                    MEEM_global_status.transaction.stage = MEEM_TX_IDLE;
+                    break;
+
+                default:
+                    break; /* Still busy */
+            }
+            break;
+
+        case MEEM_TX_WRITE_RECORD:
+            if (EEAIF_BUSY != MEEM_DeviceGetStatus())
+            {
+                /* Even if the driver reports a failure, the blocks get their new data - just without the protection of the journal */
+                (void) MEEM_SelectNextTransactionMember(0);
+                MEEM_StartSlotRead();
+            }
+            break;
+
+        case MEEM_TX_FETCH_SLOT:
+            if (MEEM_BUSY != MEEM_ReadOperationTask())
+            {
+                MEEM_StartApply();
+            }
+            break;
+
+        case MEEM_TX_APPLY:
+            if (MEEM_WriteTask())
+            {
+                MEEM_CompleteBlockWrite(MEEM_global_status.transaction.block_id);
+
+                if (MEEM_SelectNextTransactionMember(MEEM_global_status.transaction.block_id + 1u))
+                {
+                    MEEM_StartSlotRead();
+                }
+                else
+                {
+                    MEEM_StartRecordWrite(MEEM_TRANSACTION_CLOSED);
+                }
+            }
+            break;
+
+        case MEEM_TX_CLOSE:
+            if (EEAIF_BUSY != MEEM_DeviceGetStatus())
+            {
+                MEEM_global_status.transaction.stage = MEEM_TX_IDLE;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return (MEEM_TX_IDLE == MEEM_global_status.transaction.stage);
+}
+
+/******************************************************************************/
+/*    Private operations                                                      */
+/******************************************************************************/
+/*!
+ * \brief     Moves the transaction cursor to the next block in the transaction, in ascending order of IDs.
+ * \param[in] first_candidate - ID of the first block to check
+ * \retval    true if there's a next block
+ * \retval    false if there are no more blocks in the transaction
+ */
+static bool MEEM_SelectNextTransactionMember(uint8_t first_candidate)
+{
+    for (uint8_t i = first_candidate; i < MEEM_BLOCK_COUNT; i++)
+    {
+        if (MEEM_IsTransactionMember(i))
+        {
+            MEEM_global_status.transaction.block_id = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * \brief   Writes the cache of the current block to its journal slot.
+ */
+static void MEEM_StartJournalWrite(void)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[MEEM_global_status.transaction.block_id];
+
+    MEEM_lane.io_request.offset_in_eeprom = block_cfg->journal_offset;
+    MEEM_lane.io_request.size             = sizeof(MEEM_checksum_t) + block_cfg->data_size;
+    MEEM_lane.io_request.data             = MEEM_work_buffer;
+
+    MEEM_CaptureWriteGeneration(MEEM_global_status.transaction.block_id);
+    MEEM_EnterCriticalSection();
+    MEEM_PackCache(MEEM_global_status.transaction.block_id, &MEEM_work_buffer[sizeof(MEEM_checksum_t)]);
+    MEEM_ExitCriticalSection();
+
+    MEEM_CalculateAndSetChecksum();
+    MEEM_WriteInitiate();
+    MEEM_global_status.transaction.stage = MEEM_TX_WRITE_JOURNAL;
+}
+
+/*!
+ * \brief     Writes the commit record.
+ * \param[in] marker - MEEM_TRANSACTION_COMMITTED or MEEM_TRANSACTION_CLOSED
+ */
+static void MEEM_StartRecordWrite(uint8_t marker)
+{
+    MEEM_lane.io_request.offset_in_eeprom = MEEM_TRANSACTION_RECORD_OFFSET;
+    MEEM_lane.io_request.size             = MEEM_TRANSACTION_RECORD_SIZE;
+    MEEM_lane.io_request.data             = MEEM_work_buffer;
+
+    MEEM_work_buffer[sizeof(MEEM_checksum_t)] = marker;
+    if (MEEM_TRANSACTION_COMMITTED == marker)
+    {
+        (void) memcpy(&MEEM_work_buffer[sizeof(MEEM_checksum_t) + 1u], MEEM_global_status.transaction.members, MEEM_TRANSACTION_MASK_SIZE);
+    }
+    else
+    {
+        (void) memset(&MEEM_work_buffer[sizeof(MEEM_checksum_t) + 1u], 0, MEEM_TRANSACTION_MASK_SIZE);
+    }
+
+    MEEM_CalculateAndSetChecksum();
+    MEEM_WriteInitiate();
+    MEEM_global_status.transaction.stage = (MEEM_TRANSACTION_COMMITTED == marker) ? MEEM_TX_WRITE_RECORD : MEEM_TX_CLOSE;
+}
+
+/*!
+ * \brief   Reads the journal slot of the current block back, so exactly the committed data is applied.
+ */
+static void MEEM_StartSlotRead(void)
+{
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[MEEM_global_status.transaction.block_id];
+
+    MEEM_lane.io_request.offset_in_eeprom = block_cfg->journal_offset;
+    MEEM_lane.io_request.size             = sizeof(MEEM_checksum_t) + block_cfg->data_size;
+    MEEM_lane.io_request.data             = MEEM_work_buffer;
+    MEEM_lane.io_request.stage            = MEEM_IO_INITIATE;
+    MEEM_lane.io_request.status           = MEEM_BUSY;
+
+    (void) MEEM_ReadOperationTask(); /* Push the request to the driver immediately */
+    MEEM_global_status.transaction.stage = MEEM_TX_FETCH_SLOT;
+}
+
+/*!
+ * \brief   Starts the write of the current block to its own area, with the data from the journal slot in the work buffer.
+ *          If the slot can't be read back, the block's cache is written instead.
+ */
+static void MEEM_StartApply(void)
+{
+    const uint8_t             block_id  = MEEM_global_status.transaction.block_id;
+    const MEEM_blockConfig_t* block_cfg = &MEEM_block_config[block_id];
+
+    if ((MEEM_OK == MEEM_lane.io_request.status) && MEEM_IsDataValid(block_id))
+    {
+        MEEM_PrepareWriteOperation(block_id);
+
+        if (MEEM_MGMT_WEAR_LEVELING == MEEM_ManagementType(block_cfg))
+        {
+            MEEM_work_buffer[sizeof(MEEM_checksum_t)] = block_cfg->cache[0]; /* The journaled sequence counter may be outdated */
+        }
+    }
+    else
+    {
+        MEEM_StartWriteOperationCachedBlock(block_id);
+    }
+
+#if (MEEM_USING_LAZY_BACKUP_VERIFY == true)
+    MEEM_block_status[block_id].verify_pending = false; /* Both copies will be written anyway */
+#endif
+#if (MEEM_USING_WRITE_SKIPPING == true)
+    (void) MEEM_IsWriteRedundant(block_id); /* Just remember the fingerprint - the write is never skipped */
+    MEEM_block_status[block_id].write_skipped = false;
+#endif
+    MEEM_block_status[block_id].write_complete = false;
+    MEEM_OnBlockWriteStarted(block_id);
+    MEEM_global_status.transaction.stage = MEEM_TX_APPLY;
+}
+
+/*!
+ * \brief     Reads a region of the EEPROM to the work buffer and waits for the completion.
+ * \retval    true if the read is successful
+ * \retval    false otherwise
+ */
+static bool MEEM_ReadSynchronously(MEEM_eepromOffset_t offset_in_eeprom, MEEM_eepromSize_t size)
+{
+    MEEM_status_t status;
+
+    MEEM_lane.io_request.offset_in_eeprom = offset_in_eeprom;
+    MEEM_lane.io_request.size             = size;
+    MEEM_lane.io_request.data             = MEEM_work_buffer;
+    MEEM_lane.io_request.stage            = MEEM_IO_INITIATE;
+    MEEM_lane.io_request.status           = MEEM_BUSY;
+
+    do
+    {
+        status = MEEM_ReadOperationTask();
+    } while (MEEM_BUSY == status);
+
+    return (MEEM_OK == status);
+}
+
+#endif /* MEEM_USING_TRANSACTIONS */
@@ -20,14 +20,46 @@
 /******************************************************************************/
 /** Runtime status of a block */
 typedef struct {
-    uint8_t recovered      : 1; /**< Set once when initialization fails and the cache is populated with defaults */
+    uint8_t recovered      : 1; /**< Set once when initialization fails and the cache is populated with defaults. 'memory-mapped' blocks are read as defaults then. */
     uint8_t write_complete : 1; /**< Set by the core when a write operation completes. Cleared at the actual start of the operation. */
     uint8_t write_failed   : 1; /**< Set once when a write operation fails.  */
     uint8_t write_pending  : 1; /**< Set after call to #MEEM_InitiateBlockWrite() */
-    uint8_t fetch_pending  : 1; /**< Set after call to #MEEM_InitiateSwitchToProfile(). Apply to 'multi-profile' blocks only! */
-    uint8_t reserved       : 3; /**< Do not use these */
+    uint8_t fetch_pending  : 1; /**< Set after call to #MEEM_InitiateSwitchToProfile() or #MEEM_InitiateRead(). Apply to 'multi-profile' and 'read-through' blocks only! */
+    uint8_t write_skipped  : 1; /**< Set along with write_complete, if the data was already in the EEPROM and the write was skipped. Cleared at the start of a physical write. */
+    uint8_t reserved       : 2; /**< Do not use these */
 } MEEM_blockStatus_t;
 
+/** Progress and statistics of the background scrubbing. All counters are reset by #MEEM_Init(). */
+typedef struct {
+    uint16_t pass_count;        /**< Completed passes over all 'backup copy' and 'wear-leveling' blocks */
+    uint8_t  block_id;          /**< ID of the block currently being scrubbed */
+    uint16_t instances_checked; /**< Count of instances read and validated */
+    uint16_t errors_detected;   /**< Count of instances found corrupted */
+    uint16_t repairs;           /**< Count of copies restored, or block writes requested to restore the EEPROM image */
+} MEEM_scrubStatus_t;
+
+/** Identifies a write request of a block. Returned by #MEEM_InitiateBlockWriteEx(). */
+typedef uint32_t MEEM_ticket_t;
+
+/** Ticket of a rejected request */
+#define MEEM_INVALID_TICKET ((MEEM_ticket_t) 0u)
+
+/** Progress of a ticketed write request */
+typedef enum {
+    MEEM_TICKET_PENDING, /**< The request's data is not written yet */
+    MEEM_TICKET_DONE,    /**< The request's data, or a newer one, is in the EEPROM */
+    MEEM_TICKET_FAILED   /**< The write, which took the request's data, has failed, or the request was rejected */
+} MEEM_ticketStatus_t;
+
+/** Write completion event, delivered by #MEEM_GetCompletionEvent() */
+typedef struct {
+    MEEM_ticket_t ticket;          /**< The newest ticket, served by the write. Older tickets of the block are served, too. */
+    uint8_t       block_id;        /**< ID of the written block */
+    uint8_t       failed      : 1; /**< Set if the write has failed */
+    uint8_t       lost_before : 1; /**< Set if earlier events were dropped, as the queue was full */
+    uint8_t       reserved    : 6; /**< Do not use these */
+} MEEM_completionEvent_t;
+
 /******************************************************************************/
 /*    Exported operations                                                     */
 /******************************************************************************/
@@ -59,29 +91,122 @@ EXTERN_C void MEEM_Resume(void);
 /*!
  * \brief  Stops acceptance of new write/profile fetch requests
  * \note   Currently pending write/profile fetch requests will still be processed.
+ *         Writes, deferred by write throttling, are no longer held back.
  */
 EXTERN_C void MEEM_Suspend(void);
 
+/*!
+ * \brief  Starts all deferred writes as soon as possible, e.g. before a shutdown.
+ * \note   Expires the write-behind delays of dirty blocks and lifts the write throttling, until #MEEM_IsBusy() returns false.
+ *         Without write-behind and throttling, it has no effect.
+ */
+EXTERN_C void MEEM_Flush(void);
+
+/*!
+ * \brief  Estimates the time to complete the write in progress and all pending, deferred and dirty block writes.
+ * \note   Available only if 'page_write_time_us' > 0 in the platform settings. The estimate counts the EEPROM pages to write,
+ *         so the driver's own overhead is not included. Neither are committed transactions.
+ * \return Estimated time, in microseconds
+ */
+EXTERN_C uint32_t MEEM_EstimateFlushTime(void);
+
+/*!
+ * \brief     Synchronously writes as many pending blocks as possible within a time budget, e.g. after a power failure is detected.
+ * \details   Suspends the mEEM and completes the operation in progress. Then writes the pending and dirty blocks, deferred ones included,
+ *            one by one, in descending 'flush_priority' and, within the same priority, from the shortest to the longest write.
+ *            Blocks, whose estimated write time exceeds the rest of the budget, are left pending. A committed transaction,
+ *            which has not started yet, is left out as well - its blocks keep their old data.
+ * \note      Available only if 'page_write_time_us' > 0 in the platform settings.
+ * \pre       Call from the thread, which calls #MEEM_PeriodicTask(), or after that thread is stopped.
+ * \param[in] budget_us - time, for which the hold-up energy lasts, in microseconds
+ * \return    Count of the blocks, written within the budget. Skipped writes of unchanged data (see 'skip_unchanged_writes') are not counted.
+ */
+EXTERN_C uint8_t MEEM_EmergencyFlush(uint32_t budget_us);
+
 /*!
  * \brief     Triggers an asynchronous write of the block's data cache to the EEPROM.
  * \note      Write is not guaranteed to start immediately - it depends on count of waiting blocks.
+ * \note      With lock-free requests enabled, it's safe to call from any thread without a critical section.
  * \param[in] block_id of the block to write
  * \retval    true If the request is accepted and the write operation is scheduled
  * \retval    false If one of the following conditions is fulfilled:
  *            - #MEEM_Suspend() has already been called
  *            - This block already has a pending write request
  *            - This block already has a pending switchover request
+ *            - This block is a read-only 'memory-mapped' block
  */
 EXTERN_C bool MEEM_InitiateBlockWrite(uint8_t block_id);
 
+/*!
+ * \brief     Triggers an asynchronous write of the block's data cache to the EEPROM, like #MEEM_InitiateBlockWrite(), and returns a ticket for it.
+ * \details   A request for a block with a pending write is merged into it, and still gets a valid ticket.
+ *            Use #MEEM_GetTicketStatus() to find out whether the cache's content at the time of this call has reached the EEPROM.
+ * \note      Available only if 'write_tickets' or 'completion_queue_size' is enabled in the platform settings.
+ *            Tickets are invalidated by #MEEM_DeInit(), and a ticket's status is reliable for the next 32767 requests of the same block.
+ * \param[in] block_id of the block to write
+ * \return    Ticket of the request, or #MEEM_INVALID_TICKET if #MEEM_Suspend() has been called, there's a pending switchover request,
+ *            or the block is a read-only 'memory-mapped' block
+ */
+EXTERN_C MEEM_ticket_t MEEM_InitiateBlockWriteEx(uint8_t block_id);
+
+/*!
+ * \brief     Returns the progress of a ticketed write request.
+ * \note      Safe to call from any thread.
+ * \param[in] ticket - returned by #MEEM_InitiateBlockWriteEx()
+ * \return    Status of the request
+ */
+EXTERN_C MEEM_ticketStatus_t MEEM_GetTicketStatus(MEEM_ticket_t ticket);
+
+/*!
+ * \brief     Checks if a ticketed write request is finished, successfully or not.
+ * \param[in] ticket - returned by #MEEM_InitiateBlockWriteEx()
+ * \retval    true If the status of the ticket is final
+ * \retval    false If the request's data is not written yet
+ */
+EXTERN_C bool MEEM_IsTicketDone(MEEM_ticket_t ticket);
+
+/*!
+ * \brief     Runs #MEEM_PeriodicTask() until a ticketed write request is finished.
+ * \pre       Call only from the thread, which calls #MEEM_PeriodicTask(), e.g. on shutdown.
+ * \note      It's a synchronous (blocking) operation! A write, deferred by the write throttling, is waited for - call #MEEM_Flush() first to avoid it.
+ * \param[in] ticket - returned by #MEEM_InitiateBlockWriteEx()
+ * \return    Final status of the request
+ */
+EXTERN_C MEEM_ticketStatus_t MEEM_WaitTicket(MEEM_ticket_t ticket);
+
+/*!
+ * \brief      Takes the oldest write completion event from the completion queue.
+ * \details    With the queue, #MEEM_OnBlockWriteComplete() is not called by the core. Events are taken in the application's own context instead.
+ *             If the queue is full, further events are dropped. Tickets remain accurate anyway.
+ * \note       Available only if 'completion_queue_size' > 0 in the platform settings. Call it from a single thread.
+ * \param[out] event - receives the event
+ * \retval     true If an event is taken
+ * \retval     false If the queue is empty
+ */
+EXTERN_C bool MEEM_GetCompletionEvent(MEEM_completionEvent_t* event);
+
+/*!
+ * \brief     Marks a block as changed, so it's written automatically, at the latest after its write-behind delay.
+ * \details   Generated setters of blocks with 'write_behind_delay_ms' > 0 call it on a real change of the value.
+ *            Call it after a direct modification of the block's cache. Blocks without a delay are written as soon as possible.
+ * \note      Available only if at least one block in the data model has a write-behind delay.
+ *            Unlike #MEEM_InitiateBlockWrite(), it's accepted also while the mEEM is suspended.
+ *            Changes of a 'multi-profile' block, which are not written yet, are discarded by a profile switchover.
+ * \param[in] block_id ID of the changed block
+ */
+EXTERN_C void MEEM_MarkBlockDirty(uint8_t block_id);
+
 /*!
  * \brief     Populates the block's data cache with default values.
+ * \note      Not applicable to 'read-through' and 'memory-mapped' blocks, as they have no cache.
  * \param[in] block_id ID of the block to restore
  */
 EXTERN_C void MEEM_RestoreDefaults(uint8_t block_id);
 
 /*!
  * \brief  Checks for an ongoing or pending write/fetch operation in any block.
+ * \note   Deferred verification of 'backup copy' blocks (if lazy verification is enabled) and dirty blocks, waiting for their
+ *         write-behind delay, are also taken into account. So are writes, deferred by write throttling, and committed transactions.
  * \retval true If there are waiting or currently processed blocks
  * \retval false otherwise
  */
@@ -94,11 +219,19 @@ EXTERN_C bool MEEM_IsBusy(void);
  */
 EXTERN_C MEEM_blockStatus_t MEEM_GetBlockStatus(uint8_t block_id);
 
+/*!
+ * \brief  Returns progress and statistics of the background scrubbing.
+ * \note   Available only if the scrubbing is enabled (scrub_bytes_per_second > 0 in the platform settings).
+ * \return Current scrubbing status
+ */
+EXTERN_C MEEM_scrubStatus_t MEEM_GetScrubStatus(void);
+
 /*------------------------ Control API for 'multi-profile' blocks ------------------*/
 /*!
  * \brief     Retrieves the index of currently active profile of a 'multi-profile' block.
  * \param[in] block_id ID of the multi-profile block.
- * \retval    [0..14] index/ID of currently active profile. The maximal value depends on configured instance count.
+ * \retval    [0..14] index/ID of currently active profile, or [0..253] if #MEEM_USING_WIDE_PROFILE_INDEX is enabled.
+ *            The maximal value depends on configured instance count.
  */
 EXTERN_C uint8_t MEEM_GetActiveProfile(uint8_t block_id);
 
@@ -126,4 +259,56 @@ EXTERN_C bool MEEM_InitiateSwitchToProfile(uint8_t block_id, uint8_t target_prof
  */
 EXTERN_C bool MEEM_IsMultiProfileBlockReady(uint8_t block_id);
 
+/*------------------------ Control API for 'read-through' blocks -------------------*/
+/*!
+ * \brief     Initiates the read of a range of a 'read-through' block's data. Each chunk, touched by the range, is read and validated.
+ * \note      A chunk, which fails validation, is read as defaults and the block's status gets 'recovered'.
+ * \param[in] block_id ID of the read-through block
+ * \param[in] offset Position of the range in the block's data
+ * \param[in] size Size of the range, in bytes. Must be > 0.
+ * \param[out] destination Buffer for the data. Must stay valid until the read completes.
+ * \retval    true If the request is accepted
+ * \retval    false If #MEEM_Suspend() has already been called, or the block has another read or write in progress
+ * \post      The read is complete when the block's status has no 'fetch_pending' flag.
+ */
+EXTERN_C bool MEEM_InitiateRead(uint8_t block_id, uint16_t offset, uint16_t size, void* destination);
+
+/*!
+ * \brief     Initiates the write of a range of a 'read-through' block's data. Chunks, which are only partially written, are read and merged first.
+ * \note      The write is reported like the write of any other block: 'write_pending', then 'write_complete' and maybe 'write_failed'.
+ *            A failed write leaves the rest of the range unwritten.
+ * \param[in] block_id ID of the read-through block
+ * \param[in] offset Position of the range in the block's data
+ * \param[in] size Size of the range, in bytes. Must be > 0.
+ * \param[in] source The data to write. Must stay valid and unchanged until the write completes.
+ * \retval    true If the request is accepted
+ * \retval    false If #MEEM_Suspend() has already been called, or the block has another read or write in progress
+ */
+EXTERN_C bool MEEM_InitiateWrite(uint8_t block_id, uint16_t offset, uint16_t size, const void* source);
+
+/*!
+ * \brief  Opens a multi-block transaction. Available if at least one block in the data model is transactional.
+ * \retval true If the transaction is opened
+ * \retval false If #MEEM_Suspend() has already been called, or another transaction is open or not completed yet
+ */
+EXTERN_C bool MEEM_BeginTransaction(void);
+
+/*!
+ * \brief     Adds a block to the open transaction. Its cache is captured at the start of the commit, not now.
+ * \param[in] block_id ID of a transactional block
+ * \retval    true If the block is added, or it's already in the transaction
+ * \retval    false If there's no open transaction, or the block is not transactional
+ */
+EXTERN_C bool MEEM_AddToTransaction(uint8_t block_id);
+
+/*!
+ * \brief  Closes the open transaction and schedules its blocks to be written as one batch, ahead of other requests.
+ * \note   The blocks' data is written to the transaction journal first, then a commit record, and only then - to the blocks' areas.
+ *         If the power is lost in the meantime, #MEEM_Init() finds either the record, and completes the transaction from the journal,
+ *         or no record, and the old data of all blocks. Each block reports its completion as a regular write.
+ * \retval true If the transaction is committed
+ * \retval false If there's no open transaction, it's empty, or #MEEM_Suspend() has been called. The transaction is discarded.
+ */
+EXTERN_C bool MEEM_CommitTransaction(void);
+
 #endif /* MEEM_H */
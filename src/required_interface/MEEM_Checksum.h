@@ -28,4 +28,18 @@
  */
 EXTERN_C MEEM_checksum_t MEEM_CalculateChecksum(const void* data, uint16_t data_size);
 
+#if (MEEM_USING_STREAMING_IO == true)
+/*!
+ * \brief     Continues a checksum calculation over the next chunk of data. Required only if 'streaming_chunk_size' > 0.
+ * \details   Executed in the context of the #MEEM_PeriodicTask() function. The core transfers large blocks chunk by chunk, so it starts
+ *            with the checksum of no data - MEEM_CalculateChecksum(data, 0), and passes the result of each call to the next one.
+ * \pre       The final result must be equal to the one of #MEEM_CalculateChecksum() over the whole data.
+ * \param[in] checksum - checksum of the preceding data
+ * \param[in] data - pointer to the next chunk of data
+ * \param[in] data_size - in bytes
+ * \return    checksum of the preceding data and the chunk
+ */
+EXTERN_C MEEM_checksum_t MEEM_UpdateChecksum(MEEM_checksum_t checksum, const void* data, uint16_t data_size);
+#endif
+
 #endif /* MEEM_CHECKSUM_H */
@@ -15,6 +15,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "MEEM_Linkage.h"
+#include "MEEM_GenConfig.h"
 
 /******************************************************************************/
 /*    Types                                                                   */
@@ -58,10 +59,11 @@ EXTERN_C void EEAIF_Task(void);
  * \param[in]  offset_in_eeprom not an absolute address. The EEPROM access driver is responsible to map to an absolute address!
  * \param[out] dest destination buffer
  * \param[in]  size byte count
+ * \note    The offset and size are 32-bit if #MEEM_USING_32BIT_ADDRESSING is enabled, i.e. some of the EEPROMs is larger than 64KiB.
  * \retval  true if the request is accepted
  * \retval  false if the request is rejected: either the driver is busy with another operation or some of the parameters is invalid
  */
-EXTERN_C bool EEAIF_BeginRead(uint16_t offset_in_eeprom, uint8_t* dest, uint16_t size);
+EXTERN_C bool EEAIF_BeginRead(MEEM_eepromOffset_t offset_in_eeprom, uint8_t* dest, MEEM_eepromSize_t size);
 
 /*!
  * \brief   Tries to push a write request to the EEPROM access driver.
@@ -74,7 +76,33 @@ EXTERN_C bool EEAIF_BeginRead(uint16_t offset_in_eeprom, uint8_t* dest, uint16_t
  * \retval  true if the request is accepted
  * \retval  false if the request is rejected: either the driver is busy with another operation or some of the parameters is invalid
  */
-EXTERN_C bool EEAIF_BeginWrite(uint16_t offset_in_eeprom, const uint8_t* source, uint16_t size);
+EXTERN_C bool EEAIF_BeginWrite(MEEM_eepromOffset_t offset_in_eeprom, const uint8_t* source, MEEM_eepromSize_t size);
+
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+/*!
+ * \brief   Tries to push a sector erase request to the EEPROM access driver. Required only if 'flash emulation' blocks are used.
+ * \details Executed in the context of #MEEM_PeriodicTask(). The completion is reported by #EEAIF_GetStatus(), like for the other requests.
+ * \pre     The erase operation is asynchronous and this function is expected to return immediately!
+ * \param[in] offset_in_eeprom start of the area to erase, aligned to #MEEM_FLASH_SECTOR_SIZE. Not an absolute address!
+ * \param[in] size byte count, always #MEEM_FLASH_SECTOR_SIZE
+ * \note    The core expects the erased cells to read as 0xFF and to be programmable without another erase.
+ *          The time it takes is configured as 'sector_erase_time_us' in the platform settings and used by the flush time estimation.
+ * \retval  true if the request is accepted
+ * \retval  false if the request is rejected: either the driver is busy with another operation or some of the parameters is invalid
+ */
+EXTERN_C bool EEAIF_BeginErase(MEEM_eepromOffset_t offset_in_eeprom, MEEM_eepromSize_t size);
+#endif
+
+#if (MEEM_USING_MEMORY_MAPPED_BLOCKS == true)
+/*!
+ * \brief   Gets the address, where the CPU reads a location of the EEPROM directly. Required only if 'memory-mapped' blocks are used.
+ * \details Called once per 'memory-mapped' block by #MEEM_Init(). Their generated getters read the data from this address afterwards.
+ * \pre     A synchronous/blocking operation is expected. The mapping must not change until #MEEM_DeInit().
+ * \param[in] offset_in_eeprom start of the block's image. Not an absolute address!
+ * \return  Mapped address of the location, or NULL if the EEPROM isn't readable at the moment. The block falls back to its defaults then.
+ */
+EXTERN_C const uint8_t* EEAIF_GetMappedAddress(MEEM_eepromOffset_t offset_in_eeprom);
+#endif
 
 /*!
  * \brief   Gets the status of last accepted request.
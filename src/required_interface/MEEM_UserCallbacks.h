@@ -47,7 +47,7 @@ EXTERN_C void MEEM_OnBlockWriteStarted(uint8_t block_id);
 /*!
  * \brief     The mEEM core notifies the user about the completion of a write operation via this callback. The user is expected to check the status of the
  * operation, by calling #MEEM_GetBlockStatus().
- * \note      Called in the context of #MEEM_PeriodicTask().
+ * \note      Called in the context of #MEEM_PeriodicTask(). Not called at all, if the completion queue is enabled - see #MEEM_GetCompletionEvent().
  * \param[in] block_id in the range [0..(MEEM_BLOCK_COUNT-1)]
  */
 EXTERN_C void MEEM_OnBlockWriteComplete(uint8_t block_id);
@@ -108,8 +108,18 @@ static const uint8_t CRC8_table[256] = {
  */
 uint8_t CRC8_Compute(const uint8_t *data, uint16_t data_length)
 {
-    uint8_t crc = CRC_8_INITIAL_VALUE;
+    return CRC8_Update(CRC_8_INITIAL_VALUE, data, data_length);
+}
 
+/*!
+ * \brief      Continues a CRC8 calculation over the next part of the data
+ *  \param[in]  crc - CRC of the preceding data
+ *  \param[in]  data - source data buffer
+ *  \param[in]  data_length - number of bytes to calculate
+ *  \return     calculated 8bit CRC value
+ */
+uint8_t CRC8_Update(uint8_t crc, const uint8_t *data, uint16_t data_length)
+{
     while (0 != data_length)
     {
         crc = CRC8_table[crc ^ *data];
@@ -20,5 +20,6 @@
 /*    Public operations prototypes                                            */
 /******************************************************************************/
 EXTERN_C uint8_t CRC8_Compute(const uint8_t *data, uint16_t data_length);
+EXTERN_C uint8_t CRC8_Update(uint8_t crc, const uint8_t *data, uint16_t data_length);
 
 #endif /* CRC_H */
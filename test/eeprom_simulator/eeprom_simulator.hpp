@@ -36,10 +36,14 @@ public:
     {
         length = std::min(length, eeprom.size() - offset);
         std::copy(src, src + length, eeprom.begin() + offset);
+        write_count++;
         _status_postpone_counter = status_postpone_ticks;
         return true;
     }
 
+    /// @brief Count of the accepted write requests
+    size_t write_count{0};
+
     EEAIF_status_t get_status()
     {
         if (_status_postpone_counter > 0)
@@ -60,6 +64,20 @@ public:
         erase(0, eeprom.size());
     }
 
+    /*!
+     * \brief Simulates an asynchronous sector erase of a data FLASH.
+     */
+    bool begin_erase(size_t offset, size_t length)
+    {
+        erase(offset, length);
+        erase_count++;
+        _status_postpone_counter = status_postpone_ticks;
+        return true;
+    }
+
+    /// @brief Count of the accepted erase requests
+    size_t erase_count{0};
+
     void return_nok_for_next_jobs()
     {
         _return_nok_for_next_jobs = true;
@@ -69,6 +87,14 @@ public:
         _return_nok_for_next_jobs = false;
     }
 
+    /*!
+     * \brief Simulates a slow device - the current job stays busy for the given count of status polls.
+     */
+    void postpone_status(uint8_t polls)
+    {
+        _status_postpone_counter = polls;
+    }
+
     /*!
      * \brief Loads the EEPROM image from a file.
      */
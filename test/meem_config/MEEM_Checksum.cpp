@@ -11,3 +11,10 @@ MEEM_checksum_t MEEM_CalculateChecksum(const void* data, uint16_t data_size)
 {
     return static_cast<MEEM_checksum_t>(CRC8_Compute(static_cast<const uint8_t*>(data), data_size));
 }
+
+#if (MEEM_USING_STREAMING_IO == true)
+MEEM_checksum_t MEEM_UpdateChecksum(MEEM_checksum_t checksum, const void* data, uint16_t data_size)
+{
+    return static_cast<MEEM_checksum_t>(CRC8_Update(static_cast<uint8_t>(checksum), static_cast<const uint8_t*>(data), data_size));
+}
+#endif
@@ -7,6 +7,9 @@
 #include "MEEM.h"
 
 std::unique_ptr<EepromSimulator> eep_sim = std::make_unique<EepromSimulator>("./eeprom.bin", MEEM_AVAILABLE_EEPROM_BYTES);
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+std::unique_ptr<EepromSimulator> ext_eep_sim = std::make_unique<EepromSimulator>("./eeprom_ext.bin", MEEM_DEVICE_external_AVAILABLE_BYTES);
+#endif
 
 /******************************************************************************/
 /*    Required operations by the mEEM core                                    */
@@ -23,17 +26,63 @@ void EEAIF_Task(void)
 {
 }
 
-bool EEAIF_BeginRead(uint16_t offset_in_eeprom, uint8_t *dest, uint16_t size)
+bool EEAIF_BeginRead(MEEM_eepromOffset_t offset_in_eeprom, uint8_t *dest, MEEM_eepromSize_t size)
 {
     return eep_sim->read(offset_in_eeprom, dest, size);
 }
 
-bool EEAIF_BeginWrite(uint16_t offset_in_eeprom, const uint8_t *source, uint16_t size)
+bool EEAIF_BeginWrite(MEEM_eepromOffset_t offset_in_eeprom, const uint8_t *source, MEEM_eepromSize_t size)
 {
     return eep_sim->write(offset_in_eeprom, source, size);
 }
 
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+bool EEAIF_BeginErase(MEEM_eepromOffset_t offset_in_eeprom, MEEM_eepromSize_t size)
+{
+    return eep_sim->begin_erase(offset_in_eeprom, size);
+}
+#endif
+
+#if (MEEM_USING_MEMORY_MAPPED_BLOCKS == true)
+const uint8_t *EEAIF_GetMappedAddress(MEEM_eepromOffset_t offset_in_eeprom)
+{
+    return &eep_sim->eeprom[offset_in_eeprom]; /* The simulated EEPROM is in the RAM, so it's mapped, too */
+}
+#endif
+
 EEAIF_status_t EEAIF_GetStatus(void)
 {
     return eep_sim->get_status();
 }
+
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+/******************************************************************************/
+/*    Driver of the 'external' EEPROM device                                  */
+/******************************************************************************/
+EXTERN_C void EXT_EEAIF_Init(void)
+{
+}
+
+EXTERN_C void EXT_EEAIF_DeInit(void)
+{
+}
+
+EXTERN_C void EXT_EEAIF_Task(void)
+{
+}
+
+EXTERN_C bool EXT_EEAIF_BeginRead(MEEM_eepromOffset_t offset_in_eeprom, uint8_t *dest, MEEM_eepromSize_t size)
+{
+    return ext_eep_sim->read(offset_in_eeprom, dest, size);
+}
+
+EXTERN_C bool EXT_EEAIF_BeginWrite(MEEM_eepromOffset_t offset_in_eeprom, const uint8_t *source, MEEM_eepromSize_t size)
+{
+    return ext_eep_sim->write(offset_in_eeprom, source, size);
+}
+
+EXTERN_C EEAIF_status_t EXT_EEAIF_GetStatus(void)
+{
+    return ext_eep_sim->get_status();
+}
+#endif
@@ -0,0 +1,14 @@
+#ifndef MEEM_TEST_HOOKS_H
+#define MEEM_TEST_HOOKS_H
+
+/******************************************************************************/
+/*    Dependencies                                                            */
+/******************************************************************************/
+#include "MEEM_Linkage.h"
+
+/******************************************************************************/
+/*    Platform operations, named in the platform settings of the tests        */
+/******************************************************************************/
+EXTERN_C void Test_SeqlockWait(void);
+
+#endif /* MEEM_TEST_HOOKS_H */
@@ -2,6 +2,7 @@
 /*    Dependencies                                                            */
 /******************************************************************************/
 #include "MEEM_UserCallbacks.h"
+#include "MEEM_TestHooks.h"
 #include "MEEM_UserCallbacks_Mock.hpp"
 
 // Define the static instance pointer (initialized to nullptr by default)
@@ -57,4 +58,15 @@ void MEEM_OnMultiProfileBlockFetchComplete(uint8_t block_id)
     {
         MockUserCallbacks::instance->OnMultiProfileBlockFetchComplete(block_id);
     }
-}
\ No newline at end of file
+}
+
+/******************************************************************************/
+/*    Platform operations                                                     */
+/******************************************************************************/
+void Test_SeqlockWait(void)
+{
+    if (MockUserCallbacks::instance)
+    {
+        MockUserCallbacks::instance->SeqlockWait();
+    }
+}
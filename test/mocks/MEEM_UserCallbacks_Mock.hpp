@@ -21,6 +21,9 @@ class MockUserCallbacks
     MOCK_METHOD(void, OnBlockWriteComplete, (uint8_t block_id));
     MOCK_METHOD(void, OnMultiProfileBlockFetchStarted, (uint8_t block_id));
     MOCK_METHOD(void, OnMultiProfileBlockFetchComplete, (uint8_t block_id));
+
+    // Platform operations, named in the platform settings
+    MOCK_METHOD(void, SeqlockWait, ());
 };
 
 #endif // MEEM_USER_CALLBACKS_MOCK_HPP
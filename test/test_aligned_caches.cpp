@@ -0,0 +1,108 @@
+#include "test_base.hpp"
+#include <cstring>
+
+class AlignedCachesTest : public TestBase
+{
+  public:
+    static constexpr uint8_t block_id{MEEM_BLOCK_Block_Aligned_0_ID};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+        eep_sim->erase();
+        ReInit();
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    void ReInit()
+    {
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    /// @brief Returns the block's data, as persisted in the EEPROM
+    std::vector<uint8_t> GetDataInEeprom()
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+        const auto begin     = eep_sim->eeprom.cbegin() + block_cfg->offset_in_eeprom + sizeof(MEEM_checksum_t);
+        return std::vector<uint8_t>(begin, begin + block_cfg->data_size);
+    }
+
+    void SetParameters()
+    {
+        MEEM_Set_Block_Aligned_0_counter(0xA1u);
+        MEEM_Set_Block_Aligned_0_total(0x11223344u);
+        MEEM_Set_Block_Aligned_0_limits(-2, 0u);
+        MEEM_Set_Block_Aligned_0_limits(0x5566, 2u);
+        MEEM_Set_Block_Aligned_0_mode(0x7788u);
+    }
+};
+
+TEST_F(AlignedCachesTest, CacheIsNaturallyAligned)
+{
+    if (!MEEM_USING_ALIGNED_CACHES)
+    {
+        GTEST_SKIP() << "Requires aligned caches";
+    }
+
+    EXPECT_EQ(offsetof(MEEM_params_Block_Aligned_0_t, total) % alignof(uint32_t), 0u);
+    EXPECT_EQ(offsetof(MEEM_params_Block_Aligned_0_t, limits) % alignof(int16_t), 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&MEEM_cache_Block_Aligned_0.total) % alignof(uint32_t), 0u);
+    EXPECT_GT(sizeof(MEEM_cache_Block_Aligned_0), MEEM_block_config[block_id].data_size);
+}
+
+TEST_F(AlignedCachesTest, DefaultsAreUnpacked)
+{
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_counter(), 7u);
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_total(), 0x12345678u);
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_limits(0u), -100);
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_limits(2u), 100);
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_mode(), 0x1234u);
+}
+
+TEST_F(AlignedCachesTest, ImageIsPacked)
+{
+    SetParameters();
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilIdle();
+
+    // The EEPROM image keeps the packed layout, regardless of the cache's one
+    const auto data = GetDataInEeprom();
+    uint32_t   total;
+    int16_t    limits[3];
+    uint16_t   mode;
+
+    ASSERT_EQ(data.size(), 13u);
+    std::memcpy(&total, &data[1], sizeof(total));
+    std::memcpy(limits, &data[5], sizeof(limits));
+    std::memcpy(&mode, &data[11], sizeof(mode));
+    EXPECT_EQ(data[0], 0xA1u);
+    EXPECT_EQ(total, 0x11223344u);
+    EXPECT_EQ(limits[0], -2);
+    EXPECT_EQ(limits[1], 0);
+    EXPECT_EQ(limits[2], 0x5566);
+    EXPECT_EQ(mode, 0x7788u);
+}
+
+TEST_F(AlignedCachesTest, CacheIsRestoredAfterReinit)
+{
+    SetParameters();
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilIdle();
+
+    ReInit();
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).recovered);
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_counter(), 0xA1u);
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_total(), 0x11223344u);
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_limits(0u), -2);
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_limits(1u), 0);
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_limits(2u), 0x5566);
+    EXPECT_EQ(MEEM_Get_Block_Aligned_0_mode(), 0x7788u);
+}
@@ -16,11 +16,15 @@ class BackupCopyBlockTest : public TestBase
     // If the constructor and destructor are not enough for setting up
     // and cleaning up each test, you can define the following methods:
 
-    void SetUp() override {}
+    void SetUp() override
+    {
+        TestBase::SetUp(); // Important: Call base class SetUp() first
+    }
 
     void TearDown() override
     {
         // Code here will be called immediately after each test (right before the destructor).
+        TestBase::TearDown();
     }
 
     bool BothInstancesIdenticalInEeeprom(uint8_t block_id)
@@ -99,3 +103,76 @@ TEST_F(BackupCopyBlockTest, EnsureBothInstancesWritten)
         EXPECT_TRUE(BothInstancesIdenticalInEeeprom(block_id));
     }
 }
+
+TEST_F(BackupCopyBlockTest, LazyVerificationReadsOnlyPrimaryCopyAtInit)
+{
+    if (!MEEM_USING_LAZY_BACKUP_VERIFY)
+    {
+        GTEST_SKIP() << "Requires lazy verification of backup copies";
+    }
+
+    MEEM_Init();
+    ProcessMeemUntilIdle();
+    MEEM_Resume();
+
+    std::vector<uint8_t> backup_blocks_ids = FilterBlocksByManagementType(MEEM_MGMT_BACKUP_COPY);
+
+    for (auto block_id : backup_blocks_ids)
+    {
+        ChangeAllDataInBlock(block_id);
+        MEEM_InitiateBlockWrite(block_id);
+    }
+    ProcessMeemUntilIdle();
+
+    MEEM_DeInit();
+    MEEM_Init();
+
+    for (auto block_id : backup_blocks_ids)
+    {
+        // Primary copy is valid - the secondary one is left for later
+        EXPECT_FALSE(MEEM_GetBlockStatus(block_id).recovered);
+        EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_pending);
+        EXPECT_TRUE(MEEM_block_status[block_id].verify_pending);
+    }
+
+    // Valid secondary copies - verification must not write anything
+    auto eeprom_before_verification = CreateEepromSnapshot();
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(testing::_)).Times(0);
+    ProcessMeemUntilIdle();
+
+    for (auto block_id : backup_blocks_ids)
+    {
+        EXPECT_FALSE(MEEM_block_status[block_id].verify_pending);
+    }
+    EXPECT_EQ(eeprom_before_verification, eep_sim->eeprom);
+}
+
+TEST_F(BackupCopyBlockTest, LazyVerificationDefersToUserRequests)
+{
+    if (!MEEM_USING_LAZY_BACKUP_VERIFY)
+    {
+        GTEST_SKIP() << "Requires lazy verification of backup copies";
+    }
+
+    MEEM_Init();
+    ProcessMeemUntilIdle();
+
+    std::vector<uint8_t> backup_blocks_ids = FilterBlocksByManagementType(MEEM_MGMT_BACKUP_COPY);
+    const auto           block_id          = backup_blocks_ids.at(0);
+
+    // Corrupt the secondary copy, then request a write before the verification takes place
+    CorruptInstanceInEeprom(block_id, 1);
+    MEEM_DeInit();
+    MEEM_Init();
+    MEEM_Resume();
+    ASSERT_TRUE(MEEM_block_status[block_id].verify_pending);
+
+    ChangeAllDataInBlock(block_id);
+    MEEM_InitiateBlockWrite(block_id);
+
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(block_id)).Times(1); // The write repairs the copy, no need of another one
+    ProcessMeemUntilIdle();
+
+    EXPECT_FALSE(MEEM_block_status[block_id].verify_pending);
+    EXPECT_TRUE(BothInstancesIdenticalInEeeprom(block_id));
+}
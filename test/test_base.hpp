@@ -16,6 +16,9 @@
 #include "MEEM_UserCallbacks_Mock.hpp"
 
 extern std::unique_ptr<EepromSimulator> eep_sim;
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+extern std::unique_ptr<EepromSimulator> ext_eep_sim;
+#endif
 
 class TestBase : public testing::Test
 {
@@ -60,13 +63,26 @@ class TestBase : public testing::Test
         do
         {
             MEEM_PeriodicTask();
+            DispatchCompletionEvents();
         } while (MEEM_IsBusy());
     }
 
+    /// @brief With the completion queue, the core doesn't call MEEM_OnBlockWriteComplete(). Deliver the events, like an application would do.
+    void DispatchCompletionEvents()
+    {
+#if (MEEM_USING_COMPLETION_QUEUE == true)
+        MEEM_completionEvent_t event;
+        while (MEEM_GetCompletionEvent(&event))
+        {
+            MEEM_OnBlockWriteComplete(event.block_id);
+        }
+#endif
+    }
+
     void ChangeAllDataInBlock(uint8_t block_id)
     {
         auto block_cfg = &MEEM_block_config[block_id];
-        int  i         = static_cast<int>(block_cfg->management_type == MEEM_MGMT_WEAR_LEVELING);
+        int  i         = static_cast<int>(MEEM_HasSequenceCounter(block_cfg));
 
         // Change the block's data
         for (; i < block_cfg->data_size; i++)
@@ -75,21 +91,56 @@ class TestBase : public testing::Test
         }
     }
 
-    bool IsOwnAreaWrittenOnly(uint8_t block_id, std::vector<uint8_t>& eeprom_before_write)
+    /// @return Size of the block's area in the EEPROM. 'Flash emulation' blocks occupy whole sectors.
+    size_t GetBlockAreaSize(uint8_t block_id)
     {
         auto block_cfg = &MEEM_block_config[block_id];
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+        if (block_cfg->management_type == MEEM_MGMT_FLASH_EMULATION)
+        {
+            return (block_cfg->instance_count / block_cfg->slots_per_sector) * MEEM_FLASH_SECTOR_SIZE;
+        }
+#endif
+        return (block_cfg->data_size + sizeof(MEEM_checksum_t)) * block_cfg->instance_count;
+    }
 
-        // 1. Compare the area before block start
-        if (not std::equal(eeprom_before_write.begin(), eeprom_before_write.begin() + block_cfg->offset_in_eeprom, eep_sim->eeprom.begin()))
+    /// @return true if the byte at the offset may be erased in idle time, i.e. it's in the area of a 'flash emulation' block
+    bool IsErasableInIdleTime(size_t offset)
+    {
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+        for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
         {
-            return false;
+            auto block_cfg = &MEEM_block_config[i];
+            if ((block_cfg->management_type == MEEM_MGMT_FLASH_EMULATION) && (offset >= block_cfg->offset_in_eeprom) &&
+                (offset < (block_cfg->offset_in_eeprom + GetBlockAreaSize(i))))
+            {
+                return true;
+            }
         }
+#endif
+        (void) offset;
+        return false;
+    }
 
-        // Compare the area after block end
-        const auto block_area_size_in_eeprom = (block_cfg->data_size + sizeof(MEEM_checksum_t)) * block_cfg->instance_count;
+    /// @brief Checks that a write of the block didn't change the rest of the EEPROM. Sectors of 'flash emulation' blocks may get erased meanwhile.
+    bool IsOwnAreaWrittenOnly(uint8_t block_id, std::vector<uint8_t>& eeprom_before_write)
+    {
+        auto       block_cfg  = &MEEM_block_config[block_id];
+        const auto area_start = static_cast<size_t>(block_cfg->offset_in_eeprom);
+        const auto area_end   = area_start + GetBlockAreaSize(block_id);
 
-        return std::equal(eeprom_before_write.begin() + block_cfg->offset_in_eeprom + block_area_size_in_eeprom, eeprom_before_write.end(),
-                          eep_sim->eeprom.begin() + block_cfg->offset_in_eeprom + block_area_size_in_eeprom);
+        for (size_t i = 0; i < eep_sim->eeprom.size(); i++)
+        {
+            if ((i >= area_start) && (i < area_end))
+            {
+                continue;
+            }
+            if ((eep_sim->eeprom[i] != eeprom_before_write[i]) && !((eep_sim->eeprom[i] == EepromSimulator::erased_state) && IsErasableInIdleTime(i)))
+            {
+                return false;
+            }
+        }
+        return true;
     }
 
     /// @brief Filter blocks by management type
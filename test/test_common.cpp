@@ -28,6 +28,9 @@ class TestCommon : public TestBase
 TEST_F(TestCommon, InitFromBlankEeprom)
 {
     eep_sim->erase();
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+    ext_eep_sim->erase();
+#endif
     MEEM_DeInit();
 
     for (uint8_t block_id = 0; block_id < MEEM_BLOCK_COUNT; block_id++)
@@ -68,8 +71,38 @@ TEST_F(TestCommon, InitFromPreviouslyValidEeprom)
     }
 }
 
+TEST_F(TestCommon, RunLengthEncodedDefaultsAreRestored)
+{
+    if (!MEEM_USING_RUN_LENGTH_DEFAULTS)
+    {
+        GTEST_SKIP() << "Requires run-length encoded defaults";
+    }
+
+#if (MEEM_USING_RUN_LENGTH_DEFAULTS == true)
+    constexpr uint8_t          block_id{MEEM_BLOCK_Block_WearLeveling_1_ID};
+    const auto                 block_cfg = &MEEM_block_config[block_id];
+    const std::vector<uint8_t> expected{0, 0, 0, 0, 0, 0, 0, 0, 0x12, 0x34, 0, 0}; // As in the data model, after the sequence counter
+
+    ASSERT_TRUE(block_cfg->run_length_defaults);
+    std::fill(block_cfg->cache, block_cfg->cache + block_cfg->data_size, 0xFF);
+    MEEM_RestoreDefaults(block_id);
+    EXPECT_EQ(std::vector<uint8_t>(block_cfg->cache + 1, block_cfg->cache + block_cfg->data_size), expected);
+
+    // A range may start and end in the middle of segments
+    std::vector<uint8_t> range(5);
+    MEEM_DecodeDefaults(block_cfg, 6, static_cast<uint16_t>(range.size()), range.data());
+    EXPECT_EQ(range, std::vector<uint8_t>(expected.cbegin() + 6, expected.cbegin() + 11));
+#endif
+}
+
 TEST_F(TestCommon, EnsureProcessingStartsAlwaysFromBlock0)
 {
+    // Repair the blocks first. A repair would take the single write token of a block with a write budget, and defer its write.
+    MEEM_DeInit();
+    MEEM_Init();
+    MEEM_Resume();
+    ProcessMeemUntilIdle();
+
     MEEM_DeInit();
     MEEM_Init();
     ProcessMeemUntilIdle();
@@ -82,17 +115,32 @@ TEST_F(TestCommon, EnsureProcessingStartsAlwaysFromBlock0)
         EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_pending);
     }
 
+    // Blocks in other EEPROM devices are processed in parallel, by the lanes of their devices
+    for (uint8_t block_id = 1; block_id < MEEM_BLOCK_COUNT; block_id++)
+    {
+        if (MEEM_BlockDevice(block_id) != 0u)
+        {
+            EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(block_id)).Times(1);
+            EXPECT_CALL(user_callbacks_mock, OnBlockWriteComplete(block_id)).Times(1);
+        }
+    }
+
     {
         InSequence seq;
         EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(0)).Times(1);
         EXPECT_CALL(user_callbacks_mock, OnBlockWriteComplete(0)).Times(1);
     }
     MEEM_PeriodicTask(); // First call of the task should trigger processing of block #0
+    DispatchCompletionEvents();
 
     {
         InSequence seq;
         for (uint8_t block_id = 1; block_id < MEEM_BLOCK_COUNT; block_id++)
         {
+            if (MEEM_BlockDevice(block_id) != 0u)
+            {
+                continue;
+            }
             EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(block_id)).Times(1);
             EXPECT_CALL(user_callbacks_mock, OnBlockWriteComplete(block_id)).Times(1);
         }
@@ -134,6 +182,25 @@ TEST_F(TestCommon, WriteOnUserRequestAndVerifyOnlyOwnBlockAreaIsChanged)
     }
 }
 
+TEST_F(TestCommon, BlockAreasDoNotOverlap)
+{
+    // The layout may be reordered by the generator, so compare each pair of blocks in the same device
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        const size_t start = MEEM_block_config[i].offset_in_eeprom;
+        const size_t end   = start + GetBlockAreaSize(i);
+
+        for (uint8_t j = 0; j < i; j++)
+        {
+            const size_t other_start = MEEM_block_config[j].offset_in_eeprom;
+            const size_t other_end   = other_start + GetBlockAreaSize(j);
+
+            EXPECT_TRUE((MEEM_BlockDevice(i) != MEEM_BlockDevice(j)) || (end <= other_start) || (other_end <= start))
+                << "Block #" << static_cast<int>(i) << " overlaps block #" << static_cast<int>(j);
+        }
+    }
+}
+
 TEST_F(TestCommon, EepromDriverFailureWhenWriting)
 {
     MEEM_DeInit();
@@ -143,12 +210,19 @@ TEST_F(TestCommon, EepromDriverFailureWhenWriting)
 
     for (int block_id = 0; block_id < MEEM_BLOCK_COUNT; block_id++)
     {
+        ChangeAllDataInBlock(block_id); // Unchanged data may be not written at all
         MEEM_InitiateBlockWrite(block_id);
     }
 
     eep_sim->return_nok_for_next_jobs(); // Simulate driver failure
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+    ext_eep_sim->return_nok_for_next_jobs();
+#endif
     ProcessMeemUntilIdle();
     eep_sim->return_ok_for_next_jobs();
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+    ext_eep_sim->return_ok_for_next_jobs();
+#endif
 
     for (int block_id = 0; block_id < MEEM_BLOCK_COUNT; block_id++)
     {
@@ -156,6 +230,83 @@ TEST_F(TestCommon, EepromDriverFailureWhenWriting)
     }
 }
 
+TEST_F(TestCommon, WriteOfUnchangedDataIsSkipped)
+{
+    if (!MEEM_USING_WRITE_SKIPPING)
+    {
+        GTEST_SKIP() << "Requires skipping of unchanged writes";
+    }
+
+    MEEM_DeInit();
+    MEEM_Init();
+    ProcessMeemUntilIdle();
+    MEEM_Resume();
+    ProcessMeemUntilIdle(); // Repairs of the recovered blocks
+
+    for (uint8_t block_id = 0; block_id < MEEM_BLOCK_COUNT; block_id++)
+    {
+        if (MEEM_GetBlockStatus(block_id).recovered)
+        {
+            // Make sure the EEPROM holds the cached data. Only a repair has written it already.
+            const bool repaired = (MEEM_RECOVER_DEFAULTS_AND_REPAIR == MEEM_DataRecoveryStrategy(&MEEM_block_config[block_id]));
+
+            ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+            ProcessMeemUntilIdle();
+            EXPECT_EQ(MEEM_GetBlockStatus(block_id).write_skipped, repaired);
+        }
+
+        auto eeprom_before_write = CreateEepromSnapshot();
+
+        EXPECT_CALL(user_callbacks_mock, OnBlockWriteComplete(block_id)).Times(1);
+        ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+        ProcessMeemUntilIdle();
+
+        EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+        EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_skipped);
+        EXPECT_EQ(eep_sim->eeprom, eeprom_before_write);
+        testing::Mock::VerifyAndClearExpectations(&user_callbacks_mock);
+
+        // Changed data must be written again
+        ChangeAllDataInBlock(block_id);
+        ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+        ProcessMeemUntilIdle();
+
+        EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+        EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_skipped);
+        EXPECT_TRUE(IsOwnAreaWrittenOnly(block_id, eeprom_before_write));
+    }
+}
+
+TEST_F(TestCommon, WriteIsNotSkippedAfterDriverFailure)
+{
+    if (!MEEM_USING_WRITE_SKIPPING)
+    {
+        GTEST_SKIP() << "Requires skipping of unchanged writes";
+    }
+
+    MEEM_DeInit();
+    MEEM_Init();
+    ProcessMeemUntilIdle();
+    MEEM_Resume();
+
+    const uint8_t block_id = FilterBlocksByManagementType(MEEM_MGMT_BASIC).at(0);
+
+    ChangeAllDataInBlock(block_id);
+    eep_sim->return_nok_for_next_jobs();
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilIdle();
+    eep_sim->return_ok_for_next_jobs();
+
+    // The same data - but the failed write may have left anything in the EEPROM
+    CorruptInstanceInEeprom(block_id, 0);
+    auto eeprom_before_write = CreateEepromSnapshot();
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilIdle();
+
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_skipped);
+    EXPECT_NE(eep_sim->eeprom, eeprom_before_write);
+}
+
 TEST_F(TestCommon, EnsureEachBlockWillBeProcessedEvenOnHighLoad)
 {
     constexpr uint16_t REQUESTS_PER_BLOCK{MEEM_BLOCK_COUNT * 3};
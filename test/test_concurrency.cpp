@@ -0,0 +1,213 @@
+#include "test_base.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+class ConcurrencyTest : public TestBase
+{
+  public:
+    static constexpr size_t producers_count{4u};
+
+    /// @brief Per-block generation of requests, incremented by producers just before each write request
+    std::array<std::atomic<uint32_t>, MEEM_BLOCK_COUNT> requested_generation{};
+
+    /// @brief Per-block snapshot of requested_generation, taken by the consumer when a write starts
+    std::array<uint32_t, MEEM_BLOCK_COUNT> written_generation{};
+
+    /// @brief Per-block count of profile switchovers, started by the consumer
+    std::array<uint32_t, MEEM_BLOCK_COUNT> fetch_count{};
+
+    std::atomic<bool> stop_consumer{false};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_LOCK_FREE_REQUESTS)
+        {
+            GTEST_SKIP() << "Requires lock-free requests";
+        }
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+
+        ON_CALL(user_callbacks_mock, OnBlockWriteStarted(testing::_)).WillByDefault([this](uint8_t block_id) {
+            written_generation[block_id] = requested_generation[block_id].load();
+        });
+        ON_CALL(user_callbacks_mock, OnMultiProfileBlockFetchStarted(testing::_)).WillByDefault([this](uint8_t block_id) {
+            fetch_count[block_id]++;
+        });
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    /// @brief The only thread, allowed to call MEEM_PeriodicTask()
+    std::thread StartConsumer()
+    {
+        return std::thread([this]() {
+            while (!stop_consumer.load())
+            {
+                MEEM_PeriodicTask();
+            }
+        });
+    }
+
+    void StopConsumer(std::thread& consumer)
+    {
+        stop_consumer = true;
+        consumer.join();
+        ProcessMeemUntilIdle();
+    }
+
+    /// @brief Blocks, which can receive write requests at any time
+    std::vector<uint8_t> GetWritableBlocks()
+    {
+        std::vector<uint8_t> blocks_ids{};
+        for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+        {
+            if (MEEM_block_config[i].management_type != MEEM_MGMT_MULTI_PROFILE)
+            {
+                blocks_ids.push_back(i);
+            }
+        }
+        return blocks_ids;
+    }
+
+    /// @brief Blocks, whose write requests are rejected during a profile switchover
+    std::vector<uint8_t> GetMultiProfileBlocks()
+    {
+        std::vector<uint8_t> blocks_ids{};
+        for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+        {
+            if (MEEM_block_config[i].management_type == MEEM_MGMT_MULTI_PROFILE)
+            {
+                blocks_ids.push_back(i);
+            }
+        }
+        return blocks_ids;
+    }
+};
+
+TEST_F(ConcurrencyTest, NoWriteRequestIsLostWithMultipleProducers)
+{
+    constexpr size_t requests_per_producer{20000u};
+    const auto       blocks_ids        = GetWritableBlocks();
+    const auto       multi_profile_ids = GetMultiProfileBlocks();
+    std::atomic<size_t> accepted_count{0};
+    std::atomic<bool>   stop_switcher{false};
+    std::array<uint32_t, MEEM_BLOCK_COUNT> accepted_switches{};
+    std::array<uint8_t, MEEM_BLOCK_COUNT>  target_profile{};
+
+    auto consumer = StartConsumer();
+
+    // Switches the profiles of the 'multi-profile' blocks, while the core updates the same blocks' status for their writes and fetches
+    std::thread switcher([&]() {
+        while (!stop_switcher.load())
+        {
+            for (auto block_id : multi_profile_ids)
+            {
+                (void) MEEM_InitiateBlockWrite(block_id); // Rejected during a switchover, so its generation isn't tracked
+
+                const uint8_t target = static_cast<uint8_t>((MEEM_GetActiveProfile(block_id) + 1u) % MEEM_block_config[block_id].instance_count);
+                if (MEEM_InitiateSwitchToProfile(block_id, target))
+                {
+                    accepted_switches[block_id]++;
+                    target_profile[block_id] = target;
+                }
+            }
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < producers_count; p++)
+    {
+        producers.emplace_back([&, p]() {
+            for (size_t r = 0; r < requests_per_producer; r++)
+            {
+                const auto block_id = blocks_ids[(p + r) % blocks_ids.size()];
+
+                // A rejected request is still served by the one already pending, as its write hasn't started yet
+                requested_generation[block_id]++;
+                if (MEEM_InitiateBlockWrite(block_id))
+                {
+                    accepted_count++;
+                }
+            }
+        });
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    stop_switcher = true;
+    switcher.join();
+    StopConsumer(consumer);
+
+    EXPECT_GT(accepted_count.load(), 0u);
+    EXPECT_FALSE(MEEM_IsBusy());
+
+    // Each accepted switchover must have been fetched, to the profile requested last
+    for (auto block_id : multi_profile_ids)
+    {
+        EXPECT_GT(accepted_switches[block_id], 0u);
+        EXPECT_EQ(fetch_count[block_id], accepted_switches[block_id]) << "Block #" << static_cast<int>(block_id);
+        EXPECT_EQ(MEEM_GetActiveProfile(block_id), target_profile[block_id]);
+        EXPECT_TRUE(MEEM_IsMultiProfileBlockReady(block_id));
+        EXPECT_FALSE(MEEM_GetBlockStatus(block_id).fetch_pending);
+    }
+
+    // Each block must have been written after its most recent request
+    for (auto block_id : blocks_ids)
+    {
+        EXPECT_EQ(written_generation[block_id], requested_generation[block_id].load()) << "Block #" << static_cast<int>(block_id);
+        EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_pending);
+        EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+    }
+}
+
+TEST_F(ConcurrencyTest, RequestSubmissionThroughput)
+{
+    constexpr auto duration   = std::chrono::milliseconds(200);
+    const auto     blocks_ids = GetWritableBlocks();
+    std::atomic<size_t> submitted_count{0};
+    std::atomic<bool>   stop_producers{false};
+
+    auto consumer = StartConsumer();
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < producers_count; p++)
+    {
+        producers.emplace_back([&, p]() {
+            size_t count = 0;
+            while (!stop_producers.load(std::memory_order_relaxed))
+            {
+                const auto block_id = blocks_ids[(p + count) % blocks_ids.size()];
+                requested_generation[block_id]++;
+                (void) MEEM_InitiateBlockWrite(block_id);
+                count++;
+            }
+            submitted_count += count;
+        });
+    }
+
+    std::this_thread::sleep_for(duration);
+    stop_producers = true;
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    StopConsumer(consumer);
+
+    const auto per_second = static_cast<double>(submitted_count.load()) * 1000.0 / static_cast<double>(duration.count());
+    RecordProperty("RequestsPerSecond", std::to_string(static_cast<size_t>(per_second)));
+
+    EXPECT_GT(submitted_count.load(), 0u);
+    EXPECT_FALSE(MEEM_IsBusy());
+}
@@ -0,0 +1,98 @@
+#include "test_base.hpp"
+#include "MEEM_GenInterface.hpp"
+
+using BasicBlock   = meem::blocks::Block_Basic_0;
+using ProfileBlock = meem::blocks::Block_MultiProfile_1;
+
+/// @brief Sum of the data sizes of all cached blocks, evaluated at compile time
+template <size_t... I>
+constexpr size_t CachedDataSize(std::index_sequence<I...>)
+{
+    return ((meem::descriptors[I].cached ? meem::descriptors[I].data_size : 0u) + ...);
+}
+
+class CppInterfaceTest : public TestBase
+{
+  public:
+    void SetUp() override
+    {
+        TestBase::SetUp();
+        eep_sim->erase();
+        ReInit();
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    void ReInit()
+    {
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+};
+
+TEST_F(CppInterfaceTest, DescriptorsMatchBlockConfiguration)
+{
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        const auto& descriptor = meem::descriptors[i];
+
+        EXPECT_EQ(descriptor.id, i);
+        EXPECT_EQ(descriptor.offset_in_eeprom, MEEM_block_config[i].offset_in_eeprom) << descriptor.name;
+        EXPECT_EQ(descriptor.data_size, MEEM_block_config[i].data_size) << descriptor.name;
+        EXPECT_EQ(descriptor.instance_count, MEEM_InstanceCount(&MEEM_block_config[i])) << descriptor.name;
+        EXPECT_EQ(descriptor.cached, MEEM_block_config[i].cache != nullptr) << descriptor.name;
+    }
+}
+
+TEST_F(CppInterfaceTest, DescriptorsAreConstantExpressions)
+{
+    static_assert(BasicBlock::descriptor.management_type == meem::management::basic);
+    static_assert(ProfileBlock::descriptor.management_type == meem::management::multi_profile);
+    static_assert(sizeof(BasicBlock::params_type) == BasicBlock::descriptor.data_size);
+
+    constexpr size_t cached_data_size = CachedDataSize(std::make_index_sequence<MEEM_BLOCK_COUNT>{});
+    size_t           expected         = 0;
+
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        expected += (MEEM_block_config[i].cache != nullptr) ? MEEM_block_config[i].data_size : 0u;
+    }
+    EXPECT_EQ(cached_data_size, expected);
+}
+
+TEST_F(CppInterfaceTest, TypedAccessorsUseTheCache)
+{
+    using array_param  = meem::params::Block_Basic_0::param;
+    using scalar_param = meem::params::Block_MultiProfile_1::param;
+
+    static_assert(std::is_same_v<scalar_param::value_type, uint16_t>);
+    static_assert(array_param::multiplicity == 11u);
+
+    BasicBlock::set<array_param>(0x5Au, 3u);
+    ProfileBlock::set<scalar_param>(0x1234u);
+
+    EXPECT_EQ(MEEM_Get_Block_Basic_0_param(3u), 0x5Au);
+    EXPECT_EQ(BasicBlock::get<array_param>(3u), 0x5Au);
+    EXPECT_EQ(MEEM_Get_Block_MultiProfile_1_param(), 0x1234u);
+    EXPECT_EQ(ProfileBlock::get<scalar_param>(), 0x1234u);
+}
+
+TEST_F(CppInterfaceTest, WrittenBlockSurvivesReinit)
+{
+    using param = meem::params::Block_Basic_0::param;
+
+    BasicBlock::set<param>(0xA5u, 10u);
+    ASSERT_TRUE(BasicBlock::write());
+    ProcessMeemUntilIdle();
+    EXPECT_TRUE(BasicBlock::status().write_complete);
+
+    ReInit();
+    EXPECT_EQ(BasicBlock::get<param>(10u), 0xA5u);
+    EXPECT_FALSE(BasicBlock::status().recovered);
+}
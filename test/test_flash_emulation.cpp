@@ -0,0 +1,195 @@
+#include "test_base.hpp"
+
+class FlashEmulationBlocksTest : public TestBase
+{
+  public:
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_FLASH_EMULATION_BLOCKS)
+        {
+            GTEST_SKIP() << "Requires 'flash emulation' blocks";
+        }
+
+        eep_sim->erase();
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    void TearDown() override
+    {
+        eep_sim->return_ok_for_next_jobs();
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+    static constexpr uint8_t block_id{MEEM_BLOCK_Block_FlashEmulation_0_ID};
+
+    /// @brief Writes random data to the block. [0] is the sequence counter, we avoid it!
+    /// @return The written data
+    std::vector<uint8_t> WriteRandomData()
+    {
+        const auto           block_cfg = &MEEM_block_config[block_id];
+        std::vector<uint8_t> random_data(block_cfg->data_size - 1);
+
+        FillWithRandomBytes(random_data);
+        std::copy(random_data.cbegin(), random_data.cend(), &block_cfg->cache[1]);
+        EXPECT_TRUE(MEEM_InitiateBlockWrite(block_id));
+        ProcessMeemUntilIdle();
+        return random_data;
+    }
+
+    std::vector<uint8_t> GetBlockData()
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+        return std::vector<uint8_t>(&block_cfg->cache[1], block_cfg->cache + block_cfg->data_size);
+    }
+
+    uint8_t GetActiveSlot()
+    {
+        return MEEM_block_status[block_id].index_of_active_instance;
+    }
+
+    /// @brief Fills the first sector, while the second one is dirty and its erase in idle time fails. It's not retried until the next write.
+    /// @return The data of the last write
+    std::vector<uint8_t> FillFirstSectorAndFailIdleErase()
+    {
+        const auto sps = MEEM_block_config[block_id].slots_per_sector;
+
+        while (GetActiveSlot() != (sps - 1u))
+        {
+            (void) WriteRandomData();
+        }
+        const auto second_sector = eep_sim->eeprom.begin() + MEEM_block_config[block_id].offset_in_eeprom + MEEM_FLASH_SECTOR_SIZE;
+        std::fill(second_sector, second_sector + MEEM_FLASH_SECTOR_SIZE, 0x00u);
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+
+        ChangeAllDataInBlock(block_id);
+        EXPECT_TRUE(MEEM_InitiateBlockWrite(block_id));
+        for (size_t t = 0; MEEM_lane_status[0].current_operation != MEEM_OPR_ERASE; t++)
+        {
+            EXPECT_LT(t, 100u) << "The idle time erase never starts";
+            MEEM_PeriodicTask();
+            DispatchCompletionEvents();
+        }
+        eep_sim->return_nok_for_next_jobs();
+        ProcessMeemUntilIdle();
+        eep_sim->return_ok_for_next_jobs();
+        EXPECT_EQ(GetActiveSlot(), sps);
+        return GetBlockData();
+    }
+
+    bool IsSectorErased(uint8_t sector)
+    {
+        const auto begin = eep_sim->eeprom.cbegin() + MEEM_block_config[block_id].offset_in_eeprom + (sector * MEEM_FLASH_SECTOR_SIZE);
+        return std::all_of(begin, begin + MEEM_FLASH_SECTOR_SIZE, [](uint8_t b) { return b == EepromSimulator::erased_state; });
+    }
+#endif
+};
+
+#if (MEEM_USING_FLASH_EMULATION_BLOCKS == true)
+TEST_F(FlashEmulationBlocksTest, InitFromMostRecentInstanceAcrossSectors)
+{
+    const auto block_cfg = &MEEM_block_config[block_id];
+
+    // Go around all sectors more than once
+    for (size_t i = 0; i < (2u * block_cfg->instance_count) + 3u; i++)
+    {
+        const auto expected_data = WriteRandomData();
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ASSERT_FALSE(MEEM_GetBlockStatus(block_id).recovered) << "after write #" << i;
+        ASSERT_EQ(GetBlockData(), expected_data) << "after write #" << i;
+    }
+}
+
+TEST_F(FlashEmulationBlocksTest, SectorIsErasedInIdleTimeAheadOfNeed)
+{
+    const auto sps = MEEM_block_config[block_id].slots_per_sector;
+
+    // Fill the first sector. The first write to the next one costs no erase.
+    while (GetActiveSlot() != sps)
+    {
+        (void) WriteRandomData();
+    }
+    EXPECT_TRUE(IsSectorErased(1u));
+    const auto erase_count = eep_sim->erase_count;
+
+    ChangeAllDataInBlock(block_id);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    do
+    {
+        MEEM_PeriodicTask();
+        DispatchCompletionEvents();
+        EXPECT_NE(MEEM_lane_status[0].write_stage, MEEM_IO_ERASING);
+    } while (MEEM_IsBusy());
+
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_failed);
+    EXPECT_EQ(eep_sim->erase_count, erase_count + 1u) << "Only the sector after it is erased, in idle time";
+    EXPECT_TRUE(IsSectorErased(2u));
+}
+
+TEST_F(FlashEmulationBlocksTest, SectorIsErasedBeforeWriteIfIdleEraseFailed)
+{
+    (void) FillFirstSectorAndFailIdleErase();
+    ChangeAllDataInBlock(block_id);
+    const auto expected_data = GetBlockData();
+    const auto erase_count   = eep_sim->erase_count;
+    bool       erased        = false;
+
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    do
+    {
+        MEEM_PeriodicTask();
+        DispatchCompletionEvents();
+        erased |= (MEEM_lane_status[0].write_stage == MEEM_IO_ERASING);
+    } while (MEEM_IsBusy());
+
+    EXPECT_TRUE(erased);
+    EXPECT_EQ(eep_sim->erase_count, erase_count + 2u) << "Before the write, then the sector after it, in idle time";
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_failed);
+
+    MEEM_DeInit();
+    MEEM_Init();
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).recovered);
+    EXPECT_EQ(GetBlockData(), expected_data);
+}
+
+TEST_F(FlashEmulationBlocksTest, FailedEraseBeforeWriteKeepsMostRecentInstance)
+{
+    const auto sps           = MEEM_block_config[block_id].slots_per_sector;
+    auto       expected_data = FillFirstSectorAndFailIdleErase();
+
+    eep_sim->return_nok_for_next_jobs();
+    ChangeAllDataInBlock(block_id);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilIdle();
+    eep_sim->return_ok_for_next_jobs();
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_failed);
+    EXPECT_EQ(GetActiveSlot(), sps) << "The same slot is tried again by the next write";
+
+    const auto changed_data = GetBlockData();
+    MEEM_DeInit();
+    MEEM_Init();
+    MEEM_Resume();
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).recovered);
+    EXPECT_EQ(GetBlockData(), expected_data);
+
+    // The next write erases the sector and succeeds
+    expected_data = WriteRandomData();
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_failed);
+    EXPECT_NE(expected_data, changed_data);
+    MEEM_DeInit();
+    MEEM_Init();
+    EXPECT_EQ(GetBlockData(), expected_data);
+}
+#endif
@@ -0,0 +1,178 @@
+#include "test_base.hpp"
+#include <algorithm>
+
+class FlushPlannerTest : public TestBase
+{
+  public:
+    std::vector<uint8_t> started_writes{};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_FLUSH_PLANNER)
+        {
+            GTEST_SKIP() << "Requires the flush planner";
+        }
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+
+        ON_CALL(user_callbacks_mock, OnBlockWriteStarted(testing::_)).WillByDefault([this](uint8_t block_id) { started_writes.push_back(block_id); });
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    void ChangeAndRequestWrite(std::initializer_list<uint8_t> block_ids)
+    {
+        for (auto block_id : block_ids)
+        {
+            ChangeAllDataInBlock(block_id);
+            ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+        }
+    }
+
+    // The time of a write of a 'basic' or 'backup-copy' block, from the pages its images touch. The layout may be reordered by the generator.
+    static uint32_t BlockWriteTime(uint8_t block_id)
+    {
+        const size_t image_size = sizeof(MEEM_checksum_t) + MEEM_block_config[block_id].data_size;
+        const size_t copies     = (MEEM_ManagementType(&MEEM_block_config[block_id]) == MEEM_MGMT_BACKUP_COPY) ? 2u : 1u;
+        uint32_t     pages      = 0;
+
+        for (size_t i = 0; i < copies; i++)
+        {
+            const size_t start = MEEM_block_config[block_id].offset_in_eeprom + (i * image_size);
+
+            pages += static_cast<uint32_t>(((start + image_size - 1u) / MEEM_EEPROM_PAGE_SIZE) - (start / MEEM_EEPROM_PAGE_SIZE) + 1u);
+        }
+        return pages * MEEM_PAGE_WRITE_TIME_US;
+    }
+};
+
+#if (MEEM_USING_FLUSH_PLANNER == true)
+TEST_F(FlushPlannerTest, EstimateCountsPagesOfPendingWrites)
+{
+    uint32_t expected_us = 0;
+
+    EXPECT_EQ(MEEM_EstimateFlushTime(), 0u);
+
+    ChangeAndRequestWrite({MEEM_BLOCK_Block_Basic_0_ID});
+    expected_us += BlockWriteTime(MEEM_BLOCK_Block_Basic_0_ID);
+    EXPECT_EQ(MEEM_EstimateFlushTime(), expected_us);
+
+    // Both copies are written
+    ChangeAndRequestWrite({MEEM_BLOCK_Block_BackupCopy_0_ID});
+    expected_us += BlockWriteTime(MEEM_BLOCK_Block_BackupCopy_0_ID);
+    EXPECT_EQ(MEEM_EstimateFlushTime(), expected_us);
+
+    // In the definition-order layout, this image crosses a page boundary
+    ChangeAndRequestWrite({MEEM_BLOCK_Block_Basic_1_ID});
+    expected_us += BlockWriteTime(MEEM_BLOCK_Block_Basic_1_ID);
+    EXPECT_EQ(MEEM_EstimateFlushTime(), expected_us);
+
+    ProcessMeemUntilIdle();
+    EXPECT_EQ(MEEM_EstimateFlushTime(), 0u);
+}
+
+TEST_F(FlushPlannerTest, CriticalBlocksAreFlushedFirstWithinBudget)
+{
+    ASSERT_GT(MEEM_block_config[MEEM_BLOCK_Block_BackupCopy_0_ID].flush_priority, MEEM_block_config[MEEM_BLOCK_Block_Basic_0_ID].flush_priority);
+    ASSERT_GT(MEEM_block_config[MEEM_BLOCK_Block_Basic_0_ID].flush_priority, MEEM_block_config[MEEM_BLOCK_Block_Basic_2_ID].flush_priority);
+
+    ChangeAndRequestWrite({MEEM_BLOCK_Block_Basic_2_ID, MEEM_BLOCK_Block_Basic_0_ID, MEEM_BLOCK_Block_BackupCopy_0_ID});
+    EXPECT_EQ(MEEM_EmergencyFlush(BlockWriteTime(MEEM_BLOCK_Block_BackupCopy_0_ID) + BlockWriteTime(MEEM_BLOCK_Block_Basic_0_ID)), 2u);
+
+    const std::vector<uint8_t> expected_order{MEEM_BLOCK_Block_BackupCopy_0_ID, MEEM_BLOCK_Block_Basic_0_ID};
+    EXPECT_EQ(started_writes, expected_order);
+    EXPECT_TRUE(MEEM_GetBlockStatus(MEEM_BLOCK_Block_BackupCopy_0_ID).write_complete);
+    EXPECT_TRUE(MEEM_GetBlockStatus(MEEM_BLOCK_Block_Basic_0_ID).write_complete);
+    EXPECT_TRUE(MEEM_GetBlockStatus(MEEM_BLOCK_Block_Basic_2_ID).write_pending) << "Doesn't fit in the budget";
+    EXPECT_FALSE(MEEM_InitiateBlockWrite(MEEM_BLOCK_Block_Basic_2_ID)) << "Must be suspended";
+}
+
+TEST_F(FlushPlannerTest, ShortestWritesGoFirstWithinTheSamePriority)
+{
+    const uint32_t       budget_us = 2u * MEEM_PAGE_WRITE_TIME_US;
+    std::vector<uint8_t> by_write_time{MEEM_BLOCK_Block_Basic_1_ID, MEEM_BLOCK_Block_Basic_2_ID, MEEM_BLOCK_Block_Basic_3_ID};
+
+    // In the definition-order layout, Block_Basic_1 crosses a page boundary, so it's left for the end. On a tie, the lower ID goes first.
+    std::stable_sort(by_write_time.begin(), by_write_time.end(), [](uint8_t a, uint8_t b) { return BlockWriteTime(a) < BlockWriteTime(b); });
+    ASSERT_LE(BlockWriteTime(by_write_time[0]) + BlockWriteTime(by_write_time[1]), budget_us);
+
+    ChangeAndRequestWrite({MEEM_BLOCK_Block_Basic_1_ID, MEEM_BLOCK_Block_Basic_2_ID, MEEM_BLOCK_Block_Basic_3_ID});
+    EXPECT_EQ(MEEM_EmergencyFlush(budget_us), 2u);
+
+    const std::vector<uint8_t> expected_order{by_write_time[0], by_write_time[1]};
+    EXPECT_EQ(started_writes, expected_order) << "Not batched, so each write is accounted separately";
+    EXPECT_TRUE(MEEM_GetBlockStatus(by_write_time[2]).write_pending);
+
+    // What's left is written, once the power comes back
+    MEEM_Resume();
+    ProcessMeemUntilIdle();
+    EXPECT_TRUE(MEEM_GetBlockStatus(by_write_time[2]).write_complete);
+}
+
+TEST_F(FlushPlannerTest, SkippedWritesAreNotCounted)
+{
+    if (!MEEM_USING_WRITE_SKIPPING)
+    {
+        GTEST_SKIP() << "Requires skipping of unchanged writes";
+    }
+
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(MEEM_BLOCK_Block_Basic_0_ID)); // Unchanged since init
+    ChangeAndRequestWrite({MEEM_BLOCK_Block_Basic_2_ID});
+
+    EXPECT_EQ(MEEM_EmergencyFlush(2u * MEEM_PAGE_WRITE_TIME_US), 1u);
+    EXPECT_TRUE(MEEM_GetBlockStatus(MEEM_BLOCK_Block_Basic_0_ID).write_skipped);
+    EXPECT_TRUE(MEEM_GetBlockStatus(MEEM_BLOCK_Block_Basic_2_ID).write_complete);
+    EXPECT_FALSE(MEEM_GetBlockStatus(MEEM_BLOCK_Block_Basic_2_ID).write_skipped);
+}
+
+TEST_F(FlushPlannerTest, WearLevelingEstimateFollowsTheNextInstance)
+{
+    const uint8_t block_id = MEEM_BLOCK_Block_WearLeveling_0_ID;
+
+    ASSERT_EQ(MEEM_BlockDevice(block_id), 0u);
+
+    // Instances cross page boundaries at different places, so each write of the round is checked against the range it really writes
+    for (size_t i = 0; i < MEEM_InstanceCount(&MEEM_block_config[block_id]); i++)
+    {
+        ChangeAndRequestWrite({block_id});
+        const uint32_t estimate_us = MEEM_EstimateFlushTime();
+
+        for (size_t t = 0; MEEM_lane.current_operation != MEEM_OPR_WRITE; t++)
+        {
+            ASSERT_LT(t, 100u) << "The write never starts";
+            MEEM_PeriodicTask();
+        }
+        const size_t start = MEEM_lane.io_request.offset_in_eeprom;
+        const size_t end   = start + MEEM_lane.io_request.size - 1u;
+        EXPECT_EQ(estimate_us, ((end / MEEM_EEPROM_PAGE_SIZE) - (start / MEEM_EEPROM_PAGE_SIZE) + 1u) * MEEM_PAGE_WRITE_TIME_US) << "Instance " << i;
+
+        ProcessMeemUntilIdle();
+    }
+}
+
+TEST_F(FlushPlannerTest, WriteInProgressIsCompletedFirst)
+{
+    ChangeAndRequestWrite({MEEM_BLOCK_Block_BackupCopy_0_ID});
+    for (size_t t = 0; MEEM_lane.current_operation != MEEM_OPR_WRITE; t++)
+    {
+        ASSERT_LT(t, 100u) << "The write never starts";
+        MEEM_PeriodicTask();
+    }
+    ChangeAndRequestWrite({MEEM_BLOCK_Block_Basic_0_ID});
+
+    // The write in progress takes the whole budget
+    EXPECT_EQ(MEEM_EmergencyFlush(BlockWriteTime(MEEM_BLOCK_Block_BackupCopy_0_ID)), 0u);
+    EXPECT_EQ(MEEM_lane.current_operation, MEEM_OPR_NONE);
+    EXPECT_TRUE(MEEM_GetBlockStatus(MEEM_BLOCK_Block_BackupCopy_0_ID).write_complete);
+    EXPECT_TRUE(MEEM_GetBlockStatus(MEEM_BLOCK_Block_Basic_0_ID).write_pending);
+}
+#endif
@@ -0,0 +1,112 @@
+#include "test_base.hpp"
+#include <cstring>
+
+class MemoryMappedBlocksTest : public TestBase
+{
+  public:
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_MEMORY_MAPPED_BLOCKS)
+        {
+            GTEST_SKIP() << "Requires 'memory-mapped' blocks";
+        }
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+#if (MEEM_USING_MEMORY_MAPPED_BLOCKS == true)
+    static constexpr uint8_t block_id{MEEM_BLOCK_Block_MemoryMapped_0_ID};
+
+    /// @brief Programs the block's image, like at production, and initializes the mEEM
+    void ProgramImageAndInit(const std::vector<uint8_t>& data)
+    {
+        const auto            block_cfg = &MEEM_block_config[block_id];
+        const MEEM_checksum_t checksum  = MEEM_CalculateChecksum(data.data(), block_cfg->data_size);
+        const auto            image     = eep_sim->eeprom.begin() + block_cfg->offset_in_eeprom;
+
+        std::copy_n(reinterpret_cast<const uint8_t*>(&checksum), sizeof(MEEM_checksum_t), image);
+        std::copy(data.cbegin(), data.cend(), image + sizeof(MEEM_checksum_t));
+        ReInit();
+    }
+
+    void ReInit()
+    {
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle(); /* Repairs of the other blocks */
+    }
+
+    const uint8_t* GetImageData()
+    {
+        return &eep_sim->eeprom[MEEM_block_config[block_id].offset_in_eeprom + sizeof(MEEM_checksum_t)];
+    }
+#endif
+};
+
+#if (MEEM_USING_MEMORY_MAPPED_BLOCKS == true)
+TEST_F(MemoryMappedBlocksTest, ValidImageIsReadInPlace)
+{
+    const auto data = GenerateRandomBytes(MEEM_block_config[block_id].data_size);
+
+    ProgramImageAndInit(data);
+
+    EXPECT_EQ(MEEM_mapped_data[block_id], GetImageData()) << "Read where it's mapped, without a copy";
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).recovered);
+}
+
+TEST_F(MemoryMappedBlocksTest, InvalidImageIsReadAsDefaults)
+{
+    ProgramImageAndInit(GenerateRandomBytes(MEEM_block_config[block_id].data_size));
+    eep_sim->eeprom[MEEM_block_config[block_id].offset_in_eeprom + sizeof(MEEM_checksum_t)] ^= 1u;
+    ReInit();
+
+    EXPECT_EQ(MEEM_mapped_data[block_id], MEEM_block_config[block_id].defaults);
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).recovered);
+    EXPECT_FALSE(MEEM_IsBusy()) << "Read-only, so never repaired";
+}
+
+TEST_F(MemoryMappedBlocksTest, GettersReadTheMappedData)
+{
+    std::vector<uint8_t> data(MEEM_block_config[block_id].data_size);
+    uint16_t             gain[3];
+
+    for (uint8_t i = 0; i < 20u; i++)
+    {
+        const uint16_t value = static_cast<uint16_t>(0x1000u + i);
+        std::memcpy(&data[i * sizeof(value)], &value, sizeof(value));
+    }
+    ProgramImageAndInit(data);
+
+    EXPECT_EQ(MEEM_Get_Block_MemoryMapped_0_gain(0u), 0x1000u);
+    EXPECT_EQ(MEEM_Get_Block_MemoryMapped_0_gain(19u), 0x1013u);
+    EXPECT_EQ(MEEM_GetRange_Block_MemoryMapped_0_gain(gain, 5u, 3u), 3u);
+    EXPECT_EQ(gain[0], 0x1005u);
+    EXPECT_EQ(gain[2], 0x1007u);
+
+    // Invalid data is read as defaults
+    eep_sim->eeprom[MEEM_block_config[block_id].offset_in_eeprom + sizeof(MEEM_checksum_t)] ^= 1u;
+    ReInit();
+    EXPECT_EQ(MEEM_Get_Block_MemoryMapped_0_gain(19u), 57u);
+}
+
+TEST_F(MemoryMappedBlocksTest, WriteRequestsAreRejected)
+{
+    const auto data = GenerateRandomBytes(MEEM_block_config[block_id].data_size);
+
+    ProgramImageAndInit(data);
+
+    EXPECT_FALSE(MEEM_InitiateBlockWrite(block_id));
+#if (MEEM_USING_WRITE_TICKETS == true)
+    EXPECT_EQ(MEEM_InitiateBlockWriteEx(block_id), MEEM_INVALID_TICKET);
+#endif
+    EXPECT_FALSE(MEEM_IsBusy());
+    EXPECT_TRUE(std::equal(data.cbegin(), data.cend(), GetImageData()));
+}
+#endif
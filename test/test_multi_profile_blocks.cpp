@@ -164,3 +164,44 @@ TEST_F(MultiProfileBlocksTest, EachProfilePersistsItsData)
         // std::cout << ToHexString(eep_sim->eeprom.data(), eep_sim->eeprom.size()) << std::endl;
     }
 }
+
+TEST_F(MultiProfileBlocksTest, ProfilesBeyondNarrowIndexRangeAreAddressable)
+{
+    std::vector<uint8_t> wide_mp_blocks_ids{};
+    for (auto block_id : FilterBlocksByManagementType(MEEM_MGMT_MULTI_PROFILE))
+    {
+        if (MEEM_block_config[block_id].instance_count > 15)
+        {
+            wide_mp_blocks_ids.push_back(block_id);
+        }
+    }
+    if (wide_mp_blocks_ids.size() == 0)
+    {
+        throw std::runtime_error("Your test configuration doesn't contain MP blocks with more than 15 profiles. But it needs at least 1!");
+    }
+
+    for (auto block_id : wide_mp_blocks_ids)
+    {
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+
+        const auto block_config            = &MEEM_block_config[block_id];
+        const auto instance_size_in_eeprom = block_config->data_size + sizeof(MEEM_checksum_t);
+        const auto last_profile            = static_cast<uint8_t>(block_config->instance_count - 1);
+
+        EXPECT_TRUE(MEEM_InitiateSwitchToProfile(block_id, last_profile));
+        ProcessMeemUntilIdle();
+        EXPECT_EQ(MEEM_GetActiveProfile(block_id), last_profile);
+
+        auto profile_data = GenerateRandomBytes(block_config->data_size);
+        std::copy(profile_data.cbegin(), profile_data.cend(), block_config->cache);
+        EXPECT_TRUE(MEEM_InitiateBlockWrite(block_id));
+        ProcessMeemUntilIdle();
+
+        // The data must land in the last instance of the block's EEPROM area
+        const auto last_instance_data = eep_sim->eeprom.begin() + block_config->offset_in_eeprom + (last_profile * instance_size_in_eeprom) + sizeof(MEEM_checksum_t);
+        EXPECT_TRUE(std::equal(profile_data.begin(), profile_data.end(), last_instance_data));
+    }
+}
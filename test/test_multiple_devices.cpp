@@ -0,0 +1,131 @@
+#include "test_base.hpp"
+
+class MultipleDevicesTest : public TestBase
+{
+  public:
+    static constexpr uint8_t primary_block_id{MEEM_BLOCK_Block_Basic_0_ID};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_MULTIPLE_DEVICES)
+        {
+            GTEST_SKIP() << "Requires multiple EEPROM devices";
+        }
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+        // The simulated drivers report the last job of the setup as busy for a while. Let them get idle, so both lanes can start at once.
+        while ((EEAIF_BUSY == eep_sim->get_status()) || (EEAIF_BUSY == ext_eep_sim->get_status()))
+        {
+        }
+#endif
+    }
+
+    void TearDown() override
+    {
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+        ext_eep_sim->return_ok_for_next_jobs();
+#endif
+        eep_sim->return_ok_for_next_jobs();
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    std::vector<uint8_t> GetBlockData(uint8_t block_id)
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+        return std::vector<uint8_t>(block_cfg->cache, block_cfg->cache + block_cfg->data_size);
+    }
+};
+
+#if (MEEM_USING_MULTIPLE_DEVICES == true)
+TEST_F(MultipleDevicesTest, BlockIsWrittenToItsOwnDevice)
+{
+    constexpr uint8_t block_id{MEEM_BLOCK_Block_External_0_ID};
+    const auto        block_cfg     = &MEEM_block_config[block_id];
+    const auto        eeprom_before = CreateEepromSnapshot();
+
+    ASSERT_EQ(MEEM_BlockDevice(block_id), MEEM_DEVICE_external_ID);
+    ChangeAllDataInBlock(block_id);
+    const auto expected_data = GetBlockData(block_id);
+
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilIdle();
+
+    EXPECT_EQ(eep_sim->eeprom, eeprom_before) << "The primary device must not be touched";
+    const auto image = ext_eep_sim->eeprom.begin() + block_cfg->offset_in_eeprom + sizeof(MEEM_checksum_t);
+    EXPECT_TRUE(std::equal(expected_data.begin(), expected_data.end(), image));
+
+    MEEM_DeInit();
+    MEEM_Init();
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).recovered);
+    EXPECT_EQ(GetBlockData(block_id), expected_data);
+}
+
+TEST_F(MultipleDevicesTest, DevicesStartTheirWritesInTheSameTick)
+{
+    constexpr uint8_t external_block_id{MEEM_BLOCK_Block_External_0_ID};
+
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(primary_block_id)).Times(1);
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(external_block_id)).Times(1);
+
+    ChangeAllDataInBlock(primary_block_id);
+    ChangeAllDataInBlock(external_block_id);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(primary_block_id));
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(external_block_id));
+    MEEM_PeriodicTask();
+
+    EXPECT_EQ(MEEM_lane_status[0].current_operation, MEEM_OPR_WRITE);
+    EXPECT_EQ(MEEM_lane_status[MEEM_DEVICE_external_ID].current_operation, MEEM_OPR_WRITE);
+    ProcessMeemUntilIdle();
+}
+
+TEST_F(MultipleDevicesTest, SlowDeviceDoesNotDelayTheOthers)
+{
+    constexpr uint8_t external_block_id{MEEM_BLOCK_Block_External_0_ID};
+
+    ChangeAllDataInBlock(external_block_id);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(external_block_id));
+    for (size_t t = 0; MEEM_lane_status[MEEM_DEVICE_external_ID].write_stage != MEEM_IO_WAITING; t++)
+    {
+        ASSERT_LT(t, 100u) << "The write never reaches the driver";
+        MEEM_PeriodicTask();
+    }
+    ext_eep_sim->postpone_status(200u);
+
+    ChangeAllDataInBlock(primary_block_id);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(primary_block_id));
+    for (size_t t = 0; !MEEM_GetBlockStatus(primary_block_id).write_complete; t++)
+    {
+        ASSERT_LT(t, 100u) << "The write to the primary device is held back";
+        MEEM_PeriodicTask();
+        DispatchCompletionEvents();
+    }
+
+    EXPECT_FALSE(MEEM_GetBlockStatus(external_block_id).write_complete);
+    EXPECT_TRUE(MEEM_IsBusy());
+    ProcessMeemUntilIdle();
+    EXPECT_TRUE(MEEM_GetBlockStatus(external_block_id).write_complete);
+}
+
+TEST_F(MultipleDevicesTest, FailureOfOneDeviceDoesNotAffectTheOthers)
+{
+    constexpr uint8_t external_block_id{MEEM_BLOCK_Block_External_0_ID};
+
+    ChangeAllDataInBlock(primary_block_id);
+    ChangeAllDataInBlock(external_block_id);
+    ext_eep_sim->return_nok_for_next_jobs();
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(primary_block_id));
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(external_block_id));
+    ProcessMeemUntilIdle();
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(external_block_id).write_failed);
+    EXPECT_FALSE(MEEM_GetBlockStatus(primary_block_id).write_failed);
+    EXPECT_TRUE(MEEM_GetBlockStatus(primary_block_id).write_complete);
+}
+#endif
@@ -0,0 +1,89 @@
+#include "test_base.hpp"
+
+class RangeAccessorsTest : public TestBase
+{
+  public:
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+};
+
+TEST_F(RangeAccessorsTest, RangeIsCopiedAtOnce)
+{
+    const std::array<uint8_t, 4> values{0x11, 0x22, 0x33, 0x44};
+    std::array<uint8_t, 4>       copy{};
+
+    EXPECT_EQ(MEEM_SetRange_Block_Basic_0_param(values.data(), 2u, values.size()), values.size());
+    for (uint8_t i = 0; i < values.size(); i++)
+    {
+        EXPECT_EQ(MEEM_Get_Block_Basic_0_param(2u + i), values[i]);
+    }
+
+    EXPECT_EQ(MEEM_GetRange_Block_Basic_0_param(copy.data(), 2u, copy.size()), copy.size());
+    EXPECT_EQ(copy, values);
+}
+
+TEST_F(RangeAccessorsTest, RangeIsBoundedByTheArray)
+{
+    const std::array<uint8_t, 5> values{0xA0, 0xA1, 0xA2, 0xA3, 0xA4};
+    std::array<uint8_t, 5>       copy{};
+    const uint8_t                before = MEEM_Get_Block_Basic_0_param(7u);
+
+    // 'param' of Block_Basic_0 has 11 elements
+    EXPECT_EQ(MEEM_SetRange_Block_Basic_0_param(values.data(), 8u, values.size()), 3u);
+    EXPECT_EQ(MEEM_Get_Block_Basic_0_param(7u), before);
+    EXPECT_EQ(MEEM_Get_Block_Basic_0_param(10u), values[2]);
+    EXPECT_EQ(MEEM_SetRange_Block_Basic_0_param(values.data(), 11u, values.size()), 0u);
+
+    EXPECT_EQ(MEEM_GetRange_Block_Basic_0_param(copy.data(), 8u, copy.size()), 3u);
+    EXPECT_TRUE(std::equal(values.begin(), values.begin() + 3, copy.begin()));
+    EXPECT_EQ(MEEM_GetRange_Block_Basic_0_param(copy.data(), 11u, copy.size()), 0u);
+}
+
+TEST_F(RangeAccessorsTest, RestoredSnapshotKeepsSequenceCounter)
+{
+    MEEM_params_Block_WearLeveling_0_t snapshot;
+    const uint8_t                      sequence_counter = MEEM_cache_Block_WearLeveling_0.do_not_use_me;
+
+    ASSERT_TRUE(MEEM_Snapshot_Block_WearLeveling_0(&snapshot));
+    for (uint8_t i = 0; i < 8u; i++)
+    {
+        MEEM_Set_Block_WearLeveling_0_param(static_cast<uint8_t>(~snapshot.param[i]), i);
+    }
+
+    snapshot.do_not_use_me = static_cast<uint8_t>(sequence_counter + 1u);
+    MEEM_Restore_Block_WearLeveling_0(&snapshot);
+
+    EXPECT_EQ(MEEM_cache_Block_WearLeveling_0.do_not_use_me, sequence_counter);
+    for (uint8_t i = 0; i < 8u; i++)
+    {
+        EXPECT_EQ(MEEM_Get_Block_WearLeveling_0_param(i), snapshot.param[i]);
+    }
+}
+
+TEST_F(RangeAccessorsTest, RestoringUnchangedDataDoesNotDirtyTheBlock)
+{
+    MEEM_params_Block_BackupCopy_1_t snapshot;
+
+    ASSERT_TRUE(MEEM_Snapshot_Block_BackupCopy_1(&snapshot));
+    MEEM_Restore_Block_BackupCopy_1(&snapshot);
+    EXPECT_FALSE(MEEM_IsBusy());
+
+    snapshot.param[0] = static_cast<uint8_t>(snapshot.param[0] + 1u);
+    MEEM_Restore_Block_BackupCopy_1(&snapshot);
+    EXPECT_TRUE(MEEM_IsBusy()); // Written after its write-behind delay
+    ProcessMeemUntilIdle();
+    EXPECT_TRUE(MEEM_GetBlockStatus(MEEM_BLOCK_Block_BackupCopy_1_ID).write_complete);
+}
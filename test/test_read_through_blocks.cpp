@@ -0,0 +1,158 @@
+#include "test_base.hpp"
+
+class ReadThroughBlocksTest : public TestBase
+{
+  public:
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_READ_THROUGH_BLOCKS)
+        {
+            GTEST_SKIP() << "Requires 'read-through' blocks";
+        }
+
+        eep_sim->erase();
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    void TearDown() override
+    {
+        eep_sim->return_ok_for_next_jobs();
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+    static constexpr uint8_t block_id{MEEM_BLOCK_Block_ReadThrough_0_ID};
+
+    uint16_t GetDataSize()
+    {
+        return MEEM_block_config[block_id].data_size;
+    }
+
+    std::vector<uint8_t> GetDefaults()
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+        std::vector<uint8_t> defaults(block_cfg->data_size);
+
+#if (MEEM_USING_RUN_LENGTH_DEFAULTS == true)
+        if (block_cfg->run_length_defaults)
+        {
+            MEEM_DecodeDefaults(block_cfg, 0, block_cfg->data_size, defaults.data());
+            return defaults;
+        }
+#endif
+        for (size_t i = 0; i < defaults.size(); i++)
+        {
+            defaults[i] = block_cfg->defaults[(block_cfg->default_pattern_length > 0u) ? (i % block_cfg->default_pattern_length) : i];
+        }
+        return defaults;
+    }
+
+    std::vector<uint8_t> ReadRange(uint16_t offset, uint16_t size)
+    {
+        std::vector<uint8_t> data(size);
+
+        EXPECT_TRUE(MEEM_InitiateRead(block_id, offset, size, data.data()));
+        ProcessMeemUntilIdle();
+        EXPECT_FALSE(MEEM_GetBlockStatus(block_id).fetch_pending);
+        return data;
+    }
+
+    void WriteRange(uint16_t offset, const std::vector<uint8_t>& data)
+    {
+        EXPECT_TRUE(MEEM_InitiateWrite(block_id, offset, static_cast<uint16_t>(data.size()), data.data()));
+        ProcessMeemUntilIdle();
+        EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+    }
+#endif
+};
+
+#if (MEEM_USING_READ_THROUGH_BLOCKS == true)
+TEST_F(ReadThroughBlocksTest, UnwrittenBlockIsReadAsDefaults)
+{
+    EXPECT_EQ(ReadRange(0, GetDataSize()), GetDefaults());
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).recovered);
+}
+
+TEST_F(ReadThroughBlocksTest, WrittenDataSurvivesReinit)
+{
+    const auto data = GenerateRandomBytes(GetDataSize());
+
+    WriteRange(0, data);
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_failed);
+
+    MEEM_DeInit();
+    MEEM_Init();
+    MEEM_Resume();
+    EXPECT_EQ(ReadRange(0, GetDataSize()), data);
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).recovered);
+}
+
+TEST_F(ReadThroughBlocksTest, PartialWriteKeepsTheRestOfItsChunks)
+{
+    const uint16_t chunk_size = MEEM_block_config[block_id].chunk_size;
+    const uint16_t offset     = chunk_size / 2u;
+    const auto     range      = GenerateRandomBytes(chunk_size + 1u); // Ends in the middle of the next chunk
+    auto           expected   = GenerateRandomBytes(GetDataSize());
+
+    WriteRange(0, expected);
+    WriteRange(offset, range);
+    std::copy(range.cbegin(), range.cend(), expected.begin() + offset);
+
+    EXPECT_EQ(ReadRange(0, GetDataSize()), expected);
+    EXPECT_EQ(ReadRange(offset, static_cast<uint16_t>(range.size())), range);
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).recovered);
+}
+
+TEST_F(ReadThroughBlocksTest, CorruptedChunkIsReadAsDefaultsAlone)
+{
+    const auto block_cfg = &MEEM_block_config[block_id];
+    auto       expected  = GenerateRandomBytes(GetDataSize());
+    const auto defaults  = GetDefaults();
+
+    WriteRange(0, expected);
+    eep_sim->eeprom[block_cfg->offset_in_eeprom + sizeof(MEEM_checksum_t) + sizeof(MEEM_checksum_t) + block_cfg->chunk_size] ^= 1u; // 2nd chunk
+    std::copy(defaults.cbegin() + block_cfg->chunk_size, defaults.cbegin() + (2u * block_cfg->chunk_size), expected.begin() + block_cfg->chunk_size);
+
+    EXPECT_EQ(ReadRange(0, GetDataSize()), expected);
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).recovered);
+}
+
+TEST_F(ReadThroughBlocksTest, AnotherRequestIsRejectedUntilCompletion)
+{
+    std::vector<uint8_t> data(GetDataSize());
+
+    ASSERT_TRUE(MEEM_InitiateRead(block_id, 0, GetDataSize(), data.data()));
+    EXPECT_FALSE(MEEM_InitiateRead(block_id, 0, 1u, data.data()));
+    EXPECT_FALSE(MEEM_InitiateWrite(block_id, 0, 1u, data.data()));
+    EXPECT_FALSE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilIdle();
+
+    ASSERT_TRUE(MEEM_InitiateWrite(block_id, 0, GetDataSize(), data.data()));
+    EXPECT_FALSE(MEEM_InitiateRead(block_id, 0, 1u, data.data()));
+    EXPECT_FALSE(MEEM_InitiateWrite(block_id, 0, 1u, data.data()));
+    ProcessMeemUntilIdle();
+    EXPECT_TRUE(MEEM_InitiateRead(block_id, 0, 1u, data.data()));
+    ProcessMeemUntilIdle();
+}
+
+TEST_F(ReadThroughBlocksTest, FailedWriteIsReported)
+{
+    const auto data = GenerateRandomBytes(GetDataSize());
+
+    eep_sim->return_nok_for_next_jobs();
+    ASSERT_TRUE(MEEM_InitiateWrite(block_id, 0, GetDataSize(), data.data()));
+    ProcessMeemUntilIdle();
+    eep_sim->return_ok_for_next_jobs();
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_failed);
+    EXPECT_TRUE(MEEM_InitiateWrite(block_id, 0, GetDataSize(), data.data())) << "The range request is released";
+    ProcessMeemUntilIdle();
+}
+#endif
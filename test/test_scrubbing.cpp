@@ -0,0 +1,138 @@
+#include "test_base.hpp"
+#include <cstring>
+
+class ScrubbingTest : public TestBase
+{
+  public:
+    /// @brief Enough idle ticks to complete several scrubbing passes with the test configuration
+    static constexpr size_t idle_ticks_count{5000u};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    void RunIdleTicks(size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            MEEM_PeriodicTask();
+        }
+    }
+
+    void WriteRandomData(uint8_t block_id)
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+        const auto first     = static_cast<size_t>(block_cfg->management_type == MEEM_MGMT_WEAR_LEVELING); // Skip the sequence counter
+        auto       rnd_data  = GenerateRandomBytes(block_cfg->data_size);
+
+        std::copy(rnd_data.cbegin() + first, rnd_data.cend(), block_cfg->cache + first);
+        EXPECT_TRUE(MEEM_InitiateBlockWrite(block_id));
+        ProcessMeemUntilIdle();
+    }
+
+    bool IsInstanceValidInEeprom(uint8_t block_id, uint8_t instance_id)
+    {
+        const auto block_cfg               = &MEEM_block_config[block_id];
+        const auto instance_size_in_eeprom = sizeof(MEEM_checksum_t) + block_cfg->data_size;
+        const auto instance                = &eep_sim->eeprom[block_cfg->offset_in_eeprom + (instance_id * instance_size_in_eeprom)];
+        MEEM_checksum_t stored_checksum;
+
+        // Don't use the work buffer - it may hold an instance, being scrubbed right now
+        std::memcpy(&stored_checksum, instance, sizeof(MEEM_checksum_t));
+        return stored_checksum == MEEM_CalculateChecksum(instance + sizeof(MEEM_checksum_t), block_cfg->data_size);
+    }
+};
+
+TEST_F(ScrubbingTest, CorruptedBackupCopyIsRepairedInIdleTime)
+{
+    for (auto block_id : FilterBlocksByManagementType(MEEM_MGMT_BACKUP_COPY))
+    {
+        WriteRandomData(block_id);
+
+        for (uint8_t instance_id = 0; instance_id < 2; instance_id++)
+        {
+            const auto status_before = MEEM_GetScrubStatus();
+
+            CorruptInstanceInEeprom(block_id, instance_id);
+            ASSERT_FALSE(IsInstanceValidInEeprom(block_id, instance_id));
+
+            RunIdleTicks(idle_ticks_count);
+
+            const auto status_after = MEEM_GetScrubStatus();
+            EXPECT_TRUE(IsInstanceValidInEeprom(block_id, instance_id));
+            EXPECT_GT(status_after.pass_count, status_before.pass_count);
+            EXPECT_EQ(status_after.errors_detected, status_before.errors_detected + 1);
+            EXPECT_EQ(status_after.repairs, status_before.repairs + 1);
+            EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_pending); // Repaired from the other copy, not from the cache
+        }
+    }
+}
+
+TEST_F(ScrubbingTest, CorruptedMostRecentWearLevelingInstanceTriggersRewrite)
+{
+    for (auto block_id : FilterBlocksByManagementType(MEEM_MGMT_WEAR_LEVELING))
+    {
+        if (MEEM_block_config[block_id].data_recovery_strategy != MEEM_RECOVER_DEFAULTS_AND_REPAIR)
+        {
+            continue;
+        }
+
+        WriteRandomData(block_id);
+        std::vector<uint8_t> expected_data(MEEM_block_config[block_id].cache, MEEM_block_config[block_id].cache + MEEM_block_config[block_id].data_size);
+
+        const auto instance_count    = MEEM_block_config[block_id].instance_count;
+        const auto most_recent_index = (MEEM_block_status[block_id].index_of_active_instance + instance_count - 1) % instance_count;
+        const auto repairs_before    = MEEM_GetScrubStatus().repairs;
+
+        CorruptInstanceInEeprom(block_id, static_cast<uint8_t>(most_recent_index));
+        RunIdleTicks(idle_ticks_count);
+        ProcessMeemUntilIdle();
+
+        EXPECT_GT(MEEM_GetScrubStatus().repairs, repairs_before);
+        EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+
+        // The cache is written again, so the block must be initialized from it
+        MEEM_DeInit();
+        MEEM_Init();
+        EXPECT_FALSE(MEEM_GetBlockStatus(block_id).recovered);
+        EXPECT_TRUE(std::equal(expected_data.begin() + 1, expected_data.end(), MEEM_block_config[block_id].cache + 1));
+        MEEM_Resume();
+    }
+}
+
+TEST_F(ScrubbingTest, NoScrubbingWhileSuspended)
+{
+    MEEM_Suspend();
+    RunIdleTicks(idle_ticks_count);
+
+    EXPECT_EQ(MEEM_GetScrubStatus().instances_checked, 0u);
+}
+
+TEST_F(ScrubbingTest, PendingRequestsTakePrecedence)
+{
+    const auto block_id = FilterBlocksByManagementType(MEEM_MGMT_BASIC).at(0);
+
+    RunIdleTicks(idle_ticks_count);
+    auto eeprom_before_write = CreateEepromSnapshot();
+
+    ChangeAllDataInBlock(block_id);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+
+    // The request is served within the duration of one in-flight transaction, regardless of the scrubbing
+    RunIdleTicks(10u);
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+    EXPECT_TRUE(IsOwnAreaWrittenOnly(block_id, eeprom_before_write));
+}
@@ -0,0 +1,138 @@
+#include "test_base.hpp"
+#include <atomic>
+#include <thread>
+
+class SeqlockTest : public TestBase
+{
+  public:
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_SEQLOCK)
+        {
+            GTEST_SKIP() << "Requires seqlock reads";
+        }
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+};
+
+#if (MEEM_USING_SEQLOCK == true)
+TEST_F(SeqlockTest, SetterEnclosesStoreInSequenceUpdate)
+{
+    const auto sequence_before = MEEM_block_sequence[MEEM_BLOCK_Block_Basic_0_ID];
+
+    MEEM_Set_Block_Basic_0_param(0x5A, 3);
+
+    EXPECT_EQ(static_cast<uint8_t>(MEEM_block_sequence[MEEM_BLOCK_Block_Basic_0_ID] - sequence_before), 2u);
+
+    uint8_t                     value;
+    MEEM_params_Block_Basic_0_t snapshot;
+    ASSERT_TRUE(MEEM_Read_Block_Basic_0_param(&value, 3));
+    ASSERT_TRUE(MEEM_Read_Block_Basic_0(&snapshot));
+    EXPECT_EQ(value, 0x5A);
+    EXPECT_EQ(snapshot.param[3], 0x5A);
+}
+
+TEST_F(SeqlockTest, ReadFailsWhileUpdateIsInProgress)
+{
+    const uint8_t               block_id = MEEM_BLOCK_Block_Basic_0_ID;
+    MEEM_params_Block_Basic_0_t snapshot;
+
+    MEEM_BeginCacheUpdate(block_id);
+    EXPECT_FALSE(MEEM_Read_Block_Basic_0(&snapshot));
+    MEEM_EndCacheUpdate(block_id);
+
+    EXPECT_TRUE(MEEM_Read_Block_Basic_0(&snapshot));
+}
+
+TEST_F(SeqlockTest, ReadWaitsBetweenAttemptsAndGivesUpAfterTheLast)
+{
+    if (0u == MEEM_SEQLOCK_READ_ATTEMPTS)
+    {
+        GTEST_SKIP() << "Requires limited read attempts";
+    }
+
+    const uint8_t block_id = MEEM_BLOCK_Block_Basic_0_ID;
+    uint8_t       value;
+
+    EXPECT_CALL(user_callbacks_mock, SeqlockWait()).Times(MEEM_SEQLOCK_READ_ATTEMPTS);
+    MEEM_BeginCacheUpdate(block_id);
+    EXPECT_FALSE(MEEM_Read_Block_Basic_0_param(&value, 0));
+    MEEM_EndCacheUpdate(block_id);
+}
+
+TEST_F(SeqlockTest, ReadSucceedsOnceTheUpdateCompletesWhileWaiting)
+{
+    if ((0u != MEEM_SEQLOCK_READ_ATTEMPTS) && (MEEM_SEQLOCK_READ_ATTEMPTS < 3u))
+    {
+        GTEST_SKIP() << "Requires at least 3 read attempts";
+    }
+
+    const uint8_t block_id = MEEM_BLOCK_Block_Basic_0_ID;
+    uint8_t       value;
+
+    // The writer, e.g. on another core, completes its update while the reader waits for the second time
+    EXPECT_CALL(user_callbacks_mock, SeqlockWait())
+        .WillOnce(testing::Return())
+        .WillOnce([&]() {
+            MEEM_cache_Block_Basic_0.param[4] = 0xC3;
+            MEEM_EndCacheUpdate(block_id);
+        });
+    MEEM_BeginCacheUpdate(block_id);
+    ASSERT_TRUE(MEEM_Read_Block_Basic_0_param(&value, 4));
+    EXPECT_EQ(value, 0xC3);
+}
+
+TEST_F(SeqlockTest, SnapshotIsNeverTornByConcurrentWriter)
+{
+    const uint8_t     block_id  = MEEM_BLOCK_Block_Basic_0_ID;
+    const auto        block_cfg = &MEEM_block_config[block_id];
+    std::atomic<bool> stop_writer{false};
+    size_t            consistent_reads = 0;
+
+    // Each update fills the whole block with the same byte, so a torn read is easy to detect
+    std::thread writer([&]() {
+        uint8_t fill = 0;
+        while (!stop_writer.load(std::memory_order_relaxed))
+        {
+            fill++;
+            MEEM_BeginCacheUpdate(block_id);
+            for (uint16_t i = 0; i < block_cfg->data_size; i++)
+            {
+                reinterpret_cast<volatile uint8_t*>(block_cfg->cache)[i] = fill;
+            }
+            MEEM_EndCacheUpdate(block_id);
+
+            // Real writers update the cache occasionally - give the reader a chance between updates
+            std::this_thread::yield();
+        }
+    });
+
+    for (size_t r = 0; r < 200000u; r++)
+    {
+        MEEM_params_Block_Basic_0_t snapshot;
+        if (MEEM_Read_Block_Basic_0(&snapshot))
+        {
+            consistent_reads++;
+            const auto bytes = reinterpret_cast<const uint8_t*>(&snapshot);
+            ASSERT_TRUE(std::all_of(bytes, bytes + sizeof(snapshot), [&](uint8_t b) { return b == bytes[0]; })) << "Torn read #" << r;
+        }
+    }
+
+    stop_writer = true;
+    writer.join();
+
+    EXPECT_GT(consistent_reads, 0u);
+}
+#endif
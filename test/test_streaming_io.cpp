@@ -0,0 +1,220 @@
+#include "test_base.hpp"
+
+class StreamingIoTest : public TestBase
+{
+  public:
+    static constexpr uint8_t basic_block_id{MEEM_BLOCK_Block_Basic_0_ID};
+    static constexpr uint8_t mp_block_id{MEEM_BLOCK_Block_MultiProfile_0_ID};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_STREAMING_IO)
+        {
+            GTEST_SKIP() << "Requires streaming I/O";
+        }
+
+        eep_sim->erase();
+        ReInit();
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    void ReInit()
+    {
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    /// @return The block's data, as it's in the cache now
+    std::vector<uint8_t> GetCache(uint8_t block_id)
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+        return std::vector<uint8_t>(block_cfg->cache, block_cfg->cache + block_cfg->data_size);
+    }
+
+    /// @brief Fills the cache with data, which differs from the defaults, and writes it to the active instance
+    std::vector<uint8_t> WriteRandomData(uint8_t block_id)
+    {
+        const auto           block_cfg = &MEEM_block_config[block_id];
+        std::vector<uint8_t> data(block_cfg->data_size);
+
+        FillWithRandomBytes(data);
+        MEEM_BeginCacheUpdate(block_id);
+        std::copy(data.cbegin(), data.cend(), block_cfg->cache);
+        MEEM_EndCacheUpdate(block_id);
+        EXPECT_TRUE(MEEM_InitiateBlockWrite(block_id));
+        ProcessMeemUntilIdle();
+        return data;
+    }
+
+    /// @brief Flips the last data byte of a 'multi-profile' block's profile, which is read in the last chunk
+    void CorruptLastChunkOfProfile(uint8_t profile_id)
+    {
+        const auto block_cfg     = &MEEM_block_config[mp_block_id];
+        const auto instance_size = sizeof(MEEM_checksum_t) + block_cfg->data_size;
+
+        eep_sim->eeprom[block_cfg->offset_in_eeprom + (profile_id * instance_size) + instance_size - 1u] ^= 0x5Au;
+    }
+
+#if (MEEM_USING_SEQLOCK == true)
+    /// @brief Runs a profile switch task by task. Whenever a reader can take the cache, it must hold one of the expected images.
+    /// @return Count of the tasks, in which the cache update was in progress
+    size_t SwitchProfileObservingReaders(uint8_t profile_id, const std::vector<uint8_t>& before, const std::vector<uint8_t>& after)
+    {
+        MEEM_params_Block_MultiProfile_0_t snapshot;
+        size_t                             updating_tasks = 0;
+
+        EXPECT_TRUE(MEEM_InitiateSwitchToProfile(mp_block_id, profile_id));
+        do
+        {
+            MEEM_PeriodicTask();
+            DispatchCompletionEvents();
+
+            if ((MEEM_block_sequence[mp_block_id] & 1u) != 0u)
+            {
+                updating_tasks++;
+                EXPECT_FALSE(MEEM_Read_Block_MultiProfile_0(&snapshot));
+                continue;
+            }
+
+            EXPECT_TRUE(MEEM_Read_Block_MultiProfile_0(&snapshot));
+            const std::vector<uint8_t> taken(snapshot.param, snapshot.param + sizeof(snapshot.param));
+            EXPECT_TRUE((taken == before) || (taken == after)) << ToHexString(taken.data(), taken.size());
+        } while (MEEM_IsBusy() || !MEEM_IsMultiProfileBlockReady(mp_block_id));
+
+        return updating_tasks;
+    }
+#endif
+};
+
+TEST_F(StreamingIoTest, MultiChunkImageIsReadBack)
+{
+    ASSERT_GT(sizeof(MEEM_checksum_t) + MEEM_block_config[basic_block_id].data_size, MEEM_WORKBUFFER_SIZE);
+
+    const auto data = WriteRandomData(basic_block_id);
+    std::fill(MEEM_block_config[basic_block_id].cache, MEEM_block_config[basic_block_id].cache + data.size(), 0u);
+
+    ReInit();
+    EXPECT_FALSE(MEEM_GetBlockStatus(basic_block_id).recovered);
+    EXPECT_EQ(GetCache(basic_block_id), data);
+}
+
+TEST_F(StreamingIoTest, ChecksumFailureInTheLastChunkLoadsDefaults)
+{
+    const auto block_cfg = &MEEM_block_config[basic_block_id];
+    const auto defaults  = GetCache(basic_block_id); // The EEPROM is erased, so the block is recovered
+
+    WriteRandomData(basic_block_id);
+    eep_sim->eeprom[block_cfg->offset_in_eeprom + sizeof(MEEM_checksum_t) + block_cfg->data_size - 1u] ^= 0x5Au;
+
+    ReInit();
+    EXPECT_TRUE(MEEM_GetBlockStatus(basic_block_id).recovered);
+    EXPECT_EQ(GetCache(basic_block_id), defaults);
+#if (MEEM_USING_SEQLOCK == true)
+    EXPECT_EQ(MEEM_block_sequence[basic_block_id] & 1u, 0u);
+#endif
+}
+
+TEST_F(StreamingIoTest, ProfileSwitchStreamsEachProfile)
+{
+    ASSERT_GT(sizeof(MEEM_checksum_t) + MEEM_block_config[mp_block_id].data_size, MEEM_WORKBUFFER_SIZE);
+
+    std::vector<std::vector<uint8_t>> profiles;
+    for (uint8_t profile_id = 0; profile_id < 3u; profile_id++)
+    {
+        if (profile_id != MEEM_GetActiveProfile(mp_block_id))
+        {
+            ASSERT_TRUE(MEEM_InitiateSwitchToProfile(mp_block_id, profile_id));
+            ProcessMeemUntilIdle();
+        }
+        profiles.push_back(WriteRandomData(mp_block_id));
+    }
+
+    for (uint8_t profile_id : {1u, 0u, 2u})
+    {
+        ASSERT_TRUE(MEEM_InitiateSwitchToProfile(mp_block_id, profile_id));
+        ProcessMeemUntilIdle();
+        EXPECT_TRUE(MEEM_IsMultiProfileBlockReady(mp_block_id));
+        EXPECT_FALSE(MEEM_GetBlockStatus(mp_block_id).recovered);
+        EXPECT_EQ(GetCache(mp_block_id), profiles[profile_id]);
+    }
+}
+
+TEST_F(StreamingIoTest, ProfileIsHiddenFromReadersUntilValidated)
+{
+    if (!MEEM_USING_SEQLOCK)
+    {
+        GTEST_SKIP() << "Requires seqlock reads";
+    }
+
+#if (MEEM_USING_SEQLOCK == true)
+    const auto first = WriteRandomData(mp_block_id);
+    ASSERT_TRUE(MEEM_InitiateSwitchToProfile(mp_block_id, 1u));
+    ProcessMeemUntilIdle();
+    const auto second = WriteRandomData(mp_block_id);
+
+    // Readers keep the first profile's data, until the whole second one is fetched and validated, and vice versa
+    EXPECT_GT(SwitchProfileObservingReaders(0u, second, first), 1u);
+    EXPECT_EQ(GetCache(mp_block_id), first);
+    EXPECT_GT(SwitchProfileObservingReaders(1u, first, second), 1u);
+    EXPECT_EQ(GetCache(mp_block_id), second);
+#endif
+}
+
+TEST_F(StreamingIoTest, ChecksumFailureMidStreamIsHiddenFromReaders)
+{
+    if (!MEEM_USING_SEQLOCK)
+    {
+        GTEST_SKIP() << "Requires seqlock reads";
+    }
+
+#if (MEEM_USING_SEQLOCK == true)
+    const auto defaults = GetCache(mp_block_id); // The EEPROM is erased, so the profile is recovered
+    const auto first    = WriteRandomData(mp_block_id);
+    ASSERT_TRUE(MEEM_InitiateSwitchToProfile(mp_block_id, 1u));
+    ProcessMeemUntilIdle();
+    WriteRandomData(mp_block_id);
+    CorruptLastChunkOfProfile(1u);
+
+    // The invalid chunks, already in the cache, are replaced by the defaults within the same update
+    ASSERT_TRUE(MEEM_InitiateSwitchToProfile(mp_block_id, 0u));
+    ProcessMeemUntilIdle();
+    EXPECT_GT(SwitchProfileObservingReaders(1u, first, defaults), 1u);
+    EXPECT_TRUE(MEEM_GetBlockStatus(mp_block_id).recovered);
+    EXPECT_EQ(GetCache(mp_block_id), defaults);
+    EXPECT_EQ(MEEM_block_sequence[mp_block_id] & 1u, 0u);
+#endif
+}
+
+TEST_F(StreamingIoTest, UnchangedMultiChunkDataIsNotWrittenAgain)
+{
+    if (!MEEM_USING_WRITE_SKIPPING)
+    {
+        GTEST_SKIP() << "Requires skipping of unchanged writes";
+    }
+
+    const auto block_cfg = &MEEM_block_config[basic_block_id];
+    WriteRandomData(basic_block_id);
+
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(basic_block_id));
+    ProcessMeemUntilIdle();
+    EXPECT_TRUE(MEEM_GetBlockStatus(basic_block_id).write_skipped);
+
+    // A change in the last chunk is fingerprinted too
+    MEEM_BeginCacheUpdate(basic_block_id);
+    block_cfg->cache[block_cfg->data_size - 1u] ^= 0x5Au;
+    MEEM_EndCacheUpdate(basic_block_id);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(basic_block_id));
+    ProcessMeemUntilIdle();
+    EXPECT_FALSE(MEEM_GetBlockStatus(basic_block_id).write_skipped);
+    EXPECT_EQ(eep_sim->eeprom[block_cfg->offset_in_eeprom + sizeof(MEEM_checksum_t) + block_cfg->data_size - 1u],
+              block_cfg->cache[block_cfg->data_size - 1u]);
+}
@@ -0,0 +1,198 @@
+#include "test_base.hpp"
+
+class TransactionTest : public TestBase
+{
+  public:
+    std::vector<uint8_t> transactional_blocks{};
+    std::vector<uint8_t> started_writes{};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_TRANSACTIONS)
+        {
+            GTEST_SKIP() << "Requires transactional blocks";
+        }
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+
+#if (MEEM_USING_TRANSACTIONS == true)
+        for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+        {
+            if (MEEM_block_config[i].journal_offset != 0)
+            {
+                transactional_blocks.push_back(i);
+            }
+        }
+#endif
+        ON_CALL(user_callbacks_mock, OnBlockWriteStarted(testing::_)).WillByDefault([this](uint8_t block_id) { started_writes.push_back(block_id); });
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    /// @brief Changes the data of all transactional blocks and commits them in a transaction
+    /// @return Expected data of each block after the commit
+    std::vector<std::vector<uint8_t>> CommitChangedBlocks()
+    {
+        std::vector<std::vector<uint8_t>> expected_data{};
+
+        EXPECT_TRUE(MEEM_BeginTransaction());
+        for (auto block_id : transactional_blocks)
+        {
+            ChangeAllDataInBlock(block_id);
+            EXPECT_TRUE(MEEM_AddToTransaction(block_id));
+            expected_data.push_back(GetBlockData(block_id));
+        }
+        EXPECT_TRUE(MEEM_CommitTransaction());
+        return expected_data;
+    }
+
+    /// @brief Block's data without the sequence counter of 'wear-leveling' blocks
+    std::vector<uint8_t> GetBlockData(uint8_t block_id)
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+        const auto first     = static_cast<size_t>(block_cfg->management_type == MEEM_MGMT_WEAR_LEVELING);
+
+        return std::vector<uint8_t>(block_cfg->cache + first, block_cfg->cache + block_cfg->data_size);
+    }
+
+    void RunUntilStage(MEEM_transactionStage_t stage, uint8_t block_id = UINT8_MAX)
+    {
+        for (size_t t = 0; (MEEM_global_status.transaction.stage != stage) || ((block_id != UINT8_MAX) && (MEEM_global_status.transaction.block_id != block_id)); t++)
+        {
+            ASSERT_LT(t, 1000u) << "The stage is never reached";
+            MEEM_PeriodicTask();
+        }
+    }
+
+    void CutPowerAndRestart()
+    {
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+    }
+};
+
+#if (MEEM_USING_TRANSACTIONS == true)
+TEST_F(TransactionTest, OnlyTransactionalBlocksCanBeAdded)
+{
+    EXPECT_FALSE(MEEM_AddToTransaction(transactional_blocks.at(0))); // Not open yet
+
+    ASSERT_TRUE(MEEM_BeginTransaction());
+    EXPECT_FALSE(MEEM_BeginTransaction());
+
+    for (uint8_t i = 0; i < MEEM_BLOCK_COUNT; i++)
+    {
+        EXPECT_EQ(MEEM_AddToTransaction(i), MEEM_block_config[i].journal_offset != 0) << "Block #" << static_cast<int>(i);
+    }
+}
+
+TEST_F(TransactionTest, EmptyTransactionIsDiscarded)
+{
+    ASSERT_TRUE(MEEM_BeginTransaction());
+    EXPECT_FALSE(MEEM_CommitTransaction());
+    EXPECT_FALSE(MEEM_IsBusy());
+    EXPECT_TRUE(MEEM_BeginTransaction());
+}
+
+TEST_F(TransactionTest, BlocksAreWrittenBackToBackAheadOfOtherRequests)
+{
+    const auto other_block_id = FilterBlocksByManagementType(MEEM_MGMT_BACKUP_COPY).back();
+    ASSERT_EQ(MEEM_block_config[other_block_id].journal_offset, 0u);
+
+    ChangeAllDataInBlock(other_block_id);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(other_block_id));
+    const auto expected_data = CommitChangedBlocks();
+    ProcessMeemUntilIdle();
+
+    auto expected_order = transactional_blocks;
+    expected_order.push_back(other_block_id);
+    EXPECT_EQ(started_writes, expected_order);
+
+    for (auto block_id : transactional_blocks)
+    {
+        EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+        EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_failed);
+    }
+
+    // The blocks' own areas must hold the new data, and the closed record must not be replayed
+    MEEM_DeInit();
+    MEEM_Init();
+    EXPECT_EQ(MEEM_global_status.transaction.stage, MEEM_TX_IDLE);
+    for (size_t b = 0; b < transactional_blocks.size(); b++)
+    {
+        EXPECT_FALSE(MEEM_GetBlockStatus(transactional_blocks[b]).recovered);
+        EXPECT_EQ(GetBlockData(transactional_blocks[b]), expected_data[b]);
+    }
+}
+
+TEST_F(TransactionTest, PowerLossBeforeCommitRecordKeepsOldDataOfAllBlocks)
+{
+    std::vector<std::vector<uint8_t>> old_data{};
+    for (auto block_id : transactional_blocks)
+    {
+        old_data.push_back(GetBlockData(block_id));
+    }
+
+    (void) CommitChangedBlocks();
+    RunUntilStage(MEEM_TX_WRITE_RECORD);
+    // The simulator writes at once, so the record is already there. Tear it, as if the power was lost during the write.
+    eep_sim->eeprom[MEEM_TRANSACTION_RECORD_OFFSET + sizeof(MEEM_checksum_t)] = MEEM_TRANSACTION_CLOSED;
+    CutPowerAndRestart();
+
+    EXPECT_EQ(MEEM_global_status.transaction.stage, MEEM_TX_IDLE);
+    for (size_t b = 0; b < transactional_blocks.size(); b++)
+    {
+        EXPECT_EQ(GetBlockData(transactional_blocks[b]), old_data[b]);
+    }
+}
+
+TEST_F(TransactionTest, PowerLossAfterCommitRecordCompletesTransactionAtInit)
+{
+    const auto expected_data = CommitChangedBlocks();
+
+    RunUntilStage(MEEM_TX_FETCH_SLOT); // Nothing is applied yet
+    CutPowerAndRestart();
+    for (size_t b = 0; b < transactional_blocks.size(); b++)
+    {
+        EXPECT_EQ(GetBlockData(transactional_blocks[b]), expected_data[b]) << "Not replayed from the journal";
+    }
+
+    EXPECT_TRUE(MEEM_IsBusy());
+    ProcessMeemUntilIdle();
+
+    MEEM_DeInit();
+    MEEM_Init();
+    EXPECT_EQ(MEEM_global_status.transaction.stage, MEEM_TX_IDLE);
+    for (size_t b = 0; b < transactional_blocks.size(); b++)
+    {
+        EXPECT_EQ(GetBlockData(transactional_blocks[b]), expected_data[b]) << "Not applied";
+    }
+}
+
+TEST_F(TransactionTest, BlockTornByPowerLossIsRestoredFromJournal)
+{
+    const auto expected_data = CommitChangedBlocks();
+    const auto torn_block_id = FilterBlocksByManagementType(MEEM_MGMT_BASIC).at(0);
+    ASSERT_NE(MEEM_block_config[torn_block_id].journal_offset, 0u);
+
+    RunUntilStage(MEEM_TX_APPLY, torn_block_id);
+    CorruptInstanceInEeprom(torn_block_id, 0);
+    CutPowerAndRestart();
+
+    EXPECT_FALSE(MEEM_GetBlockStatus(torn_block_id).recovered);
+    for (size_t b = 0; b < transactional_blocks.size(); b++)
+    {
+        EXPECT_EQ(GetBlockData(transactional_blocks[b]), expected_data[b]);
+    }
+    ProcessMeemUntilIdle();
+}
+#endif
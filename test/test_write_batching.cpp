@@ -0,0 +1,138 @@
+#include "test_base.hpp"
+#include <map>
+
+class WriteBatchingTest : public TestBase
+{
+  public:
+    /// @brief Adjacent 'basic' blocks, whose writes can be batched
+    std::vector<uint8_t> batchable_blocks{};
+
+    /// @brief First block of the write, during which each block's write was started
+    std::map<uint8_t, uint8_t> batch_head{};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_WRITE_BATCHING)
+        {
+            GTEST_SKIP() << "Requires write batching";
+        }
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+
+        for (auto block_id : FilterBlocksByManagementType(MEEM_MGMT_BASIC))
+        {
+            const auto previous_cfg = &MEEM_block_config[std::max(block_id, uint8_t{1}) - 1];
+            if ((block_id > 0) && (previous_cfg->management_type == MEEM_MGMT_BASIC) &&
+                (MEEM_block_config[block_id].offset_in_eeprom == previous_cfg->offset_in_eeprom + sizeof(MEEM_checksum_t) + previous_cfg->data_size))
+            {
+                if (batchable_blocks.empty())
+                {
+                    batchable_blocks.push_back(block_id - 1);
+                }
+                batchable_blocks.push_back(block_id);
+            }
+        }
+        ON_CALL(user_callbacks_mock, OnBlockWriteStarted(testing::_)).WillByDefault([this](uint8_t block_id) {
+            batch_head[block_id] = MEEM_lane.block_id;
+        });
+    }
+
+    void TearDown() override
+    {
+        eep_sim->return_ok_for_next_jobs();
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    uint16_t GetImageSize(uint8_t block_id)
+    {
+        return static_cast<uint16_t>(sizeof(MEEM_checksum_t) + MEEM_block_config[block_id].data_size);
+    }
+
+    std::vector<uint8_t> GetBlockData(uint8_t block_id)
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+        return std::vector<uint8_t>(block_cfg->cache, block_cfg->cache + block_cfg->data_size);
+    }
+};
+
+#if (MEEM_USING_WRITE_BATCHING == true)
+TEST_F(WriteBatchingTest, AdjacentBlocksAreWrittenInOneRequest)
+{
+    ASSERT_GE(batchable_blocks.size(), 3u);
+    const auto first = batchable_blocks[0];
+    ASSERT_LE(GetImageSize(first) + GetImageSize(first + 1), MEEM_WRITE_BATCH_SIZE);
+    ASSERT_GT(GetImageSize(first) + GetImageSize(first + 1) + GetImageSize(first + 2), MEEM_WRITE_BATCH_SIZE) << "The test expects two images per batch";
+
+    std::vector<std::vector<uint8_t>> expected_data{};
+    for (uint8_t b = first; b <= first + 2; b++)
+    {
+        ChangeAllDataInBlock(b);
+        expected_data.push_back(GetBlockData(b));
+    }
+
+    // Requested in reverse order - the batch still starts at the lowest address
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteComplete(testing::_)).Times(3);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(first + 2));
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(first + 1));
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(first));
+    ProcessMeemUntilIdle();
+
+    EXPECT_EQ(batch_head[first], first);
+    EXPECT_EQ(batch_head[first + 1], first) << "Not batched";
+    EXPECT_EQ(batch_head[first + 2], first + 2) << "The batch size is exceeded";
+
+    MEEM_DeInit();
+    MEEM_Init();
+    for (uint8_t b = first; b <= first + 2; b++)
+    {
+        EXPECT_FALSE(MEEM_GetBlockStatus(b).recovered);
+        EXPECT_EQ(GetBlockData(b), expected_data[b - first]) << "Block #" << static_cast<int>(b);
+    }
+}
+
+TEST_F(WriteBatchingTest, BatchStopsAtBlockWithoutPendingWrite)
+{
+    ASSERT_GE(batchable_blocks.size(), 3u);
+    const auto first         = batchable_blocks[0];
+    auto       eeprom_before = CreateEepromSnapshot();
+
+    ChangeAllDataInBlock(first);
+    ChangeAllDataInBlock(first + 2);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(first));
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(first + 2));
+    ProcessMeemUntilIdle();
+
+    EXPECT_EQ(batch_head[first], first);
+    EXPECT_EQ(batch_head[first + 2], first + 2);
+    EXPECT_EQ(batch_head.count(first + 1), 0u);
+
+    const auto offset = MEEM_block_config[first + 1].offset_in_eeprom;
+    EXPECT_TRUE(std::equal(eeprom_before.begin() + offset, eeprom_before.begin() + offset + GetImageSize(first + 1), eep_sim->eeprom.begin() + offset));
+}
+
+TEST_F(WriteBatchingTest, FailedBatchMarksAllItsBlocks)
+{
+    ASSERT_GE(batchable_blocks.size(), 2u);
+    const auto first = batchable_blocks[0];
+
+    ChangeAllDataInBlock(first);
+    ChangeAllDataInBlock(first + 1);
+    eep_sim->return_nok_for_next_jobs();
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(first));
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(first + 1));
+    ProcessMeemUntilIdle();
+
+    EXPECT_EQ(batch_head[first + 1], first);
+    for (uint8_t b = first; b <= first + 1; b++)
+    {
+        EXPECT_TRUE(MEEM_GetBlockStatus(b).write_complete);
+        EXPECT_TRUE(MEEM_GetBlockStatus(b).write_failed);
+    }
+}
+#endif
@@ -0,0 +1,85 @@
+#include "test_base.hpp"
+
+class WriteBehindTest : public TestBase
+{
+  public:
+    static constexpr uint8_t block_id{MEEM_BLOCK_Block_BackupCopy_1_ID};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    void RunTicks(size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            MEEM_PeriodicTask();
+        }
+    }
+};
+
+TEST_F(WriteBehindTest, SettingTheSameValueDoesNotDirtyTheBlock)
+{
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(testing::_)).Times(0);
+
+    MEEM_Set_Block_BackupCopy_1_param(MEEM_Get_Block_BackupCopy_1_param(0), 0);
+
+    EXPECT_FALSE(MEEM_IsBusy());
+    RunTicks(MEEM_block_config[block_id].write_behind_delay * 2u);
+}
+
+TEST_F(WriteBehindTest, ChangedBlockIsWrittenAfterItsDelay)
+{
+    const auto delay         = MEEM_block_config[block_id].write_behind_delay;
+    auto       eeprom_before = CreateEepromSnapshot();
+
+    ASSERT_GT(delay, 1u);
+    MEEM_Set_Block_BackupCopy_1_param(static_cast<uint8_t>(MEEM_Get_Block_BackupCopy_1_param(0) + 1u), 0);
+    EXPECT_TRUE(MEEM_IsBusy());
+
+    RunTicks(delay - 1u);
+    EXPECT_EQ(eep_sim->eeprom, eeprom_before);
+
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(block_id)).Times(1);
+    ProcessMeemUntilIdle();
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+    EXPECT_TRUE(IsOwnAreaWrittenOnly(block_id, eeprom_before));
+}
+
+TEST_F(WriteBehindTest, ChangesWithinTheDelayAreWrittenOnce)
+{
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(block_id)).Times(1);
+
+    for (uint8_t i = 0; i < MEEM_block_config[block_id].data_size; i++)
+    {
+        MEEM_Set_Block_BackupCopy_1_param(static_cast<uint8_t>(MEEM_Get_Block_BackupCopy_1_param(i) + 1u), i);
+        MEEM_PeriodicTask();
+    }
+    ProcessMeemUntilIdle();
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+}
+
+TEST_F(WriteBehindTest, DirtyBlockIsWrittenWhileSuspended)
+{
+    MEEM_Set_Block_BackupCopy_1_param(static_cast<uint8_t>(MEEM_Get_Block_BackupCopy_1_param(0) + 1u), 0);
+    MEEM_Suspend();
+
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(block_id)).Times(1);
+    ProcessMeemUntilIdle();
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+}
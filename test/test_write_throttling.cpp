@@ -0,0 +1,122 @@
+#include "test_base.hpp"
+
+class WriteThrottlingTest : public TestBase
+{
+  public:
+    static constexpr uint8_t block_id{MEEM_BLOCK_Block_WearLeveling_1_ID};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_WRITE_THROTTLING)
+        {
+            GTEST_SKIP() << "Requires write throttling";
+        }
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    void RunTicks(size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            MEEM_PeriodicTask();
+        }
+    }
+
+    /// @brief Ticks until the block's write is complete
+    size_t WriteAndCountTicks()
+    {
+        size_t ticks = 0;
+
+        ChangeAllDataInBlock(block_id);
+        EXPECT_TRUE(MEEM_InitiateBlockWrite(block_id));
+        do
+        {
+            MEEM_PeriodicTask();
+            ticks++;
+        } while (MEEM_IsBusy());
+
+        EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+        return ticks;
+    }
+};
+
+#if (MEEM_USING_WRITE_THROTTLING == true)
+TEST_F(WriteThrottlingTest, NextWriteWaitsForCoalescingWindow)
+{
+    const auto window = MEEM_block_config[block_id].coalescing_window;
+    const auto period = MEEM_block_config[block_id].write_budget_period;
+
+    ASSERT_GT(window, 1u);
+    RunTicks(2u * period); // Earn enough tokens, so only the window applies
+
+    const auto first_write_ticks = WriteAndCountTicks();
+    ASSERT_LT(first_write_ticks, window);
+
+    const auto second_write_ticks = WriteAndCountTicks();
+    EXPECT_GE(second_write_ticks, window - first_write_ticks);
+    EXPECT_LT(second_write_ticks, period);
+}
+
+TEST_F(WriteThrottlingTest, RequestsWithinWindowAreMergedIntoOneWrite)
+{
+    RunTicks(2u * MEEM_block_config[block_id].write_budget_period);
+    (void) WriteAndCountTicks();
+
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(block_id)).Times(1);
+
+    for (size_t r = 0; r < 3u; r++)
+    {
+        ChangeAllDataInBlock(block_id);
+        (void) MEEM_InitiateBlockWrite(block_id);
+        MEEM_PeriodicTask();
+    }
+    ProcessMeemUntilIdle();
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+}
+
+TEST_F(WriteThrottlingTest, WriteBudgetDefersWrites)
+{
+    const auto period = MEEM_block_config[block_id].write_budget_period;
+
+    ASSERT_GT(period, 2u * MEEM_block_config[block_id].coalescing_window);
+
+    // At most the token, granted at start-up, is available - the next write must wait for a new one
+    EXPECT_LT(WriteAndCountTicks(), period);
+    EXPECT_GE(WriteAndCountTicks(), period / 2u);
+}
+
+TEST_F(WriteThrottlingTest, FlushLiftsTheLimits)
+{
+    (void) WriteAndCountTicks();
+
+    ChangeAllDataInBlock(block_id);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    RunTicks(2u);
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_pending);
+
+    MEEM_Flush();
+
+    size_t ticks = 0;
+    do
+    {
+        MEEM_PeriodicTask();
+        ticks++;
+    } while (MEEM_IsBusy());
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+    EXPECT_LT(ticks, MEEM_block_config[block_id].coalescing_window);
+}
+#endif
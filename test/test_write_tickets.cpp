@@ -0,0 +1,156 @@
+#include "test_base.hpp"
+
+class WriteTicketsTest : public TestBase
+{
+  public:
+    static constexpr uint8_t block_id{MEEM_BLOCK_Block_Basic_0_ID};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_WRITE_TICKETS)
+        {
+            GTEST_SKIP() << "Requires write tickets";
+        }
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    void TearDown() override
+    {
+        eep_sim->return_ok_for_next_jobs();
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+    /// @brief Like ProcessMeemUntilIdle(), but leaves the completion events in the queue
+    void ProcessMeemUntilIdleWithoutDispatch()
+    {
+        do
+        {
+            MEEM_PeriodicTask();
+        } while (MEEM_IsBusy());
+    }
+};
+
+#if (MEEM_USING_WRITE_TICKETS == true)
+TEST_F(WriteTicketsTest, TicketIsDoneAfterItsDataIsWritten)
+{
+    ChangeAllDataInBlock(block_id);
+    const auto ticket = MEEM_InitiateBlockWriteEx(block_id);
+
+    ASSERT_NE(ticket, MEEM_INVALID_TICKET);
+    EXPECT_EQ(MEEM_GetTicketStatus(ticket), MEEM_TICKET_PENDING);
+    EXPECT_FALSE(MEEM_IsTicketDone(ticket));
+
+    EXPECT_EQ(MEEM_WaitTicket(ticket), MEEM_TICKET_DONE);
+    EXPECT_TRUE(MEEM_IsTicketDone(ticket));
+    ProcessMeemUntilIdle();
+}
+
+TEST_F(WriteTicketsTest, RequestsBeforeTheStartShareTheWrite)
+{
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteStarted(block_id)).Times(1);
+
+    ChangeAllDataInBlock(block_id);
+    const auto first_ticket = MEEM_InitiateBlockWriteEx(block_id);
+    ChangeAllDataInBlock(block_id);
+    const auto second_ticket = MEEM_InitiateBlockWriteEx(block_id);
+
+    ASSERT_NE(second_ticket, MEEM_INVALID_TICKET) << "A merged request must get a valid ticket";
+    EXPECT_NE(first_ticket, second_ticket);
+    ProcessMeemUntilIdle();
+
+    EXPECT_EQ(MEEM_GetTicketStatus(first_ticket), MEEM_TICKET_DONE);
+    EXPECT_EQ(MEEM_GetTicketStatus(second_ticket), MEEM_TICKET_DONE);
+}
+
+TEST_F(WriteTicketsTest, RequestAfterTheStartIsNotServedByTheStartedWrite)
+{
+    ChangeAllDataInBlock(block_id);
+    const auto first_ticket = MEEM_InitiateBlockWriteEx(block_id);
+
+    for (size_t t = 0; MEEM_lane.current_operation != MEEM_OPR_WRITE; t++)
+    {
+        ASSERT_LT(t, 100u) << "The write never starts";
+        MEEM_PeriodicTask();
+    }
+
+    // The cache is already copied - this change needs another write
+    ChangeAllDataInBlock(block_id);
+    const auto second_ticket = MEEM_InitiateBlockWriteEx(block_id);
+
+    EXPECT_EQ(MEEM_WaitTicket(first_ticket), MEEM_TICKET_DONE);
+    EXPECT_EQ(MEEM_GetTicketStatus(second_ticket), MEEM_TICKET_PENDING);
+
+    ProcessMeemUntilIdle();
+    EXPECT_EQ(MEEM_GetTicketStatus(second_ticket), MEEM_TICKET_DONE);
+}
+
+TEST_F(WriteTicketsTest, FailedWriteFailsItsTickets)
+{
+    ChangeAllDataInBlock(block_id);
+    eep_sim->return_nok_for_next_jobs();
+    const auto failed_ticket = MEEM_InitiateBlockWriteEx(block_id);
+    EXPECT_EQ(MEEM_WaitTicket(failed_ticket), MEEM_TICKET_FAILED);
+    ProcessMeemUntilIdle();
+
+    // A successful write of newer data serves the older tickets, too
+    eep_sim->return_ok_for_next_jobs();
+    const auto retry_ticket = MEEM_InitiateBlockWriteEx(block_id);
+    EXPECT_EQ(MEEM_WaitTicket(retry_ticket), MEEM_TICKET_DONE);
+    EXPECT_EQ(MEEM_GetTicketStatus(failed_ticket), MEEM_TICKET_DONE);
+    ProcessMeemUntilIdle();
+}
+
+TEST_F(WriteTicketsTest, RejectedRequestGetsInvalidTicket)
+{
+    MEEM_Suspend();
+
+    const auto ticket = MEEM_InitiateBlockWriteEx(block_id);
+    EXPECT_EQ(ticket, MEEM_INVALID_TICKET);
+    EXPECT_EQ(MEEM_GetTicketStatus(ticket), MEEM_TICKET_FAILED);
+    EXPECT_FALSE(MEEM_IsBusy());
+}
+#endif
+
+#if (MEEM_USING_COMPLETION_QUEUE == true)
+TEST_F(WriteTicketsTest, CompletionsAreQueuedInsteadOfCallbacks)
+{
+    std::vector<MEEM_ticket_t> tickets{};
+
+    EXPECT_CALL(user_callbacks_mock, OnBlockWriteComplete(testing::_)).Times(0);
+
+    // One write more than the queue can hold
+    for (size_t w = 0; w <= MEEM_COMPLETION_QUEUE_SIZE; w++)
+    {
+        ChangeAllDataInBlock(block_id);
+        tickets.push_back(MEEM_InitiateBlockWriteEx(block_id));
+        ProcessMeemUntilIdleWithoutDispatch();
+    }
+
+    MEEM_completionEvent_t event;
+    for (size_t e = 0; e < MEEM_COMPLETION_QUEUE_SIZE; e++)
+    {
+        ASSERT_TRUE(MEEM_GetCompletionEvent(&event));
+        EXPECT_EQ(event.block_id, block_id);
+        EXPECT_EQ(event.ticket, tickets[e]);
+        EXPECT_FALSE(event.failed);
+        EXPECT_FALSE(event.lost_before);
+    }
+    EXPECT_FALSE(MEEM_GetCompletionEvent(&event)) << "The last event must have been dropped";
+    EXPECT_EQ(MEEM_GetTicketStatus(tickets.back()), MEEM_TICKET_DONE);
+
+    ChangeAllDataInBlock(block_id);
+    tickets.push_back(MEEM_InitiateBlockWriteEx(block_id));
+    ProcessMeemUntilIdleWithoutDispatch();
+
+    ASSERT_TRUE(MEEM_GetCompletionEvent(&event));
+    EXPECT_EQ(event.ticket, tickets.back());
+    EXPECT_TRUE(event.lost_before);
+}
+#endif
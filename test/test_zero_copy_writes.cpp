@@ -0,0 +1,160 @@
+#include "test_base.hpp"
+
+class ZeroCopyWritesTest : public TestBase
+{
+  public:
+    static constexpr uint8_t block_id{MEEM_BLOCK_Block_Basic_0_ID};
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        if (!MEEM_USING_ZERO_COPY_WRITES)
+        {
+            GTEST_SKIP() << "Requires zero-copy writes";
+        }
+
+        MEEM_DeInit();
+        MEEM_Init();
+        MEEM_Resume();
+        ProcessMeemUntilIdle();
+    }
+
+    void TearDown() override
+    {
+        MEEM_Suspend();
+        TestBase::TearDown();
+    }
+
+#if (MEEM_USING_ZERO_COPY_WRITES == true)
+    /// @brief Updates the whole cache, like the generated setters do
+    void UpdateCache(uint8_t fill)
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+
+        MEEM_BeginCacheUpdate(block_id);
+        std::fill(block_cfg->cache, block_cfg->cache + block_cfg->data_size, fill);
+        MEEM_EndCacheUpdate(block_id);
+    }
+
+    /// @brief Runs the core until the driver accepts the write of the block's image
+    void ProcessMeemUntilWriteIsAccepted()
+    {
+        for (size_t t = 0; (MEEM_lane_status[0].current_operation != MEEM_OPR_WRITE) || (MEEM_lane_status[0].write_stage != MEEM_IO_WAITING); t++)
+        {
+            ASSERT_LT(t, 100u) << "The write never starts";
+            MEEM_PeriodicTask();
+        }
+    }
+
+    std::vector<uint8_t> GetImageInEeprom()
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+        const auto begin     = eep_sim->eeprom.cbegin() + block_cfg->offset_in_eeprom;
+        return std::vector<uint8_t>(begin, begin + sizeof(MEEM_checksum_t) + block_cfg->data_size);
+    }
+
+    std::vector<uint8_t> GetImageInCache()
+    {
+        const auto block_cfg = &MEEM_block_config[block_id];
+        return std::vector<uint8_t>(block_cfg->cache - sizeof(MEEM_checksum_t), block_cfg->cache + block_cfg->data_size);
+    }
+#endif
+};
+
+#if (MEEM_USING_ZERO_COPY_WRITES == true)
+TEST_F(ZeroCopyWritesTest, ImageIsWrittenFromTheCache)
+{
+    UpdateCache(0x3C);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilIdle();
+
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_failed);
+    EXPECT_EQ(GetImageInEeprom(), GetImageInCache()) << "The checksum precedes the cache in RAM, like in the EEPROM";
+}
+
+TEST_F(ZeroCopyWritesTest, UpdateDuringWriteRepeatsIt)
+{
+    UpdateCache(0x11);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilWriteIsAccepted();
+
+    // The driver may have taken a part of the old data only. No new write request is made.
+    UpdateCache(0x22);
+    ProcessMeemUntilIdle();
+
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_failed);
+    EXPECT_EQ(GetImageInEeprom(), GetImageInCache());
+
+    MEEM_DeInit();
+    MEEM_Init();
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).recovered);
+    EXPECT_EQ(MEEM_block_config[block_id].cache[0], 0x22);
+}
+
+TEST_F(ZeroCopyWritesTest, CacheUpdatedDuringEachAttemptFailsTheWrite)
+{
+    uint8_t fill = 0;
+
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    do
+    {
+        UpdateCache(++fill);
+        MEEM_PeriodicTask();
+        DispatchCompletionEvents();
+    } while (MEEM_IsBusy());
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_failed);
+}
+
+TEST_F(ZeroCopyWritesTest, WriteFailsAfterTheLastAttempt)
+{
+    const auto image_before = GetImageInEeprom();
+    const auto write_count  = eep_sim->write_count;
+    uint8_t    fill         = 0x40;
+
+    UpdateCache(fill);
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilWriteIsAccepted();
+    while (MEEM_IsBusy())
+    {
+        if (MEEM_lane_status[0].write_stage == MEEM_IO_WAITING)
+        {
+            UpdateCache(++fill); // While the driver writes each attempt
+        }
+        MEEM_PeriodicTask();
+        DispatchCompletionEvents();
+    }
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_failed);
+    EXPECT_EQ(eep_sim->write_count, write_count + 4u) << "A write is repeated up to 4 times in total";
+    EXPECT_NE(GetImageInEeprom(), image_before);
+}
+
+TEST_F(ZeroCopyWritesTest, FailedWriteIsNotSkippedNextTime)
+{
+    if (!MEEM_USING_WRITE_SKIPPING)
+    {
+        GTEST_SKIP() << "Requires skipping of unchanged writes";
+    }
+
+    uint8_t fill = 0;
+
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    do
+    {
+        UpdateCache(++fill);
+        MEEM_PeriodicTask();
+        DispatchCompletionEvents();
+    } while (MEEM_IsBusy());
+    ASSERT_TRUE(MEEM_GetBlockStatus(block_id).write_failed);
+
+    // The instance holds some of the attempts' data, so the last cache image must be written again
+    ASSERT_TRUE(MEEM_InitiateBlockWrite(block_id));
+    ProcessMeemUntilIdle();
+
+    EXPECT_TRUE(MEEM_GetBlockStatus(block_id).write_complete);
+    EXPECT_FALSE(MEEM_GetBlockStatus(block_id).write_skipped);
+    EXPECT_EQ(GetImageInEeprom(), GetImageInCache());
+}
+#endif
@@ -79,11 +79,30 @@ class Parameter(ProtoNode):
 class Block(ProtoNode):
     """Represents a group of related EEPROM parameters."""
 
+    MAX_NARROW_INSTANCE_COUNT = 15
+    """Instance counts up to this value fit in the core's 4-bit instance index. Larger ones enable the wide (8-bit) index."""
+
+    MAX_PROFILE_COUNT = 254
+    """Upper limit of profiles in a multi-profile block. The index 0xFF is reserved by the core as 'invalid'."""
+
+    MAX_FLASH_SECTOR_COUNT = 16
+    """Upper limit of FLASH sectors of a flash emulation block."""
+
+    MAX_FLASH_SLOT_COUNT = 127
+    """Upper limit of instances in all sectors of a flash emulation block. The sequence counters wrap around at 255,
+    so the most recent instance is unambiguous only if they are less than the half of it. The sectors are filled up to it."""
+
+    MAX_CHUNK_SIZE = 255
+    """Upper limit of the data in a chunk of a read-through block."""
+
     class ManagementTypes(IntEnum):
         Basic = 0
         BackupCopy = 1
         MultiProfile = 2
         WearLeveling = 3
+        FlashEmulation = 4
+        ReadThrough = 5
+        MemoryMapped = 6
 
     class DataRecoveryStrategies(IntEnum):
         """Defines the strategy on data integrity failure during init"""
@@ -100,6 +119,13 @@ class Block(ProtoNode):
         instance_count: int = 1,
         data_recovery_strategy: DataRecoveryStrategies = DataRecoveryStrategies.RecoverDefaultsAndRepair,
         compress_defaults: bool = True,
+        write_behind_delay_ms: int = 0,
+        write_coalescing_window_ms: int = 0,
+        max_writes_per_hour: int = 0,
+        transactional: bool = False,
+        flush_priority: int = 0,
+        device: Optional[str] = None,
+        chunk_size: int = 0,
     ):
 
         super().__init__(name=name, description=description)
@@ -110,28 +136,76 @@ class Block(ProtoNode):
 
         self.instance_count: int = instance_count
         """Count of instances in the EEPROM.
-        Basic blocks have always 1, backup copy - always 2, multi-profile and wear-leveling blocks have user-defined count in the range[2..15]
+        Basic blocks have always 1, backup copy - always 2, wear-leveling blocks have user-defined count in the range [2..15],
+        multi-profile blocks - in the range [2..254]. Multi-profile blocks with more than 15 profiles switch the core to a wider instance index.
+        For flash emulation blocks, it's the count of FLASH sectors, in the range [2..16]. Each sector holds as many instances as fit in it.
+        Read-through and memory-mapped blocks have always 1.
         """
 
         self.data_recovery_strategy: Block.DataRecoveryStrategies = data_recovery_strategy
         """Defines the behaviour during the init phase when block's checksum verification fails."""
 
         self.compress_defaults: bool = compress_defaults
-        """Allow reduction of defaults to shortest possible pattern. The reduction is not guaranteed - it depends on the content of default values."""
+        """Allow reduction of defaults to shortest possible pattern, or else to a run-length encoding.
+        The reduction is not guaranteed - it depends on the content of default values."""
+
+        self.write_behind_delay_ms: int = write_behind_delay_ms
+        """If > 0, generated setters mark the block dirty on a real change, and the core writes it automatically within this delay. 0 disables the write-behind."""
+
+        self.write_coalescing_window_ms: int = write_coalescing_window_ms
+        """Minimum time between the starts of two writes of the block. Requests within it are merged into one deferred write. 0 means no limit."""
+
+        self.max_writes_per_hour: int = max_writes_per_hour
+        """Endurance budget of the block. Writes beyond it are deferred until the budget allows them. 0 means no limit."""
+
+        self.transactional: bool = transactional
+        """If true, the block can be a part of a multi-block transaction. It gets a slot in the transaction journal. Not applicable to multi-profile blocks."""
+
+        self.flush_priority: int = flush_priority
+        """Criticality of the block in an emergency flush on power failure. Blocks with higher priority are written first. Range [0..255]."""
+
+        self.device: Optional[str] = device
+        """Name of the EEPROM device, defined in the platform settings, which stores the block. None - the primary device."""
+
+        self.chunk_size: int = chunk_size
+        """Read-through blocks only: size of the data in each chunk, which has its own checksum. Range [1..255]. The last chunk may be shorter.
+        The block has no cache - the chunks are read and written through the work buffer, one by one."""
+
+        self.device_id: Optional[int] = None
+        """Auto-calculated. Index of the block's device: 0 for the primary one, 1.. for the additional ones. Not for user data."""
 
         self.offset_in_eeprom: Optional[int] = None
         """Auto-calculated. Not for user data."""
 
+        self.journal_offset: Optional[int] = None
+        """Auto-calculated. Offset of the block's slot in the transaction journal, if transactional. Not for user data."""
+
         self.size_in_eeprom: Optional[int] = None
         """Auto-calculated. Not for user data."""
 
+        self.slots_per_sector: Optional[int] = None
+        """Auto-calculated. Count of instances in a FLASH sector of a flash emulation block, 0 for the other types. Not for user data."""
+
         self.default_pattern: Optional[bytes] = None
         """Auto-calculated. Not for user data."""
 
+        self.encoded_defaults: Optional[bytes] = None
+        """Auto-calculated. Run-length encoded defaults, if no short pattern exists, but the encoding is shorter than the data. Not for user data."""
+
+    @property
+    def has_sequence_counter(self) -> bool:
+        """Wear-leveling and flash emulation blocks keep a sequence counter in the first byte of their data."""
+        return self.management_type in (Block.ManagementTypes.WearLeveling, Block.ManagementTypes.FlashEmulation)
+
+    @property
+    def is_cached(self) -> bool:
+        """All blocks but the read-through and memory-mapped ones have a cache in RAM."""
+        return self.management_type not in (Block.ManagementTypes.ReadThrough, Block.ManagementTypes.MemoryMapped)
+
     @cached_property
     def data_size(self) -> int:
-        """Gets the aggregate size of all parameters in the block, in bytes. For wear-leveling blocks, the size is +1, because of the extra sequence counter."""
-        return sum(param.size for param in self.children) + int(self.management_type == Block.ManagementTypes.WearLeveling)
+        """Gets the aggregate size of all parameters in the block, in bytes. With a sequence counter, the size is +1."""
+        return sum(param.size for param in self.children) + int(self.has_sequence_counter)
 
 
 class DataModel(ProtoNode):
@@ -255,9 +329,13 @@ class DataModel(ProtoNode):
                 return False
             if block.management_type == Block.ManagementTypes.BackupCopy and block.instance_count != 2:
                 return False
-            if block.management_type == Block.ManagementTypes.MultiProfile and (block.instance_count < 2 or block.instance_count > 15):
+            if block.management_type == Block.ManagementTypes.MultiProfile and (block.instance_count < 2 or block.instance_count > Block.MAX_PROFILE_COUNT):
+                return False
+            if block.management_type == Block.ManagementTypes.WearLeveling and (block.instance_count < 2 or block.instance_count > Block.MAX_NARROW_INSTANCE_COUNT):
                 return False
-            if block.management_type == Block.ManagementTypes.WearLeveling and (block.instance_count < 2 or block.instance_count > 15):
+            if block.management_type == Block.ManagementTypes.FlashEmulation and (block.instance_count < 2 or block.instance_count > Block.MAX_FLASH_SECTOR_COUNT):
+                return False
+            if block.management_type in (Block.ManagementTypes.ReadThrough, Block.ManagementTypes.MemoryMapped) and block.instance_count != 1:
                 return False
             return True
 
@@ -302,6 +380,41 @@ class DataModel(ProtoNode):
             if len(block.children) == 0:
                 errors.append(f"Block '{block.name}' must contain at least 1 parameter!")
 
+            if not isinstance(block.write_behind_delay_ms, int) or block.write_behind_delay_ms < 0:
+                errors.append(f"Block '{block.name}' has invalid 'write_behind_delay_ms': {block.write_behind_delay_ms}")
+
+            if not isinstance(block.write_coalescing_window_ms, int) or block.write_coalescing_window_ms < 0:
+                errors.append(f"Block '{block.name}' has invalid 'write_coalescing_window_ms': {block.write_coalescing_window_ms}")
+
+            if not isinstance(block.max_writes_per_hour, int) or block.max_writes_per_hour < 0 or block.max_writes_per_hour > 0xFFFF:
+                errors.append(f"Block '{block.name}' has invalid 'max_writes_per_hour': {block.max_writes_per_hour}. The range is [0..65535].")
+
+            if not isinstance(block.transactional, bool):
+                errors.append(f"Block '{block.name}' has invalid 'transactional': {block.transactional}")
+            elif block.transactional and block.management_type == Block.ManagementTypes.MultiProfile:
+                errors.append(f"Block '{block.name}' is a multi-profile block, which can't be transactional!")
+            elif block.transactional and block.management_type == Block.ManagementTypes.FlashEmulation:
+                errors.append(f"Block '{block.name}' is a flash emulation block, which can't be transactional!")
+            elif block.transactional and block.management_type == Block.ManagementTypes.ReadThrough:
+                errors.append(f"Block '{block.name}' is a read-through block, which can't be transactional!")
+            elif block.transactional and block.management_type == Block.ManagementTypes.MemoryMapped:
+                errors.append(f"Block '{block.name}' is a memory-mapped block, which can't be transactional!")
+
+            if block.management_type == Block.ManagementTypes.ReadThrough:
+                if not isinstance(block.chunk_size, int) or block.chunk_size < 1 or block.chunk_size > Block.MAX_CHUNK_SIZE:
+                    errors.append(f"Block '{block.name}' has invalid 'chunk_size': {block.chunk_size}. The range is [1..{Block.MAX_CHUNK_SIZE}].")
+                if (block.write_behind_delay_ms > 0) or (block.write_coalescing_window_ms > 0) or (block.max_writes_per_hour > 0):
+                    errors.append(f"Block '{block.name}' is a read-through block, whose writes can't be deferred. Set its write-behind and throttling limits to 0.")
+
+            if block.management_type == Block.ManagementTypes.MemoryMapped:
+                if (block.write_behind_delay_ms > 0) or (block.write_coalescing_window_ms > 0) or (block.max_writes_per_hour > 0):
+                    errors.append(f"Block '{block.name}' is a memory-mapped block, which is read-only. Set its write-behind and throttling limits to 0.")
+                if block.data_recovery_strategy != Block.DataRecoveryStrategies.RecoverDefaults:
+                    errors.append(f"Block '{block.name}' is a memory-mapped block, which is read-only, so it can't be repaired. Set its 'data_recovery_strategy' to 'RecoverDefaults'.")
+
+            if not isinstance(block.flush_priority, int) or block.flush_priority < 0 or block.flush_priority > 0xFF:
+                errors.append(f"Block '{block.name}' has invalid 'flush_priority': {block.flush_priority}. The range is [0..255].")
+
             duplicate_names = get_duplicate_names(block.children)
             if len(duplicate_names) > 0:
                 errors.append(f"Block '{block.name}' contains parameters with duplicate names: {duplicate_names}")
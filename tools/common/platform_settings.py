@@ -54,6 +54,34 @@ class CompilerDirectives:
         """Block-scoped placement directives. The keys are block names as defined in the datamodel."""
 
 
+class EepromDevice:
+    """An additional EEPROM device, with its own access driver. The mEEM drives each device in a separate lane, concurrently with the others."""
+
+    def __init__(
+        self,
+        name: str = "",
+        eeaif_prefix: str = "",
+        eeprom_size: int = 256,
+        eeprom_page_size: int = 0,
+        page_write_time_us: int = 0,
+    ):
+        self.name: str = name
+        """Name of the device, referred to by the blocks in the datamodel. Has to be a valid C-language identifier."""
+
+        self.eeaif_prefix: str = eeaif_prefix
+        """Prefix of the device's access driver operations, e.g. 'SPI_EEAIF' for SPI_EEAIF_Init(), SPI_EEAIF_BeginRead() etc.
+        The operations have the signatures of the ones in MEEM_EEAIF.h."""
+
+        self.eeprom_size: int = eeprom_size
+        """Allocated EEPROM of the device to the mEEM, in bytes."""
+
+        self.eeprom_page_size: int = eeprom_page_size
+        """Size of the device's page, in bytes. Set to 0 for devices, that can write only one byte at a time."""
+
+        self.page_write_time_us: int = page_write_time_us
+        """Time to write one page (or byte) of the device, in microseconds. Used by the flush time estimation."""
+
+
 class PlatformSettings:
     """Collection of platform-specific settings."""
 
@@ -67,13 +95,36 @@ class PlatformSettings:
         enter_critical_section_operation: Optional[str] = None,
         exit_critical_section_operation: Optional[str] = None,
         compiler_directives: CompilerDirectives = CompilerDirectives(),
+        task_period_ms: int = 5,
+        scrub_bytes_per_second: int = 0,
+        lazy_backup_verification: bool = False,
+        lock_free_requests: bool = False,
+        seqlock_reads: bool = False,
+        seqlock_read_attempts: int = 4,
+        skip_unchanged_writes: bool = False,
+        write_batch_size: int = 0,
+        write_tickets: bool = False,
+        completion_queue_size: int = 0,
+        page_write_time_us: int = 0,
+        flash_sector_size: int = 0,
+        sector_erase_time_us: int = 0,
+        streaming_chunk_size: int = 0,
+        zero_copy_writes: bool = False,
+        specialized_core: bool = False,
+        aligned_caches: bool = False,
+        optimize_layout: bool = False,
+        keep_block_order: bool = False,
+        devices: List[EepromDevice] = [],
+        memory_barrier_operation: Optional[str] = None,
+        seqlock_wait_operation: Optional[str] = None,
     ):
 
         self.endianness: Literal["little", "big"] = endianness
         """Endianness of the target CPU"""
 
         self.eeprom_size: int = eeprom_size
-        """Allocated EEPROM to the mEEM, in bytes. In some cases, it might not be the whole available EEPROM."""
+        """Allocated EEPROM to the mEEM, in bytes. In some cases, it might not be the whole available EEPROM.
+        If it, or the size of any additional device, exceeds 64KiB, the EEPROM offsets and sizes become 32-bit."""
 
         self.eeprom_page_size: int = eeprom_page_size
         """Size of the EEPROM's page, in bytes.
@@ -81,11 +132,11 @@ class PlatformSettings:
 
         self.page_aligned_blocks: List[str] = page_aligned_blocks
         """List of block names, which you want aligned to EEPROM page boundaries. The names must be present in the datamodel.
-        If not specified, defaults to ['*'] (align all blocks).
-        Makes sense only if eeprom_page_size > 0."""
+        If not specified, defaults to ['*'] (align all blocks). With 'optimize_layout', '*' forces no block to a page boundary, and only
+        the blocks, listed by name, are aligned in any case. Makes sense only if eeprom_page_size > 0."""
 
         self.external_headers: List[str] = external_headers
-        """External header files, containing forward declarations for 'enter_critical_section_operation' and 'exit_critical_section_operation'."""
+        """External header files, containing forward declarations for 'enter_critical_section_operation', 'exit_critical_section_operation' and the other operations."""
 
         self.enter_critical_section_operation: Optional[str] = enter_critical_section_operation
         """Function/macro for designating the start of an atomic code fragment in the mEEM."""
@@ -96,6 +147,90 @@ class PlatformSettings:
         self.compiler_directives: CompilerDirectives = compiler_directives
         """Global directives for packing and block-scoped directives for placement."""
 
+        self.task_period_ms: int = task_period_ms
+        """Call period of MEEM_PeriodicTask(), in milliseconds. The core uses it as its only time base."""
+
+        self.scrub_bytes_per_second: int = scrub_bytes_per_second
+        """Read budget of the background scrubber, in bytes per second. The scrubber re-validates 'backup copy' and 'wear-leveling' instances in idle time.
+        Set to 0 to disable background scrubbing."""
+
+        self.lazy_backup_verification: bool = lazy_backup_verification
+        """If true, only the primary copy of 'backup copy' blocks is read at startup. If valid, the secondary one is verified later, in the background."""
+
+        self.lock_free_requests: bool = lock_free_requests
+        """If true, write requests are submitted with C11 atomics, instead of read-modify-write of the block's status. Requires a C11 compiler."""
+
+        self.seqlock_reads: bool = seqlock_reads
+        """If true, each block's cache is guarded by a sequence counter, so tear-free snapshots can be read without a critical section."""
+
+        self.seqlock_read_attempts: int = seqlock_read_attempts
+        """Copies of a region, which a MEEM_Read_...() function makes while the cache is being updated, before it returns false.
+        The reader calls 'seqlock_wait_operation' between the attempts. Set to 0 to retry until the copy is consistent - only if the writer
+        can run, while the reader waits (e.g. on another core, or if the wait operation yields to it). Up to 65535."""
+
+        self.skip_unchanged_writes: bool = skip_unchanged_writes
+        """If true, a hash of each block's persisted data is kept in RAM, and writes of unchanged data complete without an EEPROM access."""
+
+        self.write_batch_size: int = write_batch_size
+        """Maximum size of a single EEPROM write, in bytes, into which pending writes of physically adjacent 'basic' blocks are merged.
+        The work buffer is enlarged to it, if necessary. Set to 0 to write each block separately."""
+
+        self.write_tickets: bool = write_tickets
+        """If true, each write request can get a ticket, which tells whether exactly this request's data has reached the EEPROM."""
+
+        self.completion_queue_size: int = completion_queue_size
+        """Capacity of a queue of write completion events, which replaces the inline 'write complete' callback. Enables the tickets, too.
+        Set to 0 to call the callback in the context of MEEM_PeriodicTask()."""
+
+        self.page_write_time_us: int = page_write_time_us
+        """Time to write one EEPROM page (or one byte, if 'eeprom_page_size' is 0), in microseconds, as specified for the device.
+        Enables the flush time estimation and the emergency flush on power failure. Set to 0 to disable them."""
+
+        self.flash_sector_size: int = flash_sector_size
+        """Size of the smallest erasable unit of the primary device, in bytes, if it's a data FLASH. Required by flash emulation blocks, which occupy whole sectors.
+        Set to 0 if there are no such blocks."""
+
+        self.sector_erase_time_us: int = sector_erase_time_us
+        """Time to erase one FLASH sector, in microseconds, as specified for the device. Used by the flush time estimation, if a write needs an erase first."""
+
+        self.streaming_chunk_size: int = streaming_chunk_size
+        """If > 0, the blocks are read and written through a work buffer of this size, chunk by chunk, so its RAM cost doesn't depend on the size of the largest block.
+        The EEPROM page size is a good choice. Not applicable with transactions, write batching and flash emulation blocks. Set to 0 to transfer whole images."""
+
+        self.zero_copy_writes: bool = zero_copy_writes
+        """If true, each block's cache is preceded by its checksum, so the driver writes the image straight from the cache, without copying it
+        in a critical section. A write, overlapped by an update of the cache, is repeated. Requires 'seqlock_reads'. Not applicable with write batching and flash emulation blocks."""
+
+        self.specialized_core: bool = specialized_core
+        """If true, the management type, data recovery strategy, default pattern length and instance count are each folded into a constant of the core,
+        when all blocks share the value. Otherwise, that one is read from the block configuration, as without the specialization. The per-tick scans
+        of throttled and flash emulation blocks visit only the generated lists of these blocks."""
+
+        self.aligned_caches: bool = aligned_caches
+        """If true, the caches are not packed, so their parameters have natural alignment and the getters/setters access them with single loads/stores.
+        Generated routines pack a cache into the image at write start and unpack it at init. The image keeps the CPU's byte order ('endianness').
+        Not applicable with streaming I/O and zero-copy writes, which transfer the cache as the image."""
+
+        self.optimize_layout: bool = optimize_layout
+        """If true, the blocks are reordered and packed in each device to minimize the padding and the images, which straddle a page, as each one
+        costs an extra page write. Flash emulation and wear-leveling blocks are aligned first. The blocks, listed by name in 'page_aligned_blocks',
+        stay aligned, while '*' doesn't force the others: they're aligned only where that saves page writes. Runs of 'basic' blocks, batched by 'write_batch_size',
+        are kept together. The block IDs don't change. The generator reports the saved bytes and page writes per block."""
+
+        self.keep_block_order: bool = keep_block_order
+        """If true, 'optimize_layout' keeps the blocks in their definition order, and chooses only the padding in front of each one."""
+
+        self.devices: List[EepromDevice] = devices
+        """Additional EEPROM devices. The settings above describe the primary device, accessed via the EEAIF_ operations.
+        Blocks are assigned to a device by name in the datamodel, and each device is driven in its own lane, with its own work buffer."""
+
+        self.memory_barrier_operation: Optional[str] = memory_barrier_operation
+        """Name of a function/function-like macro, used as a memory barrier by the sequence counters. A compiler barrier is enough for single-core targets."""
+
+        self.seqlock_wait_operation: Optional[str] = seqlock_wait_operation
+        """Name of a function/function-like macro, called by a MEEM_Read_...() function, while a cache update is in progress, e.g. a yield of the
+        RTOS or a pause hint of the CPU. If not specified, the reader retries at once."""
+
     @staticmethod
     def load_from_file(path: str) -> "PlatformSettings":
         with open(path, "r", encoding="utf-8") as f:
@@ -114,6 +249,9 @@ class PlatformSettings:
 
                 data["compiler_directives"] = CompilerDirectives(**compiler_data)
 
+            if "devices" in data:
+                data["devices"] = [EepromDevice(**device) for device in data["devices"]]
+
             return PlatformSettings(**data)
 
     def save_to_file(self, path: str):
@@ -146,9 +284,55 @@ class PlatformSettings:
 
         errors = []
 
+        if not (1 <= self.eeprom_size <= 0xFFFFFFFF):
+            errors.append(f"'eeprom_size' should be a positive integer, up to 0xFFFFFFFF!")
+
         if self.eeprom_page_size < 0 or (self.eeprom_page_size > 0 and not is_power_of_2(self.eeprom_page_size)):
             errors.append(f"EEPROM page size should be 0 or positive integer and power of 2!")
 
+        if self.task_period_ms < 1:
+            errors.append(f"'task_period_ms' should be a positive integer!")
+
+        if self.scrub_bytes_per_second < 0:
+            errors.append(f"'scrub_bytes_per_second' should be 0 (disabled) or a positive integer!")
+
+        if not (0 <= self.write_batch_size <= 0xFFFF):
+            errors.append(f"'write_batch_size' should be 0 (disabled) or a positive integer, up to 65535!")
+
+        if not (0 <= self.completion_queue_size <= 255):
+            errors.append(f"'completion_queue_size' should be 0 (disabled) or a positive integer, up to 255!")
+
+        if not (0 <= self.page_write_time_us <= 0xFFFF):
+            errors.append(f"'page_write_time_us' should be 0 (disabled) or a positive integer, up to 65535!")
+
+        if self.flash_sector_size < 0 or (self.flash_sector_size > 0 and not is_power_of_2(self.flash_sector_size)):
+            errors.append(f"'flash_sector_size' should be 0 or positive integer and power of 2!")
+
+        if not (0 <= self.sector_erase_time_us <= 0xFFFFFFFF):
+            errors.append(f"'sector_erase_time_us' should be 0 or a positive integer, up to 0xFFFFFFFF!")
+
+        if not (0 <= self.seqlock_read_attempts <= 0xFFFF):
+            errors.append(f"'seqlock_read_attempts' should be 0 (unlimited) or a positive integer, up to 65535!")
+
+        if not (0 <= self.streaming_chunk_size <= 0xFFFF):
+            errors.append(f"'streaming_chunk_size' should be 0 (disabled) or a positive integer, up to 65535!")
+
+        device_names = [d.name for d in self.devices]
+        if len(set(device_names)) != len(device_names):
+            errors.append(f"Device names must be unique!")
+
+        for device in self.devices:
+            if not is_valid_identifier(device.name):
+                errors.append(f"Device '{device.name}' has invalid name! A valid C-language identifier is expected.")
+            if not is_valid_identifier(device.eeaif_prefix) or device.eeaif_prefix == "EEAIF":
+                errors.append(f"Device '{device.name}' has invalid 'eeaif_prefix'! A valid C-language identifier, other than 'EEAIF', is expected.")
+            if not (1 <= device.eeprom_size <= 0xFFFFFFFF):
+                errors.append(f"Device '{device.name}' should have a positive 'eeprom_size', up to 0xFFFFFFFF!")
+            if device.eeprom_page_size < 0 or (device.eeprom_page_size > 0 and not is_power_of_2(device.eeprom_page_size)):
+                errors.append(f"Device '{device.name}' should have 'eeprom_page_size' of 0 or positive integer and power of 2!")
+            if not (0 <= device.page_write_time_us <= 0xFFFF):
+                errors.append(f"Device '{device.name}' should have 'page_write_time_us' of 0 or a positive integer, up to 65535!")
+
         if any(map(lambda h: not is_valid_filename(h), self.external_headers)):
             errors.append(f"Some of the external headers has invalid file name")
 
@@ -158,6 +342,12 @@ class PlatformSettings:
         if self.exit_critical_section_operation != None and not is_valid_identifier(self.exit_critical_section_operation):
             errors.append(f"'exit_critical_section_operation' is not a valid C-language identifier!")
 
+        if self.memory_barrier_operation != None and not is_valid_identifier(self.memory_barrier_operation):
+            errors.append(f"'memory_barrier_operation' is not a valid C-language identifier!")
+
+        if self.seqlock_wait_operation != None and not is_valid_identifier(self.seqlock_wait_operation):
+            errors.append(f"'seqlock_wait_operation' is not a valid C-language identifier!")
+
         if self.compiler_directives.pack_attribute and (self.compiler_directives.opening_pack_directive or self.compiler_directives.closing_pack_directive):
             errors.append(f"You can't have both compiler pack directive and attribute defined at the same time! Pick only one.")
 
@@ -3,7 +3,7 @@ import sys
 import struct
 
 sys.path.append(os.path.dirname(__file__))
-from typing import Optional
+from typing import List, Optional, Tuple
 from common.data_model import *
 from common.platform_settings import *
 
@@ -55,27 +55,374 @@ def deduce_default_pattern(block: Block, settings: PlatformSettings) -> Optional
     return None
 
 
-def attach_block_metadata(datamodel: DataModel, settings: PlatformSettings):
-    align_all = "*" in [name for name in settings.page_aligned_blocks]
-    offset_in_eeprom = 0
+MIN_DEFAULTS_RUN = 3
+"""Shortest run of equal bytes in run-length encoded defaults. Shorter runs take no less space as a part of a literal. Matches MEEM_DEFAULTS_MIN_RUN."""
+
+
+def encode_defaults(block: Block, settings: PlatformSettings) -> bytes:
+    """Run-length encodes the compacted defaults of a block - e.g. zeros with a few non-zero parameters.
+    The encoding is a sequence of segments, each starting with a header byte:
+    0x00..0x7F - a literal of (header + 1) bytes, which follow it;
+    0x80..0xFF - a run of (header - 0x80 + MIN_DEFAULTS_RUN) copies of the single byte, which follows it."""
+
+    bytes = extract_defaults(block, settings)
+    encoded = bytearray()
+    literal = bytearray()
+
+    def flush_literal():
+        if len(literal) > 0:
+            encoded.append(len(literal) - 1)
+            encoded.extend(literal)
+            literal.clear()
+
+    i = 0
+    while i < len(bytes):
+        run = 1
+        while (i + run < len(bytes)) and (bytes[i + run] == bytes[i]) and (run < 0x7F + MIN_DEFAULTS_RUN):
+            run += 1
+
+        if run >= MIN_DEFAULTS_RUN:
+            flush_literal()
+            encoded.append(0x80 + run - MIN_DEFAULTS_RUN)
+            encoded.append(bytes[i])
+            i += run
+        else:
+            literal.append(bytes[i])
+            if len(literal) == 0x80:
+                flush_literal()
+            i += 1
+    flush_literal()
+    return encoded
+
+
+def select_defaults_compression(block: Block, settings: PlatformSettings):
+    """Picks the compression of a block's defaults. A repeating pattern is preferred - it's restored by a single memset() or a few memcpy().
+    Otherwise, the run-length encoding is taken, if it's shorter than the data."""
+
+    block.default_pattern = None
+    block.encoded_defaults = None
+    if not block.compress_defaults:
+        return
+
+    block.default_pattern = deduce_default_pattern(block, settings)
+    if (block.default_pattern is None) or (len(block.default_pattern) > 255):
+        encoded = encode_defaults(block, settings)
+        if len(encoded) < (block.data_size - int(block.has_sequence_counter)):
+            block.default_pattern = None
+            block.encoded_defaults = encoded
+
+
+def get_device_id(block: Block, settings: PlatformSettings) -> int:
+    """0 for the primary device, 1.. for the additional ones, in the order of the platform settings."""
+    if block.device is None:
+        return 0
+    device_names = [d.name for d in settings.devices]
+    if block.device not in device_names:
+        raise Exception(f"Block '{block.name}' refers to device '{block.device}', which is not defined in the platform settings!")
+    return device_names.index(block.device) + 1
+
+
+def get_device_id_by_name(device_name: Optional[str], settings: PlatformSettings) -> int:
+    """Resolves a device name, given to the tools. None or 'primary' - the primary device."""
+    if (device_name is None) or (device_name == "primary"):
+        return 0
+    device_names = [d.name for d in settings.devices]
+    if device_name not in device_names:
+        raise Exception(f"Device '{device_name}' is not defined in the platform settings!")
+    return device_names.index(device_name) + 1
 
-    for index, block in enumerate(datamodel.children):
+
+def select_device_blocks(datamodel: DataModel, device_id: int):
+    """Keeps only the blocks of a device in the datamodel. Call after attach_block_metadata()."""
+    datamodel.children = [b for b in datamodel.children if b.device_id == device_id]
+
+
+def get_device_page_size(device_id: int, settings: PlatformSettings) -> int:
+    return settings.eeprom_page_size if device_id == 0 else settings.devices[device_id - 1].eeprom_page_size
+
+
+def get_device_eeprom_size(device_id: int, settings: PlatformSettings) -> int:
+    return settings.eeprom_size if device_id == 0 else settings.devices[device_id - 1].eeprom_size
+
+
+def get_device_name(device_id: int, settings: PlatformSettings) -> str:
+    return "primary" if device_id == 0 else settings.devices[device_id - 1].name
+
+
+def attach_block_metadata(datamodel: DataModel, settings: PlatformSettings):
+    for block in datamodel.children:
+        block.device_id = get_device_id(block, settings)
+        block.slots_per_sector = get_flash_slots_per_sector(block, datamodel, settings)
+        if block.management_type == Block.ManagementTypes.FlashEmulation:
+            block.size_in_eeprom = settings.flash_sector_size * block.instance_count
+        elif block.management_type == Block.ManagementTypes.ReadThrough:
+            block.size_in_eeprom = (datamodel.checksum_size * get_chunk_count(block)) + block.data_size
+        else:
+            block.size_in_eeprom = (datamodel.checksum_size + block.data_size) * block.instance_count
+        # The getters of memory-mapped blocks read their defaults directly, if the data is invalid, so they're never compressed
+        if block.management_type != Block.ManagementTypes.MemoryMapped:
+            select_defaults_compression(block, settings)
+
+    offsets = plan_optimized_layout(datamodel, settings) if settings.optimize_layout else plan_layout_in_definition_order(datamodel, settings)
+    for block, offset_in_eeprom in zip(datamodel.children, offsets):
         block.offset_in_eeprom = offset_in_eeprom
-        block.size_in_eeprom = (datamodel.checksum_size + block.data_size) * block.instance_count
-        block.default_pattern = deduce_default_pattern(block, settings) if block.compress_defaults else None
 
-        offset_in_eeprom += block.size_in_eeprom
+    # Transaction journal: a commit record, followed by a slot per transactional block. Slots have the layout of an instance.
+    # It's always in the primary device, along with the transactional blocks.
+    offset_in_eeprom = max([b.offset_in_eeprom + b.size_in_eeprom for b in datamodel.children if b.device_id == 0], default=0)  # type:ignore
+    if any(b.transactional for b in datamodel.children):
+        if (settings.eeprom_page_size > 0) and ((offset_in_eeprom % settings.eeprom_page_size) != 0):
+            offset_in_eeprom |= settings.eeprom_page_size - 1
+            offset_in_eeprom += 1
+
+        offset_in_eeprom += get_transaction_record_size(datamodel)
+
+    for block in datamodel.children:
+        block.journal_offset = None
+        if block.transactional:
+            block.journal_offset = offset_in_eeprom
+            offset_in_eeprom += datamodel.checksum_size + block.data_size
+
+
+def plan_layout_in_definition_order(datamodel: DataModel, settings: PlatformSettings) -> List[int]:
+    """Offsets of the blocks, laid out in their definition order. The blocks in 'page_aligned_blocks' start at a page boundary."""
+    align_all = "*" in [name for name in settings.page_aligned_blocks]
+    device_offsets = [0] * (len(settings.devices) + 1)  # Each device has its own offset space
+    offsets = []
+
+    for block in datamodel.children:
+        page_size = get_device_page_size(block.device_id, settings)  # type:ignore
+        offset_in_eeprom = device_offsets[block.device_id]  # type:ignore
 
-        if (
-            (settings.eeprom_page_size > 0)
-            and ((offset_in_eeprom % settings.eeprom_page_size) != 0)
-            and (index < len(datamodel.children) - 1)
-            and ((datamodel.children[index + 1].name in settings.page_aligned_blocks) or align_all)
-        ):
+        if (page_size > 0) and ((offset_in_eeprom % page_size) != 0) and ((block.name in settings.page_aligned_blocks) or align_all):
             # Align to page boundary:
-            offset_in_eeprom |= settings.eeprom_page_size - 1
+            offset_in_eeprom |= page_size - 1
             offset_in_eeprom += 1
 
+        if (block.management_type == Block.ManagementTypes.FlashEmulation) and (settings.flash_sector_size > 0):
+            # Flash emulation blocks occupy whole sectors, so their erases never touch other blocks
+            offset_in_eeprom = -(-offset_in_eeprom // settings.flash_sector_size) * settings.flash_sector_size
+
+        offsets.append(offset_in_eeprom)
+        device_offsets[block.device_id] = offset_in_eeprom + block.size_in_eeprom  # type:ignore
+    return offsets
+
+
+def plan_optimized_layout(datamodel: DataModel, settings: PlatformSettings) -> List[int]:
+    """Offsets of the blocks, laid out to minimize the padding and the pages, programmed by their writes. Call after the sizes are known.
+    Flash emulation blocks go first, as they occupy whole sectors, then the page-aligned wear-leveling blocks. The others follow, largest
+    first, each where its writes program the fewest pages, with the least padding, possibly in a gap left by an earlier alignment.
+    With 'keep_block_order', the blocks keep their definition order, and only the padding in front of each one is chosen."""
+    baseline = plan_layout_in_definition_order(datamodel, settings)
+    offsets = [0] * len(datamodel.children)
+
+    for device_id in sorted({b.device_id for b in datamodel.children}):  # type:ignore
+        page_size = get_device_page_size(device_id, settings)  # type:ignore
+        units = get_layout_units(datamodel, settings, device_id, baseline)  # type:ignore
+        if not settings.keep_block_order:
+            units.sort(key=lambda unit: (get_layout_unit_class(datamodel.children[unit[0]]), -get_layout_unit_size(datamodel, unit)))
+
+        end = 0
+        gaps: List[List[int]] = []  # Paddings as [start, end), which the following blocks may fill
+        for unit in units:
+            size = get_layout_unit_size(datamodel, unit)
+            alignment = get_layout_unit_alignment(datamodel.children[unit[0]], settings, page_size)
+            candidates = [-(-end // alignment) * alignment]
+            if (alignment == 1) and (page_size > 0):
+                candidates.append(-(-end // page_size) * page_size)
+            if (alignment == 1) and not settings.keep_block_order:
+                candidates += [g[0] for g in gaps if (g[1] - g[0]) >= size]
+
+            def cost(offset: int) -> Tuple[float, int, int]:
+                page_writes = sum(get_page_writes_per_write(datamodel.children[i], datamodel, o, page_size) for i, o in zip(unit, get_unit_block_offsets(datamodel, unit, offset)))
+                return (round(page_writes, 6), max(offset - end, 0), offset)
+
+            offset = min(candidates, key=cost)
+            if offset < end:
+                gap = next(g for g in gaps if g[0] == offset)
+                gap[0] += size
+                gaps = [g for g in gaps if g[0] < g[1]]
+            else:
+                if offset > end:
+                    gaps.append([end, offset])
+                end = offset + size
+
+            for i, o in zip(unit, get_unit_block_offsets(datamodel, unit, offset)):
+                offsets[i] = o
+    return offsets
+
+
+def get_layout_units(datamodel: DataModel, settings: PlatformSettings, device_id: int, baseline: List[int]) -> List[List[int]]:
+    """Indices of a device's blocks, grouped into units, placed as a whole. With write batching, a run of 'basic' blocks, adjacent in
+    the definition order layout, forms a unit, so the optimization keeps their writes batched. Any other block is a unit on its own."""
+    units: List[List[int]] = []
+    for i, block in [(i, b) for i, b in enumerate(datamodel.children) if b.device_id == device_id]:
+        previous = datamodel.children[i - 1] if i > 0 else None
+        follows_previous = (
+            (settings.write_batch_size > 0)
+            and (previous is not None)
+            and (previous.device_id == device_id)
+            and (block.management_type == Block.ManagementTypes.Basic)
+            and (previous.management_type == Block.ManagementTypes.Basic)
+            and (baseline[i] == baseline[i - 1] + previous.size_in_eeprom)  # type:ignore
+        )
+        if follows_previous:
+            units[-1].append(i)
+        else:
+            units.append([i])
+    return units
+
+
+def get_layout_unit_class(block: Block) -> int:
+    """Flash emulation blocks are placed first, then the wear-leveling ones, then the others."""
+    if block.management_type == Block.ManagementTypes.FlashEmulation:
+        return 0
+    return 1 if block.management_type == Block.ManagementTypes.WearLeveling else 2
+
+
+def get_layout_unit_alignment(first_block: Block, settings: PlatformSettings, page_size: int) -> int:
+    """A unit must start at a sector boundary, if it's a flash emulation block, and at a page boundary, if it's a wear-leveling block or
+    listed by name in 'page_aligned_blocks'. Otherwise, it's aligned only where that saves page writes: '*' doesn't force the alignment."""
+    if (first_block.management_type == Block.ManagementTypes.FlashEmulation) and (settings.flash_sector_size > 0):
+        return settings.flash_sector_size
+    if (page_size > 0) and ((first_block.management_type == Block.ManagementTypes.WearLeveling) or (first_block.name in settings.page_aligned_blocks)):
+        return page_size
+    return 1
+
+
+def get_layout_unit_size(datamodel: DataModel, unit: List[int]) -> int:
+    return sum(datamodel.children[i].size_in_eeprom for i in unit)  # type:ignore
+
+
+def get_unit_block_offsets(datamodel: DataModel, unit: List[int], offset: int) -> List[int]:
+    """Offsets of a unit's blocks, packed one after another from the unit's offset."""
+    offsets = []
+    for i in unit:
+        offsets.append(offset)
+        offset += datamodel.children[i].size_in_eeprom  # type:ignore
+    return offsets
+
+
+def get_page_writes_per_write(block: Block, datamodel: DataModel, offset_in_eeprom: int, page_size: int) -> float:
+    """Pages, programmed by a write of the block, if it's placed at an offset. A 'backup copy' block writes all its instances at once, the
+    others write one instance (or chunk), so their count is averaged. 0 for devices without pages and for flash emulation blocks."""
+    if (page_size == 0) or (block.management_type == Block.ManagementTypes.FlashEmulation):
+        return 0.0
+
+    if block.management_type == Block.ManagementTypes.ReadThrough:
+        chunk_stride = datamodel.checksum_size + block.chunk_size  # type:ignore
+        spans = [(offset_in_eeprom + i * chunk_stride, datamodel.checksum_size + min(block.chunk_size, block.data_size - i * block.chunk_size)) for i in range(get_chunk_count(block))]  # type:ignore
+    else:
+        image_size = datamodel.checksum_size + block.data_size
+        spans = [(offset_in_eeprom + i * image_size, image_size) for i in range(block.instance_count)]
+
+    pages = [((start + size - 1) // page_size) - (start // page_size) + 1 for start, size in spans]
+    return float(sum(pages)) if block.management_type == Block.ManagementTypes.BackupCopy else sum(pages) / len(pages)
+
+
+def get_layout_savings(datamodel: DataModel, settings: PlatformSettings) -> List[Tuple[Block, int, float]]:
+    """Compares the layout of the blocks with the one in definition order: EEPROM bytes of padding in front of each block and pages,
+    programmed by each of its writes, saved by the optimization. Call after attach_block_metadata()."""
+    baseline = plan_layout_in_definition_order(datamodel, settings)
+    optimized = [b.offset_in_eeprom for b in datamodel.children]
+    baseline_paddings = get_paddings(datamodel, baseline)
+    optimized_paddings = get_paddings(datamodel, optimized)  # type:ignore
+    savings = []
+
+    for i, block in enumerate(datamodel.children):
+        page_size = get_device_page_size(block.device_id, settings)  # type:ignore
+        page_writes_saved = get_page_writes_per_write(block, datamodel, baseline[i], page_size) - get_page_writes_per_write(block, datamodel, optimized[i], page_size)  # type:ignore
+        savings.append((block, baseline_paddings[i] - optimized_paddings[i], page_writes_saved))
+    return savings
+
+
+def get_paddings(datamodel: DataModel, offsets: List[int]) -> List[int]:
+    """Padding in front of each block: the gap between it and the block below it in the same device."""
+    paddings = [0] * len(datamodel.children)
+    for device_id in {b.device_id for b in datamodel.children}:
+        end = 0
+        for i in sorted([i for i, b in enumerate(datamodel.children) if b.device_id == device_id], key=lambda i: offsets[i]):
+            paddings[i] = offsets[i] - end
+            end = offsets[i] + datamodel.children[i].size_in_eeprom  # type:ignore
+    return paddings
+
+
+def get_flash_slots_per_sector(block: Block, datamodel: DataModel, settings: PlatformSettings) -> int:
+    """Count of instances in a FLASH sector of a flash emulation block: as many as fit, up to the limit of all slots. 0 for the other types."""
+    if block.management_type != Block.ManagementTypes.FlashEmulation:
+        return 0
+    return min(settings.flash_sector_size // (datamodel.checksum_size + block.data_size), Block.MAX_FLASH_SLOT_COUNT // max(block.instance_count, 1))
+
+
+def get_chunk_count(block: Block) -> int:
+    """Count of chunks of a read-through block, each with its own checksum. 0 for the other types."""
+    if block.management_type != Block.ManagementTypes.ReadThrough:
+        return 0
+    return -(-block.data_size // block.chunk_size)
+
+
+def get_chunk_layout(block: Block, datamodel: DataModel) -> List[Tuple[int, int, int]]:
+    """Chunks of a read-through block as (offset in the device, position in the block's data, size of the data).
+    Each chunk's checksum is at its offset, followed by its data. Call after attach_block_metadata()."""
+    chunks = []
+    for i in range(get_chunk_count(block)):
+        position = i * block.chunk_size
+        chunks.append((block.offset_in_eeprom + i * (datamodel.checksum_size + block.chunk_size), position, min(block.chunk_size, block.data_size - position)))  # type:ignore
+    return chunks
+
+
+def get_physical_instance_count(block: Block) -> int:
+    """Count of instances in the EEPROM. For flash emulation blocks, that's the count of slots in all sectors. Call after attach_block_metadata()."""
+    if block.management_type == Block.ManagementTypes.FlashEmulation:
+        return block.instance_count * block.slots_per_sector  # type:ignore
+    return block.instance_count
+
+
+def get_instance_offsets(block: Block, datamodel: DataModel) -> List[int]:
+    """Offsets of all instances of a block in its device. The slots of a flash emulation block are packed at the start of each sector."""
+    image_size = datamodel.checksum_size + block.data_size
+    if block.management_type == Block.ManagementTypes.FlashEmulation:
+        sector_size = block.size_in_eeprom // block.instance_count  # type:ignore
+        return [block.offset_in_eeprom + (i // block.slots_per_sector) * sector_size + (i % block.slots_per_sector) * image_size for i in range(get_physical_instance_count(block))]  # type:ignore
+    return [block.offset_in_eeprom + i * image_size for i in range(block.instance_count)]  # type:ignore
+
+
+def get_transaction_record_size(datamodel: DataModel) -> int:
+    """Commit record: checksum, commit marker and a bit per block, set for the blocks in the journal."""
+    return datamodel.checksum_size + 1 + ((len(datamodel.children) + 7) // 8)
+
+
+def get_transaction_record_offset(datamodel: DataModel) -> Optional[int]:
+    """The commit record precedes the journal slots. None if no block is transactional."""
+    slot_offsets = [b.journal_offset for b in datamodel.children if b.transactional]
+    return (min(slot_offsets) - get_transaction_record_size(datamodel)) if slot_offsets else None  # type:ignore
+
+
+def get_used_eeprom_size(datamodel: DataModel, device_id: int = 0) -> int:
+    """EEPROM bytes of a device, used by its blocks and, in the primary device, by the transaction journal."""
+    used = max([b.offset_in_eeprom + b.size_in_eeprom for b in datamodel.children if b.device_id == device_id], default=0)  # type:ignore
+
+    for block in [b for b in datamodel.children if b.transactional and device_id == 0]:
+        used = max(used, block.journal_offset + datamodel.checksum_size + block.data_size)  # type:ignore
+    return used
+
+
+def get_write_behind_delay_ticks(block: Block, settings: PlatformSettings) -> int:
+    """Converts the block's write-behind delay to count of MEEM_PeriodicTask() calls, rounding up."""
+    return -(-block.write_behind_delay_ms // settings.task_period_ms)
+
+
+def get_coalescing_window_ticks(block: Block, settings: PlatformSettings) -> int:
+    """Converts the block's coalescing window to count of MEEM_PeriodicTask() calls, rounding up."""
+    return -(-block.write_coalescing_window_ms // settings.task_period_ms)
+
+
+def get_write_budget_period_ticks(block: Block, settings: PlatformSettings) -> int:
+    """Gets the count of MEEM_PeriodicTask() calls, after which the block earns one more write, rounding up. 0 if the block has no write budget."""
+    if block.max_writes_per_hour == 0:
+        return 0
+    return -(-3600000 // (block.max_writes_per_hour * settings.task_period_ms))
+
 
 def find_index_of_most_recent_sequence_counter(sequence_counters: bytes) -> Optional[int]:
     """Applies to wear-leveling blocks only."""
@@ -2,15 +2,23 @@
 const DataTypes = {
     uint8: 0, int8: 1, uint16: 2, int16: 3, uint32: 4, int32: 5, uint64: 6, int64: 7, float32: 8, float64: 9
 };
-const ManagementTypes = { Basic: 0, BackupCopy: 1, MultiProfile: 2, WearLeveling: 3 };
+const ManagementTypes = { Basic: 0, BackupCopy: 1, MultiProfile: 2, WearLeveling: 3, FlashEmulation: 4, ReadThrough: 5, MemoryMapped: 6 };
 const ManagementTypeLabels = {
     [ManagementTypes.Basic]: 'Basic',
     [ManagementTypes.BackupCopy]: 'Backup copy',
     [ManagementTypes.MultiProfile]: 'Multi-profile',
-    [ManagementTypes.WearLeveling]: 'Wear-leveling'
+    [ManagementTypes.WearLeveling]: 'Wear-leveling',
+    [ManagementTypes.FlashEmulation]: 'Flash emulation',
+    [ManagementTypes.ReadThrough]: 'Read-through',
+    [ManagementTypes.MemoryMapped]: 'Memory-mapped'
 };
 const DataRecoveryStrategyLabels = { 0: 'Recover defaults & repair', 1: 'Recover defaults' };
 const DataTypeSizes = { 0: 1, 1: 1, 2: 2, 3: 2, 4: 4, 5: 4, 6: 8, 7: 8, 8: 4, 9: 8 };
+// Upper limits of 'instance_count'. Multi-profile blocks above 15 profiles make the core use a wider (8-bit) instance index.
+// For flash emulation blocks, it's the count of FLASH sectors.
+const MaxInstanceCounts = { [ManagementTypes.MultiProfile]: 254, [ManagementTypes.WearLeveling]: 15, [ManagementTypes.FlashEmulation]: 16 };
+// Upper limit of the data in a chunk of a read-through block
+const MaxChunkSize = 255;
 
 const FieldDocs = {
     datamodel: {
@@ -22,9 +30,16 @@ const FieldDocs = {
         name: "Has to be a valid C-language identifier.",
         description: "Optional description. If defined, will appear in the generated sources.",
         management_type: "Defines block's strategy for EEPROM area management.",
-        instance_count: "Number of data instances in the EEPROM. Depends on the selected management type.",
-        data_recovery_strategy: "Defines the behavior if the data integrity check fails on init. Choice between: load defaults and repair the EEPROM area (recommended) or just load defaults.",
-        compress_defaults: "Tries to deduce the shortest possible pattern for default values. In many cases, you may end up using just a single byte for all your defaults."
+        instance_count: "Number of data instances in the EEPROM. Depends on the selected management type. For 'flash emulation' blocks, it's the number of FLASH sectors, each holding as many instances as fit in it.",
+        data_recovery_strategy: "Defines the behavior if the data integrity check fails on init. Choice between: load defaults and repair the EEPROM area (recommended) or just load defaults. 'Memory-mapped' blocks are read-only, so they can only load defaults.",
+        compress_defaults: "Tries to deduce the shortest possible pattern for default values. In many cases, you may end up using just a single byte for all your defaults. If there's no short pattern, the defaults are run-length encoded, if that's shorter.",
+        write_behind_delay_ms: "If > 0, the generated setters mark the block dirty when a value really changes, and the mEEM writes it automatically within this delay, in milliseconds. Set to 0 to write only on MEEM_InitiateBlockWrite() calls.",
+        write_coalescing_window_ms: "Minimum time between the starts of two writes of the block, in milliseconds. Write requests within it are merged into one deferred write. Set to 0 for no limit.",
+        max_writes_per_hour: "Endurance budget of the block. Writes beyond it are deferred, until the budget allows them. Set to 0 for no limit.",
+        transactional: "Reserves a slot for the block in the transaction journal, so it can be written atomically together with other transactional blocks. Not applicable to multi-profile blocks.",
+        flush_priority: "Criticality of the block in an emergency flush after a power failure. Blocks with a higher priority are written first. Used only if the page write time is set.",
+        device: "Name of the EEPROM device, which stores the block, as defined in the platform settings. Leave empty for the primary device. Transactional, 'flash emulation' and 'memory-mapped' blocks must be in the primary device.",
+        chunk_size: "'Read-through' blocks only: size of the data in each chunk, which has its own checksum, in bytes [1..255]. The block has no cache - its chunks are read and written through the work buffer, one by one."
     },
     parameter: {
         name: "Has to be a valid C-language identifier.",
@@ -42,7 +57,29 @@ const FieldDocs = {
         endianness: "Endianness of the target CPU",
         eeprom_size: "Allocated EEPROM to the mEEM, in bytes. In some cases, it might not be the whole available EEPROM.",
         eeprom_page_size: "Size of the EEPROM's page, in bytes. Set to 0 for systems that can write only one byte at a time, like most on-chip EEPROMs or if 'Flash EEPROM emulation' driver is used.",
-        page_aligned_blocks: "List of block names which you want aligned to EEPROM page boundaries. The names must be present in the datamodel. If not specified, defaults to ['*'] (align all blocks). Makes sense only if eeprom_page_size > 0.",
+        page_aligned_blocks: "List of block names which you want aligned to EEPROM page boundaries. The names must be present in the datamodel. If not specified, defaults to ['*'] (align all blocks). With optimize_layout, '*' forces no block to a page boundary, and only the blocks listed by name are aligned in any case. Makes sense only if eeprom_page_size > 0.",
+        task_period_ms: "Period of MEEM_PeriodicTask() calls, in milliseconds. Used as a time base for rate-limited features, like the background scrubbing.",
+        scrub_bytes_per_second: "I/O budget for background scrubbing of 'backup copy' and 'wear-leveling' blocks in idle time, in bytes per second. Corrupted instances are repaired proactively. Set to 0 to disable the scrubbing.",
+        lazy_backup_verification: "If checked, only the primary copy of 'backup copy' blocks is read at startup. If it's valid, the secondary copy is verified later, in the background, and repaired if needed. Halves the startup time of such blocks in the common case.",
+        lock_free_requests: "If checked, write requests are submitted with C11 atomic operations, so MEEM_InitiateBlockWrite() can be called from any thread without a critical section. Requires a C11 compiler.",
+        seqlock_reads: "If checked, each block's cache is guarded by a sequence counter. Generated MEEM_Read_...() functions take tear-free snapshots of caches without a critical section, e.g. from interrupts.",
+        seqlock_read_attempts: "Copies, which a MEEM_Read_...() function makes while the cache is being updated, before it returns false. Set to 0 to retry until the copy is consistent - only if the writer can run while the reader waits (e.g. on another core). Used only with 'seqlock_reads'.",
+        skip_unchanged_writes: "If checked, a hash of each block's data in the EEPROM is kept in RAM, and writes of unchanged data complete immediately, without an EEPROM access. Saves bus time and endurance at the cost of 4 bytes of RAM per block.",
+        streaming_chunk_size: "Size of the work buffer, in bytes, if the blocks are read and written through it chunk by chunk. Its RAM cost doesn't depend on the largest block then. The checksum implementation must provide MEEM_UpdateChecksum(). The EEPROM page size is a good choice. Not applicable with transactions, write batching and flash emulation blocks. Set to 0 to transfer whole images.",
+        specialized_core: "If checked, the management type, data recovery strategy, default pattern length and instance count are each folded into a constant of the core, when all blocks share the value. Values, which differ between blocks, are read from the block configuration as usual. The per-tick scans of throttled and flash emulation blocks visit only generated lists of these blocks.",
+        aligned_caches: "If checked, the block caches keep their parameters naturally aligned, and are packed to the EEPROM image on write and unpacked from it on read. Avoids unaligned accesses on CPUs, which trap on them or emulate them slowly, at the expense of padding RAM. Not compatible with streamed IO and zero-copy writes.",
+        optimize_layout: "If checked, the blocks are reordered and packed in each device to minimize the padding and the images, which straddle a page and cost an extra page write. Flash emulation and wear-leveling blocks are aligned first. Blocks listed by name in page_aligned_blocks stay aligned, '*' doesn't force the others: they're aligned only where that saves page writes. Batched runs of basic blocks are kept together. Block IDs don't change.",
+        keep_block_order: "If checked, the layout optimization keeps the blocks in their definition order, and only chooses the padding in front of each one.",
+        zero_copy_writes: "If checked, each block's cache is preceded by its checksum, so the driver writes the image straight from the cache, without copying it in a critical section. A write, overlapped by an update of the cache, is repeated. Requires 'seqlock_reads'. Not applicable with write batching and flash emulation blocks.",
+        write_batch_size: "Maximum size of a single EEPROM write, in bytes. Pending writes of 'basic' blocks, which are adjacent in the EEPROM, are merged into one write up to this size, saving the per-request overhead of the driver. The work buffer grows to this size, if necessary. Set to 0 to write each block separately.",
+        write_tickets: "If checked, MEEM_InitiateBlockWriteEx() returns a ticket for each write request, and MEEM_GetTicketStatus() tells whether exactly that request's data has reached the EEPROM. Costs 8 bytes of RAM per block.",
+        page_write_time_us: "Worst-case time of writing one EEPROM page (or byte, if the page size is 0), in microseconds. If > 0, the time to flush all pending writes can be estimated, and an emergency flush writes the most critical blocks within a time budget. Set to 0 to disable it.",
+        flash_sector_size: "Size of the smallest erasable unit of the primary device, in bytes, if it's a data FLASH. Required by 'flash emulation' blocks, which occupy whole sectors and erase them with EEAIF_BeginErase(). Set to 0 if there are no such blocks.",
+        sector_erase_time_us: "Worst-case time of erasing one FLASH sector, in microseconds. Used by the flush time estimation, if a write of a 'flash emulation' block needs an erase first.",
+        devices: "Additional EEPROM devices, each with a name, the prefix of its driver's operations (e.g. 'SPI_EEAIF' for SPI_EEAIF_BeginRead()), size, page size and page write time. Each device is driven in its own lane, in parallel with the others, with its own work buffer.",
+        completion_queue_size: "Capacity of a queue of write completion events. If > 0, the 'write complete' callback is not called from MEEM_PeriodicTask() - the application takes the events with MEEM_GetCompletionEvent() instead. Enables the write tickets, too. Set to 0 to use the callback.",
+        memory_barrier_operation: "Function/macro, used as a memory barrier around the sequence counters. A compiler barrier is enough for single-core targets. Used only with 'seqlock_reads'.",
+        seqlock_wait_operation: "Function/macro, called by the MEEM_Read_...() functions while a cache update is in progress, e.g. a yield of the RTOS or a pause hint of the CPU. If empty, the reader retries at once. Used only with 'seqlock_reads'.",
         external_headers: "External header files, containing forward declarations for 'enter_critical_section_operation' and 'exit_critical_section_operation'.",
         enter_critical_section_operation: "Function/macro for designating the start of an atomic code fragment in the mEEM.",
         exit_critical_section_operation: "Function/macro for designating the end of an atomic code fragment in the mEEM.",
@@ -365,10 +402,10 @@ function restoreNumericTypesAfterLoad(obj) {
 
 // Default factories
 function makeEmptyDataModel() { return { name: '', description: '', checksum_size: 1, children: [] } }
-function makeEmptyBlock() { return { name: '', description: '', children: [], management_type: ManagementTypes.Basic, instance_count: 1, data_recovery_strategy: 0, compress_defaults: true } }
+function makeEmptyBlock() { return { name: '', description: '', children: [], management_type: ManagementTypes.Basic, instance_count: 1, data_recovery_strategy: 0, compress_defaults: true, write_behind_delay_ms: 0, write_coalescing_window_ms: 0, max_writes_per_hour: 0, transactional: false, flush_priority: 0, device: null, chunk_size: 0 } }
 function makeEmptyParameter() { return { name: '', description: '', children: [], data_type: DataTypes.uint8, multiplicity: 1, default_value: [0] } }
 function makeEmptyBitfield() { return { name: '', description: '', size_in_bits: 1 } }
-function makeDefaultPlatform() { return { endianness: 'little', eeprom_size: 256, eeprom_page_size: 0, page_aligned_blocks: ['*'], external_headers: [], enter_critical_section_operation: null, exit_critical_section_operation: null, compiler_directives: { opening_pack_directive: null, closing_pack_directive: null, pack_attribute: null, block_placement_directives: {} } } }
+function makeDefaultPlatform() { return { endianness: 'little', eeprom_size: 256, eeprom_page_size: 0, page_write_time_us: 0, flash_sector_size: 0, sector_erase_time_us: 0, page_aligned_blocks: ['*'], task_period_ms: 5, scrub_bytes_per_second: 0, lazy_backup_verification: false, lock_free_requests: false, seqlock_reads: false, seqlock_read_attempts: 4, skip_unchanged_writes: false, write_batch_size: 0, write_tickets: false, completion_queue_size: 0, streaming_chunk_size: 0, zero_copy_writes: false, specialized_core: false, aligned_caches: false, optimize_layout: false, keep_block_order: false, devices: [], external_headers: [], enter_critical_section_operation: null, exit_critical_section_operation: null, memory_barrier_operation: null, seqlock_wait_operation: null, compiler_directives: { opening_pack_directive: null, closing_pack_directive: null, pack_attribute: null, block_placement_directives: {} } } }
 function makeDefaultChecksum() { return { algo: 'crc' } }
 
 // File menu
@@ -579,7 +616,7 @@ function clampValueToType(val, param_type) {
     return Number(vBig);
 }
 
-function is_instance_count_valid(block) { if (block.instance_count < 1) return false; if (block.management_type === ManagementTypes.Basic && block.instance_count !== 1) return false; if (block.management_type === ManagementTypes.BackupCopy && block.instance_count !== 2) return false; if ((block.management_type === ManagementTypes.MultiProfile || block.management_type === ManagementTypes.WearLeveling) && (block.instance_count < 2 || block.instance_count > 15)) return false; return true }
+function is_instance_count_valid(block) { if (block.instance_count < 1) return false; if (block.management_type === ManagementTypes.Basic && block.instance_count !== 1) return false; if (block.management_type === ManagementTypes.BackupCopy && block.instance_count !== 2) return false; if ((block.management_type === ManagementTypes.ReadThrough || block.management_type === ManagementTypes.MemoryMapped) && block.instance_count !== 1) return false; if ((block.management_type === ManagementTypes.MultiProfile || block.management_type === ManagementTypes.WearLeveling || block.management_type === ManagementTypes.FlashEmulation) && (block.instance_count < 2 || block.instance_count > MaxInstanceCounts[block.management_type])) return false; return true }
 
 // Helper to push validation error with structured info
 function pushValidationError(errors, message, path) {
@@ -597,6 +634,64 @@ function validateBlock(block, blockPath, errors) {
     if (!block.children || block.children.length === 0) {
         pushValidationError(errors, `Block '${block.name}' must contain at least 1 parameter!`, blockPath);
     }
+    if (block.write_behind_delay_ms !== undefined && !(Number.isInteger(block.write_behind_delay_ms) && block.write_behind_delay_ms >= 0)) {
+        pushValidationError(errors, `Block '${block.name}' has invalid 'write_behind_delay_ms': ${block.write_behind_delay_ms}`, blockPath);
+    }
+    if (block.write_coalescing_window_ms !== undefined && !(Number.isInteger(block.write_coalescing_window_ms) && block.write_coalescing_window_ms >= 0)) {
+        pushValidationError(errors, `Block '${block.name}' has invalid 'write_coalescing_window_ms': ${block.write_coalescing_window_ms}`, blockPath);
+    }
+    if (block.max_writes_per_hour !== undefined && !(Number.isInteger(block.max_writes_per_hour) && block.max_writes_per_hour >= 0 && block.max_writes_per_hour <= 0xFFFF)) {
+        pushValidationError(errors, `Block '${block.name}' has invalid 'max_writes_per_hour': ${block.max_writes_per_hour}. The range is [0..65535].`, blockPath);
+    }
+    if (block.flush_priority !== undefined && !(Number.isInteger(block.flush_priority) && block.flush_priority >= 0 && block.flush_priority <= 255)) {
+        pushValidationError(errors, `Block '${block.name}' has invalid 'flush_priority': ${block.flush_priority}. The range is [0..255].`, blockPath);
+    }
+    if (block.transactional && block.management_type === ManagementTypes.MultiProfile) {
+        pushValidationError(errors, `Block '${block.name}' is a multi-profile block, which can't be transactional!`, blockPath);
+    }
+    if (block.transactional && block.management_type === ManagementTypes.FlashEmulation) {
+        pushValidationError(errors, `Block '${block.name}' is a flash emulation block, which can't be transactional!`, blockPath);
+    }
+    if (block.transactional && block.management_type === ManagementTypes.ReadThrough) {
+        pushValidationError(errors, `Block '${block.name}' is a read-through block, which can't be transactional!`, blockPath);
+    }
+    if (block.management_type === ManagementTypes.ReadThrough) {
+        if (!(Number.isInteger(block.chunk_size) && block.chunk_size >= 1 && block.chunk_size <= MaxChunkSize)) {
+            pushValidationError(errors, `Block '${block.name}' has invalid 'chunk_size': ${block.chunk_size}. The range is [1..${MaxChunkSize}].`, blockPath);
+        }
+        if ((block.write_behind_delay_ms > 0) || (block.write_coalescing_window_ms > 0) || (block.max_writes_per_hour > 0)) {
+            pushValidationError(errors, `Block '${block.name}' is a read-through block, whose writes can't be deferred. Set its write-behind and throttling limits to 0.`, blockPath);
+        }
+    }
+    if (block.transactional && block.management_type === ManagementTypes.MemoryMapped) {
+        pushValidationError(errors, `Block '${block.name}' is a memory-mapped block, which can't be transactional!`, blockPath);
+    }
+    if (block.management_type === ManagementTypes.MemoryMapped) {
+        if ((block.write_behind_delay_ms > 0) || (block.write_coalescing_window_ms > 0) || (block.max_writes_per_hour > 0)) {
+            pushValidationError(errors, `Block '${block.name}' is a memory-mapped block, which is read-only. Set its write-behind and throttling limits to 0.`, blockPath);
+        }
+        if (block.data_recovery_strategy !== 1) {
+            pushValidationError(errors, `Block '${block.name}' is a memory-mapped block, which is read-only, so it can't be repaired. Set its 'data_recovery_strategy' to 'RecoverDefaults'.`, blockPath);
+        }
+    }
+    if (block.management_type === ManagementTypes.FlashEmulation && !((state.platformSettings && state.platformSettings.flash_sector_size) > 0)) {
+        pushValidationError(errors, `Block '${block.name}' is a flash emulation block, which requires 'flash_sector_size' in the platform settings.`, blockPath);
+    }
+    if (block.device) {
+        const devices = (state.platformSettings && state.platformSettings.devices) || [];
+        if (!devices.some(d => d.name === block.device)) {
+            pushValidationError(errors, `Block '${block.name}' refers to device '${block.device}', which is not defined in the platform settings!`, blockPath);
+        }
+        if (block.transactional) {
+            pushValidationError(errors, `Block '${block.name}' is transactional, so it must be stored in the primary device!`, blockPath);
+        }
+        if (block.management_type === ManagementTypes.FlashEmulation) {
+            pushValidationError(errors, `Block '${block.name}' is a flash emulation block, so it must be stored in the primary device!`, blockPath);
+        }
+        if (block.management_type === ManagementTypes.MemoryMapped) {
+            pushValidationError(errors, `Block '${block.name}' is a memory-mapped block, so it must be stored in the primary device!`, blockPath);
+        }
+    }
     const dupParams = get_duplicate_names(block.children || []);
     if (dupParams.length > 0) {
         pushValidationError(errors, `Block '${block.name}' contains parameters with duplicate names: ${dupParams.join(',')}`, blockPath);
@@ -639,9 +734,26 @@ function validateAll() {
 
     if (ps) {
         if (ps.eeprom_page_size < 0 || (ps.eeprom_page_size > 0 && !is_power_of_2(ps.eeprom_page_size))) push(errors, 'EEPROM page size should be 0 or positive power of 2');
+        if (ps.task_period_ms !== undefined && !(Number.isInteger(ps.task_period_ms) && ps.task_period_ms >= 1)) push(errors, 'Task period should be a positive integer');
+        if (ps.scrub_bytes_per_second !== undefined && !(Number.isInteger(ps.scrub_bytes_per_second) && ps.scrub_bytes_per_second >= 0)) push(errors, 'Scrubbing rate should be a non-negative integer');
+        if (ps.write_batch_size !== undefined && !(Number.isInteger(ps.write_batch_size) && ps.write_batch_size >= 0 && ps.write_batch_size <= 65535)) push(errors, 'Write batch size should be an integer between 0 and 65535');
+        if (ps.page_write_time_us !== undefined && !(Number.isInteger(ps.page_write_time_us) && ps.page_write_time_us >= 0 && ps.page_write_time_us <= 65535)) push(errors, 'Page write time should be an integer between 0 and 65535');
+        if (ps.flash_sector_size !== undefined && (ps.flash_sector_size < 0 || (ps.flash_sector_size > 0 && !is_power_of_2(ps.flash_sector_size)))) push(errors, 'FLASH sector size should be 0 or positive power of 2');
+        if (ps.sector_erase_time_us !== undefined && !(Number.isInteger(ps.sector_erase_time_us) && ps.sector_erase_time_us >= 0 && ps.sector_erase_time_us <= 4294967295)) push(errors, 'Sector erase time should be an integer between 0 and 4294967295');
+        if (ps.completion_queue_size !== undefined && !(Number.isInteger(ps.completion_queue_size) && ps.completion_queue_size >= 0 && ps.completion_queue_size <= 255)) push(errors, 'Completion queue size should be an integer between 0 and 255');
+        if (ps.seqlock_read_attempts !== undefined && !(Number.isInteger(ps.seqlock_read_attempts) && ps.seqlock_read_attempts >= 0 && ps.seqlock_read_attempts <= 65535)) push(errors, 'Seqlock read attempts should be an integer between 0 and 65535');
+        if (ps.streaming_chunk_size !== undefined && !(Number.isInteger(ps.streaming_chunk_size) && ps.streaming_chunk_size >= 0 && ps.streaming_chunk_size <= 65535)) push(errors, 'Streaming chunk size should be an integer between 0 and 65535');
+        for (const d of (ps.devices || [])) {
+            if (!is_valid_identifier(d.name || '')) push(errors, `Device '${d.name}' has invalid name`);
+            if (!is_valid_identifier(d.eeaif_prefix || '') || d.eeaif_prefix === 'EEAIF') push(errors, `Device '${d.name}' has invalid 'eeaif_prefix'`);
+            if (d.eeprom_page_size < 0 || (d.eeprom_page_size > 0 && !is_power_of_2(d.eeprom_page_size))) push(errors, `Device '${d.name}' page size should be 0 or positive power of 2`);
+        }
+        if (get_duplicate_names(ps.devices || []).length > 0) push(errors, 'Device names must be unique');
         if (ps.external_headers && ps.external_headers.some(h => !is_valid_filename(h))) push(errors, 'Some external headers have invalid file name');
         if (ps.enter_critical_section_operation && !is_valid_identifier(ps.enter_critical_section_operation)) push(errors, "'enter_critical_section_operation' is not a valid C-language identifier");
         if (ps.exit_critical_section_operation && !is_valid_identifier(ps.exit_critical_section_operation)) push(errors, "'exit_critical_section_operation' is not a valid C-language identifier");
+        if (ps.memory_barrier_operation && !is_valid_identifier(ps.memory_barrier_operation)) push(errors, "'memory_barrier_operation' is not a valid C-language identifier");
+        if (ps.seqlock_wait_operation && !is_valid_identifier(ps.seqlock_wait_operation)) push(errors, "'seqlock_wait_operation' is not a valid C-language identifier");
         if (ps.compiler_directives && ps.compiler_directives.pack_attribute && (ps.compiler_directives.opening_pack_directive || ps.compiler_directives.closing_pack_directive)) push(errors, 'You cannot have both compiler pack directive and attr defined at the same time');
     }
 
@@ -653,6 +765,20 @@ function validateAll() {
     const duplicate_blocks = get_duplicate_names(all_blocks);
     if (duplicate_blocks.length > 0) push(errors, 'Found blocks with duplicate names: ' + duplicate_blocks.join(','));
 
+    if (ps && ps.streaming_chunk_size > 0) {
+        if (ps.streaming_chunk_size < (dm.checksum_size || 1) + 2) push(errors, `Streaming chunk size should be at least ${(dm.checksum_size || 1) + 2} bytes - a checksum and some data`);
+        if (all_blocks.some(b => b.transactional)) push(errors, 'Streaming I/O can\'t be used with transactional blocks');
+        if ((ps.write_batch_size > 0) && all_blocks.filter(b => b.management_type === ManagementTypes.Basic).length > 1) push(errors, 'Streaming I/O can\'t be used with write batching');
+        if (all_blocks.some(b => b.management_type === ManagementTypes.FlashEmulation)) push(errors, 'Streaming I/O can\'t be used with flash emulation blocks');
+        all_blocks.filter(b => (b.management_type === ManagementTypes.ReadThrough) && (ps.streaming_chunk_size < (dm.checksum_size || 1) + b.chunk_size)).forEach(b =>
+            push(errors, `Block '${b.name}' is a read-through block, whose chunks must fit in the work buffer. Set 'streaming_chunk_size' to at least ${(dm.checksum_size || 1) + b.chunk_size} bytes.`));
+    }
+    if (ps && ps.zero_copy_writes) {
+        if (!ps.seqlock_reads) push(errors, 'Zero-copy writes require tear-free reads (seqlock_reads)');
+        if ((ps.write_batch_size > 0) && all_blocks.filter(b => b.management_type === ManagementTypes.Basic).length > 1) push(errors, 'Zero-copy writes can\'t be used with write batching');
+        if (all_blocks.some(b => b.management_type === ManagementTypes.FlashEmulation)) push(errors, 'Zero-copy writes can\'t be used with flash emulation blocks');
+    }
+
     for (let bi = 0; bi < all_blocks.length; bi++) {
         const block = all_blocks[bi];
         const blockPath = [bi];
@@ -913,7 +1039,12 @@ function serializePlatform() {
         ? state.dataModel.children.map(block => block.name || '').filter(name => name)
         : [];
 
-    if (allBlockNames.length > 0) {
+    if (allBlockNames.length > 0 && platformCopy.optimize_layout) {
+        // With optimize_layout, '*' forces no block to a page boundary, so the wildcard and the listed names mean different things: keep both
+        const alignedBlocks = platformCopy.page_aligned_blocks || [];
+        const listedBlocks = alignedBlocks.filter(name => allBlockNames.includes(name));
+        platformCopy.page_aligned_blocks = alignedBlocks.includes('*') ? ['*', ...listedBlocks] : listedBlocks;
+    } else if (allBlockNames.length > 0) {
         const alignedBlocks = platformCopy.page_aligned_blocks || [];
         const hasWildcard = alignedBlocks.includes('*');
 
@@ -1710,7 +1841,7 @@ function renderProps() {
     }
     // For each property except children - show inputs
     for (const key in node) {
-        if (key === 'children' || key === 'default_pattern' || key === 'offset_in_eeprom' || key === 'size_in_eeprom' || key === 'multiplicity') continue;
+        if (key === 'children' || key === 'default_pattern' || key === 'encoded_defaults' || key === 'offset_in_eeprom' || key === 'size_in_eeprom' || key === 'journal_offset' || key === 'multiplicity') continue;
         const val = node[key]; const prop = document.createElement('div'); prop.className = 'prop'; const label = document.createElement('label'); label.textContent = formatLabel(key);
         // Add tooltip from FieldDocs based on node type
         if (FieldDocs[type] && FieldDocs[type][key]) {
@@ -1758,6 +1889,8 @@ function renderProps() {
                     // enforce instance_count defaults
                     if (node.management_type === ManagementTypes.Basic) node.instance_count = 1;
                     if (node.management_type === ManagementTypes.BackupCopy) node.instance_count = 2;
+                    if (node.management_type === ManagementTypes.ReadThrough) node.instance_count = 1;
+                    if (node.management_type === ManagementTypes.MemoryMapped) { node.instance_count = 1; node.data_recovery_strategy = 1; }
                     setStatus('block management_type changed');
                     renderTree(); renderProps();
                 });
@@ -1770,14 +1903,14 @@ function renderProps() {
                 const mt = node.management_type;
                 if (mt === ManagementTypes.Basic) { num.min = 1; num.max = 1; num.value = 1; num.disabled = true; }
                 else if (mt === ManagementTypes.BackupCopy) { num.min = 2; num.max = 2; num.value = 2; num.disabled = true; }
-                else { num.min = 2; num.max = 15; num.value = Math.max(2, Math.min(15, node.instance_count || 2)); num.disabled = false; }
+                else { num.min = 2; num.max = MaxInstanceCounts[mt]; num.value = Math.max(2, Math.min(MaxInstanceCounts[mt], node.instance_count || 2)); num.disabled = false; }
                 num.addEventListener('change', () => {
                     let nv = Number(num.value);
                     if (!Number.isFinite(nv)) nv = Number(num.defaultValue) || 1;
                     nv = Math.trunc(nv);
                     if (mt === ManagementTypes.Basic) nv = 1;
                     else if (mt === ManagementTypes.BackupCopy) nv = 2;
-                    else { if (nv < 2) nv = 2; if (nv > 15) nv = 15; }
+                    else { if (nv < 2) nv = 2; if (nv > MaxInstanceCounts[mt]) nv = MaxInstanceCounts[mt]; }
                     node.instance_count = nv; num.value = nv; setStatus('block instance_count changed');
                 });
                 prop.appendChild(num);
@@ -2122,10 +2255,11 @@ function renderProps() {
         const bsName = node.name || '';
         const paDiv = document.createElement('div'); paDiv.className = 'prop'; const paLabel = document.createElement('label'); paLabel.textContent = formatLabel('page_aligned'); paDiv.appendChild(paLabel);
         const paCb = document.createElement('input'); paCb.type = 'checkbox';
-        paCb.checked = (state.platformSettings.page_aligned_blocks || []).includes(bsName) || (state.platformSettings.page_aligned_blocks || []).includes('*');
+        // With optimize_layout, '*' forces no block to a page boundary: only the blocks listed by name are always aligned
+        paCb.checked = (state.platformSettings.page_aligned_blocks || []).includes(bsName) || (!state.platformSettings.optimize_layout && (state.platformSettings.page_aligned_blocks || []).includes('*'));
         paCb.addEventListener('change', () => {
             let list = state.platformSettings.page_aligned_blocks || [];
-            const hasWildcard = list.includes('*');
+            const hasWildcard = list.includes('*') && !state.platformSettings.optimize_layout;
 
             // Get all block names
             const allBlockNames = (state.dataModel && state.dataModel.children)
@@ -2142,7 +2276,7 @@ function renderProps() {
                         list.push(bsName);
                     }
                     // Check if all blocks are now aligned
-                    if (list.length === allBlockNames.length && allBlockNames.length > 0) {
+                    if (list.length === allBlockNames.length && allBlockNames.length > 0 && !state.platformSettings.optimize_layout) {
                         list = ['*'];
                     }
                 }
@@ -2245,7 +2379,7 @@ function renderPlatformSettings() {
         };
     }
 
-    for (const key of ['endianness', 'eeprom_size', 'eeprom_page_size', 'external_headers', 'enter_critical_section_operation', 'exit_critical_section_operation', 'opening_pack_directive', 'closing_pack_directive', 'pack_attribute']) {
+    for (const key of ['endianness', 'eeprom_size', 'eeprom_page_size', 'page_write_time_us', 'flash_sector_size', 'sector_erase_time_us', 'task_period_ms', 'scrub_bytes_per_second', 'lazy_backup_verification', 'lock_free_requests', 'seqlock_reads', 'seqlock_read_attempts', 'skip_unchanged_writes', 'write_batch_size', 'write_tickets', 'completion_queue_size', 'streaming_chunk_size', 'zero_copy_writes', 'specialized_core', 'aligned_caches', 'optimize_layout', 'keep_block_order', 'external_headers', 'enter_critical_section_operation', 'exit_critical_section_operation', 'memory_barrier_operation', 'seqlock_wait_operation', 'opening_pack_directive', 'closing_pack_directive', 'pack_attribute']) {
         const label = document.createElement('div');
 
         // Handle compiler directive fields specially
@@ -2268,13 +2402,13 @@ function renderPlatformSettings() {
         else if (Array.isArray(ps[key])) { const t = document.createElement('textarea'); t.style.width = '100%'; t.style.height = '80px'; t.value = ps[key].join('\n'); t.addEventListener('change', () => { ps[key] = t.value.split(/\r?\n/).filter(r => r.trim()); setStatus(key + ' changed') }); valWrap.appendChild(t) }
         else {
             if (key === 'eeprom_size') {
-                const inp = document.createElement('input'); inp.type = 'number'; inp.min = 64; inp.max = 65536; inp.value = Number(ps[key] || 256);
+                const inp = document.createElement('input'); inp.type = 'number'; inp.min = 64; inp.max = 4294967295; inp.value = Number(ps[key] || 256);
                 inp.addEventListener('change', () => {
                     let nv = Number(inp.value);
                     if (!Number.isFinite(nv)) nv = 64;
                     nv = Math.trunc(nv);
                     if (nv < 64) nv = 64;
-                    if (nv > 65536) nv = 65536;
+                    if (nv > 4294967295) nv = 4294967295;
                     inp.value = nv;
                     ps[key] = nv; setStatus(key + ' changed');
                 });
@@ -2291,6 +2425,22 @@ function renderPlatformSettings() {
                 });
                 valWrap.appendChild(wrap);
             }
+            else if (key === 'lazy_backup_verification' || key === 'lock_free_requests' || key === 'seqlock_reads' || key === 'skip_unchanged_writes' || key === 'write_tickets' || key === 'zero_copy_writes' || key === 'specialized_core' || key === 'aligned_caches' || key === 'optimize_layout' || key === 'keep_block_order') {
+                const cb = document.createElement('input'); cb.type = 'checkbox'; cb.checked = Boolean(ps[key]);
+                cb.addEventListener('change', () => { ps[key] = cb.checked; setStatus(key + ' changed') });
+                valWrap.appendChild(cb);
+            }
+            else if (key === 'task_period_ms' || key === 'scrub_bytes_per_second' || key === 'seqlock_read_attempts' || key === 'write_batch_size' || key === 'completion_queue_size' || key === 'streaming_chunk_size' || key === 'page_write_time_us' || key === 'flash_sector_size' || key === 'sector_erase_time_us') {
+                const minVal = (key === 'task_period_ms') ? 1 : 0;
+                const inp = document.createElement('input'); inp.type = 'number'; inp.min = minVal; inp.value = Number(ps[key] ?? makeDefaultPlatform()[key]);
+                inp.addEventListener('change', () => {
+                    let nv = Math.trunc(Number(inp.value));
+                    if (!Number.isFinite(nv) || nv < minVal) nv = minVal;
+                    inp.value = nv;
+                    ps[key] = nv; setStatus(key + ' changed');
+                });
+                valWrap.appendChild(inp);
+            }
             else {
                 const inp = document.createElement('input');
                 inp.type = 'text';
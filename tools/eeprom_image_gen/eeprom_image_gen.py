@@ -9,7 +9,7 @@ from colorama import Fore
 from bincopy import BinFile
 from common.data_model import *
 from common.platform_settings import *
-from common.utils import attach_block_metadata, extract_defaults
+from common.utils import attach_block_metadata, extract_defaults, get_chunk_layout, get_device_id_by_name, get_device_eeprom_size, select_device_blocks
 from common.checksum_algo import *
 
 
@@ -35,18 +35,27 @@ def create_instance_image(block: Block, settings: PlatformSettings) -> bytearray
     defaults = extract_defaults(block, settings)
     bytes.append(checksum_algo.calculate(defaults))
 
-    if block.management_type == Block.ManagementTypes.WearLeveling:
+    if block.has_sequence_counter:
         bytes.append(0)  # Add a sequence counter
 
     bytes.extend(defaults)
     return bytes
 
 
-def create_bin_file(datamodel: DataModel, settings: PlatformSettings, base_address: int, fill: bytes) -> BinFile:
-    """Creates a BinFile, containing all data."""
+def create_bin_file(datamodel: DataModel, settings: PlatformSettings, base_address: int, fill: bytes, device_id: int = 0) -> BinFile:
+    """Creates a BinFile, containing all data of the device's blocks."""
     bf = BinFile(word_size_bits=8)
 
     for block in datamodel.children:
+        if block.management_type == Block.ManagementTypes.ReadThrough:
+            # Read-through blocks have a checksum per chunk
+            defaults = extract_defaults(block, settings)
+            for offset, position, size in get_chunk_layout(block, datamodel):
+                chunk = bytearray([checksum_algo.calculate(defaults[position : position + size])])
+                chunk.extend(defaults[position : position + size])
+                bf.add_binary(data=chunk, address=base_address + offset)  # type: ignore[call-arg]
+            continue
+
         instance = create_instance_image(block, settings)
         bf.add_binary(data=instance, address=base_address + block.offset_in_eeprom)  # type: ignore[call-arg]
 
@@ -54,7 +63,7 @@ def create_bin_file(datamodel: DataModel, settings: PlatformSettings, base_addre
             # Backup copy blocks must have both instances valid
             bf.add_binary(data=instance, address=base_address + block.offset_in_eeprom + len(instance))  # type: ignore[call-arg]
 
-    bf.fill(value=fill, max_words=settings.eeprom_size)
+    bf.fill(value=fill, max_words=get_device_eeprom_size(device_id, settings))
     return bf
 
 
@@ -70,6 +79,7 @@ if __name__ == "__main__":
     parser.add_argument("-a", "--address", default="0", help="Base address of the generated image (default: 0)")
     parser.add_argument("-f", "--fill", default="0xFF", help="Fill pattern for unused EEPROM space (default: 0xFF)")
     parser.add_argument("-o", "--output", default="./", help="Output directory for generated image (default: ./)")
+    parser.add_argument("-d", "--device", default=None, help="EEPROM device, whose image is generated (default: the primary one)")
 
     args = parser.parse_args()
 
@@ -79,10 +89,14 @@ if __name__ == "__main__":
         checksum_params = load_checksum_params(args.checksum_params)
 
         attach_block_metadata(datamodel=dataModel, settings=settings)
+        device_id = get_device_id_by_name(args.device, settings)
+        select_device_blocks(datamodel=dataModel, device_id=device_id)
         checksum_algo = ChecksumAlgorithm(checksum_params)
-        binFile = create_bin_file(datamodel=dataModel, settings=settings, base_address=parse_base_address(args.address), fill=parse_fill(args.fill))
+        binFile = create_bin_file(
+            datamodel=dataModel, settings=settings, base_address=parse_base_address(args.address), fill=parse_fill(args.fill), device_id=device_id
+        )
 
-        image_path = os.path.join(args.output, "eeprom.hex")
+        image_path = os.path.join(args.output, "eeprom.hex" if device_id == 0 else f"eeprom_{args.device}.hex")
         with open(image_path, "w") as f:
             f.write(binFile.as_ihex())
 
@@ -9,7 +9,7 @@ sys.path.append(os.path.dirname(os.path.dirname(__file__)))
 from colorama import Fore
 from common.data_model import *
 from common.platform_settings import *
-from common.utils import attach_block_metadata
+from common.utils import attach_block_metadata, get_device_id_by_name, select_device_blocks
 from common.checksum_algo import *
 from report_builder import ReportBuilder
 
@@ -35,9 +35,8 @@ def load_checksum_params(path: str) -> dict:
 def validate(datamodel: DataModel, eeprom_image: bytearray | bytes):
     assert dataModel.children[0].offset_in_eeprom is not None, "'utils.attach_block_metadata()' should be already called at this point!"
 
-    last_block: Block = datamodel.children[-1]
     eeprom_size: int = len(eeprom_image)
-    datamodel_size: int = last_block.offset_in_eeprom + last_block.size_in_eeprom  # type:ignore
+    datamodel_size: int = max(b.offset_in_eeprom + b.size_in_eeprom for b in datamodel.children)  # type:ignore
 
     if eeprom_size < datamodel_size:
         raise Exception(f"Size of provided EEPROM image ({eeprom_size} bytes) is insufficient for this Data model (requiring {datamodel_size} bytes)!")
@@ -51,6 +50,7 @@ if __name__ == "__main__":
     parser.add_argument("settings", help="Path to the platform_settings.json file")
     parser.add_argument("checksum_params", help="Path to checksum_parameters.json file")
     parser.add_argument("-o", "--output", default="./report.html", help="Output file path. Defaults to './report.html' if not specified")
+    parser.add_argument("-d", "--device", default=None, help="EEPROM device, whose dump is inspected. Defaults to the primary one if not specified")
 
     args = parser.parse_args()
 
@@ -68,6 +68,7 @@ if __name__ == "__main__":
         }
 
         attach_block_metadata(datamodel=dataModel, settings=settings)
+        select_device_blocks(datamodel=dataModel, device_id=get_device_id_by_name(args.device, settings))
         validate(datamodel=dataModel, eeprom_image=eeprom_image)
         report = ReportBuilder(
             datamodel=dataModel, settings=settings, eeprom_image=eeprom_image, checksum_algo=ChecksumAlgorithm(params=checksum_params), paths=paths
@@ -11,7 +11,7 @@ from tzlocal import get_localzone
 from dataclasses import dataclass
 from common.data_model import *
 from common.platform_settings import *
-from common.utils import param_type_to_format, attach_block_metadata, find_index_of_most_recent_sequence_counter
+from common.utils import param_type_to_format, attach_block_metadata, find_index_of_most_recent_sequence_counter, get_chunk_layout, get_instance_offsets
 from common.checksum_algo import *
 from view_types import BlockView, InstanceView, ParameterView, NumView
 
@@ -25,6 +25,7 @@ class ReportBuilder:
         self.eeprom: bytes = bytes(eeprom_image)
         self.checksum_algo = checksum_algo
         self.paths: Dict[str, str] = paths
+        self.address_digits: int = 4 if len(self.eeprom) <= 0x10000 else 8
 
     def create_report(self) -> str:
         templateEnv = Environment(loader=FileSystemLoader(searchpath=os.path.dirname(__file__)), trim_blocks=True)
@@ -46,10 +47,26 @@ class ReportBuilder:
             Block.ManagementTypes.BackupCopy: "Backup copy",
             Block.ManagementTypes.MultiProfile: "Multi-profile",
             Block.ManagementTypes.WearLeveling: "Wear-leveling",
+            Block.ManagementTypes.FlashEmulation: "Flash emulation",
+            Block.ManagementTypes.ReadThrough: "Read-through",
+            Block.ManagementTypes.MemoryMapped: "Memory-mapped",
         }
         blockViews: List[BlockView] = []
 
         for block in self.datamodel.children:
+            if block.management_type == Block.ManagementTypes.ReadThrough:
+                blockViews.append(
+                    BlockView(
+                        name=block.name,
+                        management_type=to_bv_management_type[block.management_type],
+                        description=block.description if block.description else "",
+                        instance_count=1,
+                        total_size=block.size_in_eeprom,  # type:ignore[assignment]
+                        params=self._create_read_through_param_views(block),
+                    )
+                )
+                continue
+
             offset = block.offset_in_eeprom
             paramViews: List[ParameterView] = []
             checksum_instances = self._collect_checksum_instances(block=block)
@@ -64,7 +81,7 @@ class ReportBuilder:
             )
             offset += self.datamodel.checksum_size  # type:ignore[assignment]
 
-            if block.management_type == Block.ManagementTypes.WearLeveling:
+            if block.has_sequence_counter:
                 paramViews.append(
                     ParameterView(
                         data_type=Parameter.DataTypes.uint8.name,
@@ -91,23 +108,71 @@ class ReportBuilder:
                     name=block.name,
                     management_type=to_bv_management_type[block.management_type],
                     description=block.description if block.description else "",
-                    instance_count=block.instance_count,
+                    instance_count=len(get_instance_offsets(block, self.datamodel)),
                     total_size=block.size_in_eeprom,  # type:ignore[assignment]
                     params=paramViews,
                 )
             )
         return blockViews
 
+    def _create_read_through_param_views(self, block: Block) -> List[ParameterView]:
+        """Read-through blocks have a single instance, split into chunks. The checksums of all chunks are shown as one array,
+        valid only if all chunks are valid. The parameters are gathered from the chunks' data, but keep their addresses."""
+        chunks = get_chunk_layout(block, self.datamodel)
+        checksum_type = self._get_checksum_type()
+        checksums: List[NumView] = []
+        data = bytearray()
+        is_valid = True
+
+        for offset, _, size in chunks:
+            checksums.append(self._create_num_view(self.eeprom[offset : offset + checksum_type.size], checksum_type, offset))
+            chunk_data = self.eeprom[offset + checksum_type.size : offset + checksum_type.size + size]
+            is_valid = is_valid and (self.checksum_algo.calculate(chunk_data) == int(checksums[-1].value_dec))
+            data.extend(chunk_data)
+
+        paramViews = [
+            ParameterView(
+                name="Checksum ",
+                data_type=checksum_type.name,
+                description="Actual checksums of all chunks",
+                instances=[InstanceView(data=checksums, is_valid=is_valid, is_most_recent=False)],
+            )
+        ]
+        position = 0
+
+        for param in block.children:
+            num_array: List[NumView] = []
+            for _ in range(0, param.multiplicity):
+                chunk_offset, chunk_position, _ = chunks[position // block.chunk_size]  # type:ignore[operator]
+                address = chunk_offset + checksum_type.size + (position - chunk_position)
+                num_array.append(self._create_num_view(bytes(data[position : position + param.data_type.size]), param.data_type, address))
+                position += param.data_type.size
+            paramViews.append(
+                ParameterView(
+                    name=param.name,
+                    data_type=param.data_type.name,
+                    description=param.description if param.description else "",
+                    instances=[InstanceView(data=num_array, is_valid=is_valid, is_most_recent=False)],
+                )
+            )
+        return paramViews
+
+    def _create_num_view(self, raw: bytes, data_type: Parameter.DataTypes, address: int) -> NumView:
+        fmt = f'{">" if self.settings.endianness == "big" else "<"}{param_type_to_format[data_type]}'
+        return NumView(
+            value_dec=str(struct.unpack(fmt, raw)[0]),
+            value_hex=f"0x{bytes(reversed(raw)).hex().upper()}",
+            address=f"0x{address:0{self.address_digits}X}",
+        )
+
     def _collect_checksum_instances(self, block: Block) -> List[InstanceView]:
         ci = self._collect_data_instances(block, block.offset_in_eeprom, self._get_checksum_type())  # type:ignore
-        offset = block.offset_in_eeprom + self.datamodel.checksum_size  # type:ignore[assignment]
-        step = block.data_size + self.datamodel.checksum_size
 
-        for instance in ci:
+        for instance, instance_offset in zip(ci, get_instance_offsets(block, self.datamodel)):
+            offset = instance_offset + self.datamodel.checksum_size
             calculated = self.checksum_algo.calculate(self.eeprom[offset : offset + block.data_size])
             raw = int(instance.data[0].value_dec)
             instance.is_valid = calculated == raw
-            offset += step
 
         return ci
 
@@ -126,24 +191,22 @@ class ReportBuilder:
         return sci
 
     def _collect_data_instances(self, block: Block, offset: int, data_type: Parameter.DataTypes, multiplicity: int = 1) -> List[InstanceView]:
-        """Collects values from all instances, starting at given initial offset. All values are regarded as arrays, no matter their multiplicity."""
+        """Collects values from all instances, at given offset within the first one. All values are regarded as arrays, no matter their multiplicity."""
         instances: List[InstanceView] = []
-        step: int = block.data_size + self.datamodel.checksum_size
 
-        for _ in range(0, block.instance_count):
+        for instance_offset in get_instance_offsets(block, self.datamodel):
             num_array: List[NumView] = []
-            offs = offset
+            offs = instance_offset + (offset - block.offset_in_eeprom)  # type:ignore[operator]
             for _ in range(0, multiplicity):
                 num_array.append(
                     NumView(
                         value_dec=str(self._get_normal_value(offs, data_type)),
                         value_hex=f"0x{bytes(reversed(self._get_raw_value(offs, data_type))).hex().upper()}",
-                        address=f"0x{offs:04X}",
+                        address=f"0x{offs:0{self.address_digits}X}",
                     )
                 )
                 offs += data_type.size
             instances.append(InstanceView(data=num_array, is_valid=True, is_most_recent=False))
-            offset += step
         return instances
 
     def _get_raw_value(self, offset: int, data_type: Parameter.DataTypes) -> bytes:
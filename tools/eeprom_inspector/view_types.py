@@ -28,7 +28,7 @@ class ParameterView:
 
 @dataclass
 class BlockView:
-    ManagementTypes = Literal["Basic", "Backup copy", "Multi-profile", "Wear-leveling"]
+    ManagementTypes = Literal["Basic", "Backup copy", "Multi-profile", "Wear-leveling", "Flash emulation", "Read-through", "Memory-mapped"]
 
     name: str
     management_type: ManagementTypes
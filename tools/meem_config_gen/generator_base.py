@@ -35,9 +35,9 @@ class CodeGenerator(ABC):
         file_name: str,
         file_content: str,
     ) -> str:
-        """Produces final source file (.c or .h) by incorporating timestamp,multiple inclusion protection macro and file content."""
+        """Produces final source file (.c, .h or .hpp) by incorporating timestamp,multiple inclusion protection macro and file content."""
 
-        is_header = file_name.lower().endswith(".h")
+        is_header = file_name.lower().endswith((".h", ".hpp"))
         txt = self.generate_file_header(file_name, config_name) + "\n"
 
         if is_header:
@@ -3,10 +3,12 @@ import sys
 
 sys.path.append(os.path.dirname(__file__))
 sys.path.append(os.path.dirname(os.path.dirname(__file__)))
-from typing import Dict, List
+from typing import Dict, List, Optional
 from datetime import datetime
 from common.data_model import *
 from common.platform_settings import PlatformSettings
+from common.utils import get_write_behind_delay_ticks, get_coalescing_window_ticks, get_write_budget_period_ticks
+from common.utils import get_transaction_record_size, get_transaction_record_offset, get_used_eeprom_size, get_device_eeprom_size, get_physical_instance_count
 from generator_base import CodeGenerator
 
 
@@ -23,6 +25,12 @@ class CodeGen_MEEM(CodeGenerator):
                 return "MEEM_MGMT_MULTI_PROFILE"
             if mt == Block.ManagementTypes.WearLeveling:
                 return "MEEM_MGMT_WEAR_LEVELING"
+            if mt == Block.ManagementTypes.FlashEmulation:
+                return "MEEM_MGMT_FLASH_EMULATION"
+            if mt == Block.ManagementTypes.ReadThrough:
+                return "MEEM_MGMT_READ_THROUGH"
+            if mt == Block.ManagementTypes.MemoryMapped:
+                return "MEEM_MGMT_MEMORY_MAPPED"
             raise Exception(f"Not implemented item in {mt.__name__}!")
 
         def data_recovery_startegy_to_string(drs: Block.DataRecoveryStrategies) -> str:
@@ -88,17 +96,22 @@ class CodeGen_MEEM(CodeGenerator):
             "MEEM_GenInterface.c",
             self.generate_MEEM_GenInterface_c(),
         )
+        meem_gen_interface_hpp = self.compose_file(
+            self._datamodel.name,
+            "MEEM_GenInterface.hpp",
+            self.generate_MEEM_GenInterface_hpp(),
+        )
 
         return {
             "MEEM_GenConfig.h": meem_gen_config_h,
             "MEEM_GenConfig.c": meem_gen_config_c,
             "MEEM_GenInterface.h": meem_gen_interface_h,
             "MEEM_GenInterface.c": meem_gen_interface_c,
+            "MEEM_GenInterface.hpp": meem_gen_interface_hpp,
         }
 
     def generate_MEEM_GenConfig_h(self) -> str:
         hdr_strip_syms = ' "<>'
-        last_block = self._datamodel.children[-1]
 
         txt = self.to_comment_box("   Dependencies", self.TextAlignment.Left) + "\n"
         txt += "#include <stdbool.h>\n"
@@ -116,31 +129,82 @@ class CodeGen_MEEM(CodeGenerator):
 
         txt += f"#define MEEM_GEN_TIMESTAMP             0x{self.generate_timestamp():08X}UL\n"
         txt += f"#define MEEM_AVAILABLE_EEPROM_BYTES    {self._settings.eeprom_size}U\n"
-        txt += f"#define MEEM_USED_EEPROM_BYTES         {last_block.offset_in_eeprom + last_block.size_in_eeprom}U\n"  # type:ignore
+        txt += f"#define MEEM_USED_EEPROM_BYTES         {get_used_eeprom_size(self._datamodel)}U\n"
         txt += "\n"
         txt += f"#define MEEM_BLOCK_COUNT               {len(self._datamodel.children)}\n"
         txt += f"#define MEEM_WORKBUFFER_SIZE           {self.calculate_workbuffer_size()}\n"
         txt += f"#define MEEM_MAX_WL_INSTANCE_COUNT     {self.get_max_wl_instance_count()}\n"
+        txt += f"#define MEEM_TASK_PERIOD_MS            {self._settings.task_period_ms}U\n"
+        txt += f"#define MEEM_SCRUB_BYTES_PER_SECOND    {self._settings.scrub_bytes_per_second}UL\n"
+        txt += f"#define MEEM_TRANSACTION_RECORD_OFFSET {self.to_str(get_transaction_record_offset(self._datamodel) or 0)}U\n"
+        txt += f"#define MEEM_WRITE_BATCH_SIZE          {self.to_str(self._settings.write_batch_size if self.is_write_batching_used() else 0)}U\n"
+        txt += f"#define MEEM_COMPLETION_QUEUE_SIZE     {self.to_str(self._settings.completion_queue_size)}U\n"
+        txt += f"#define MEEM_SEQLOCK_READ_ATTEMPTS     {self.to_str(self._settings.seqlock_read_attempts)}U\n"
+        txt += f"#define MEEM_EEPROM_PAGE_SIZE          {self.to_str(self._settings.eeprom_page_size)}U\n"
+        txt += f"#define MEEM_PAGE_WRITE_TIME_US        {self.to_str(self._settings.page_write_time_us)}UL\n"
+        txt += f"#define MEEM_FLASH_SECTOR_SIZE         {self.to_str(self._settings.flash_sector_size)}UL\n"
+        txt += f"#define MEEM_SECTOR_ERASE_TIME_US      {self.to_str(self._settings.sector_erase_time_us)}UL\n"
+        txt += f"#define MEEM_LARGEST_IMAGE_SIZE        {self.to_str(self.get_largest_image_size())}U\n"
+        txt += f"#define MEEM_DEVICE_COUNT              {len(self._settings.devices) + 1}U\n"
+        for device_id, device in enumerate(self._settings.devices, start=1):
+            txt += f"#define MEEM_DEVICE_{device.name}_ID    {device_id}U\n"
+            txt += f"#define MEEM_DEVICE_{device.name}_AVAILABLE_BYTES    {device.eeprom_size}U\n"
+            txt += f"#define MEEM_DEVICE_{device.name}_USED_BYTES    {get_used_eeprom_size(self._datamodel, device_id)}U\n"
         txt += "\n"
         txt += "/* Internal optimizations control */\n"
         txt += f"#define MEEM_USING_BASIC_BLOCKS            {str(any([b for b in self._datamodel.children if b.management_type == Block.ManagementTypes.Basic])).lower()}\n"
         txt += f"#define MEEM_USING_BACKUP_COPY_BLOCKS      {str(any([b for b in self._datamodel.children if b.management_type == Block.ManagementTypes.BackupCopy])).lower()}\n"
         txt += f"#define MEEM_USING_MULTI_PROFILE_BLOCKS    {str(any([b for b in self._datamodel.children if b.management_type == Block.ManagementTypes.MultiProfile])).lower()}\n"
         txt += f"#define MEEM_USING_WEAR_LEVELING_BLOCKS    {str(any([b for b in self._datamodel.children if b.management_type == Block.ManagementTypes.WearLeveling])).lower()}\n"
+        txt += f"#define MEEM_USING_FLASH_EMULATION_BLOCKS  {str(self.is_flash_emulation_used()).lower()}\n"
+        txt += f"#define MEEM_USING_READ_THROUGH_BLOCKS     {str(self.is_read_through_used()).lower()}\n"
+        txt += f"#define MEEM_USING_MEMORY_MAPPED_BLOCKS    {str(self.is_memory_mapped_used()).lower()}\n"
+        txt += f"#define MEEM_USING_WIDE_PROFILE_INDEX      {str(self.get_max_instance_count() > Block.MAX_NARROW_INSTANCE_COUNT).lower()}\n"
+        txt += f"#define MEEM_USING_SCRUBBING               {str(self._settings.scrub_bytes_per_second > 0).lower()}\n"
+        txt += f"#define MEEM_USING_LOCK_FREE_REQUESTS      {str(self._settings.lock_free_requests).lower()}\n"
+        txt += f"#define MEEM_USING_SEQLOCK                 {str(self._settings.seqlock_reads).lower()}\n"
+        txt += f"#define MEEM_USING_WRITE_SKIPPING          {str(self._settings.skip_unchanged_writes).lower()}\n"
+        txt += f"#define MEEM_USING_WRITE_BEHIND            {str(self.is_write_behind_used()).lower()}\n"
+        txt += f"#define MEEM_USING_WRITE_THROTTLING        {str(self.is_write_throttling_used()).lower()}\n"
+        txt += f"#define MEEM_USING_TRANSACTIONS            {str(self.is_transactions_used()).lower()}\n"
+        txt += f"#define MEEM_USING_WRITE_BATCHING          {str(self.is_write_batching_used()).lower()}\n"
+        txt += f"#define MEEM_USING_WRITE_TICKETS           {str(self._settings.write_tickets or (self._settings.completion_queue_size > 0)).lower()}\n"
+        txt += f"#define MEEM_USING_COMPLETION_QUEUE        {str(self._settings.completion_queue_size > 0).lower()}\n"
+        txt += f"#define MEEM_USING_FLUSH_PLANNER           {str(self.is_flush_planner_used()).lower()}\n"
+        txt += f"#define MEEM_USING_MULTIPLE_DEVICES        {str(self.is_multiple_devices_used()).lower()}\n"
+        txt += f"#define MEEM_USING_32BIT_ADDRESSING        {str(self.is_32bit_addressing_used()).lower()}\n"
+        txt += f"#define MEEM_USING_STREAMING_IO            {str(self._settings.streaming_chunk_size > 0).lower()}\n"
+        txt += f"#define MEEM_USING_STREAMED_WRITES         {str((self._settings.streaming_chunk_size > 0) and not self._settings.zero_copy_writes).lower()}\n"
+        txt += f"#define MEEM_USING_ZERO_COPY_WRITES        {str(self._settings.zero_copy_writes).lower()}\n"
+        txt += f"#define MEEM_USING_LAZY_BACKUP_VERIFY      {str(self._settings.lazy_backup_verification and any([b for b in self._datamodel.children if b.management_type == Block.ManagementTypes.BackupCopy])).lower()}\n"
+        txt += f"#define MEEM_USING_RUN_LENGTH_DEFAULTS     {str(self.is_run_length_defaults_used()).lower()}\n"
+        txt += f"#define MEEM_USING_SPECIALIZED_CORE        {str(self._settings.specialized_core).lower()}\n"
+        txt += f"#define MEEM_USING_ALIGNED_CACHES          {str(self.is_aligned_caches_used()).lower()}\n"
         txt += "\n"
 
+        if self._settings.specialized_core:
+            txt += "/* Core specialization. Configuration, which is the same for all blocks, is folded into constants. */\n"
+            txt += self.generate_core_specialization() + "\n"
+
         txt += "/* Externals */\n"
         txt += self.generate_wrappers_of_external_operations() + "\n"
 
         txt += self.to_comment_box("   Types", self.TextAlignment.Left) + "\n"
         txt += f"typedef {str(self.get_checksum_data_type())}    MEEM_checksum_t;\n"
+        txt += f"typedef {self.get_address_data_type()}    MEEM_eepromOffset_t;\n"
+        txt += f"typedef {self.get_address_data_type()}    MEEM_eepromSize_t;\n"
         txt += "\n"
 
+        for block in [b for b in self._datamodel.children if self.is_aligned_cache(b)]:
+            txt += self.generate_block_type(block, f"MEEM_params_{block.name}_t", False) + "\n"
+
         if self._settings.compiler_directives.opening_pack_directive:
             txt += self._settings.compiler_directives.opening_pack_directive + "\n"
 
         for block in self._datamodel.children:
-            txt += self.generate_block_type(block) + "\n"
+            txt += self.generate_block_type(block, self.get_image_type_name(block), True) + "\n"
+            if self._settings.zero_copy_writes and block.is_cached:
+                txt += self.generate_block_image_type(block) + "\n"
 
         if self._settings.compiler_directives.closing_pack_directive:
             txt += self._settings.compiler_directives.closing_pack_directive + "\n"
@@ -156,20 +220,33 @@ class CodeGen_MEEM(CodeGenerator):
         txt += '#include "MEEM_GenConfig.h"\n'
         txt += '#include "MEEM_Internal.h"\n'
         txt += '#include "MEEM_GenInterface.h"\n'
-        txt += "#include <assert.h>\n"
+        if self.is_aligned_caches_used():
+            txt += "#include <string.h>\n"
 
         for hdr in self._settings.external_headers:
             txt += f"#include {hdr}\n"
 
         txt += "\n"
-        txt += self.to_comment_box("   Validation routines", self.TextAlignment.Left) + "\n"
-        txt += self.generate_config_validator_function() + "\n"
+        txt += self.to_comment_box("   Layout checks", self.TextAlignment.Left) + "\n"
+        txt += self.generate_layout_checks() + "\n"
+
+        if self.is_aligned_caches_used():
+            txt += self.to_comment_box("   Cache packing", self.TextAlignment.Left) + "\n"
+            txt += self.generate_cache_packing_functions() + "\n"
+            txt += "\n"
         txt += "\n"
 
         txt += self.to_comment_box("   Block configurations", self.TextAlignment.Left) + "\n"
         txt += self.generate_block_config_struct(False) + "\n"
         txt += "\n"
 
+        if self.is_multiple_devices_used():
+            txt += self.to_comment_box("   Device configurations", self.TextAlignment.Left) + "\n"
+            txt += "/* Access drivers of the additional EEPROM devices. Same contracts as the EEAIF_ operations in MEEM_EEAIF.h. */\n"
+            txt += self.generate_device_driver_prototypes() + "\n"
+            txt += self.generate_device_config_struct() + "\n"
+            txt += "\n"
+
         txt += self.to_comment_box("   Default values", self.TextAlignment.Left) + "\n"
         txt += self.generate_default_objects(False) + "\n"
 
@@ -177,6 +254,7 @@ class CodeGen_MEEM(CodeGenerator):
 
     def generate_MEEM_GenInterface_h(self) -> str:
         txt = self.to_comment_box("   Dependencies", self.TextAlignment.Left) + "\n"
+        txt += "#include <string.h>\n"
         txt += '#include "MEEM_GenConfig.h"\n'
         txt += "\n"
 
@@ -188,17 +266,55 @@ class CodeGen_MEEM(CodeGenerator):
         txt += self.to_comment_box("   Parameter caches", self.TextAlignment.Left) + "\n"
         txt += self.generate_parameter_caches(True) + "\n"
 
+        if self.is_memory_mapped_used():
+            txt += self.to_comment_box("   Memory-mapped blocks", self.TextAlignment.Left) + "\n"
+            txt += self.generate_mapped_data(True) + "\n"
+
+        if self._settings.seqlock_reads:
+            txt += self.to_comment_box("   Tear-free reads", self.TextAlignment.Left) + "\n"
+            txt += self.generate_seqlock_operations() + "\n"
+
+        if self.is_write_behind_used():
+            txt += self.to_comment_box("   Write-behind", self.TextAlignment.Left) + "\n"
+            txt += "/* Marks a block as changed. The core writes it automatically after the block's write-behind delay. */\n"
+            txt += "EXTERN_C void MEEM_MarkBlockDirty(uint8_t block_id);\n\n"
+
         txt += self.to_comment_box("   Parameter access wrappers", self.TextAlignment.Left) + "\n"
         txt += self.to_comment_line("----- Getters -----", self.TextAlignment.Left) + "\n"
-        for block in self._datamodel.children:
+        for block in [b for b in self._datamodel.children if self.has_parameter_getters(b)]:
             for param in block.children:
                 txt += self.generate_parameter_getter_function(block, param) + "\n"
         txt += "\n"
         txt += self.to_comment_line("----- Setters -----", self.TextAlignment.Left) + "\n"
-        for block in self._datamodel.children:
+        for block in self.get_cached_blocks():
             for param in block.children:
                 txt += self.generate_parameter_setter_function(block, param) + "\n"
 
+        if self._settings.seqlock_reads:
+            txt += "\n"
+            txt += self.to_comment_line("----- Snapshot readers -----", self.TextAlignment.Left) + "\n"
+            for block in self.get_cached_blocks():
+                txt += self.generate_block_snapshot_function(block) + "\n"
+                for param in block.children:
+                    txt += self.generate_parameter_snapshot_function(block, param) + "\n"
+
+        txt += "\n"
+        txt += self.to_comment_line("----- Range accessors -----", self.TextAlignment.Left) + "\n"
+        txt += "/* Copy up to 'count' elements of an array, starting at 'first', at once. Return the number of copied elements. */\n"
+        for block in [b for b in self._datamodel.children if self.has_parameter_getters(b)]:
+            for param in [p for p in block.children if p.multiplicity > 1]:
+                txt += self.generate_parameter_range_getter_function(block, param) + "\n"
+                if block.is_cached:
+                    txt += self.generate_parameter_range_setter_function(block, param) + "\n"
+
+        txt += "\n"
+        txt += self.to_comment_line("----- Block snapshots -----", self.TextAlignment.Left) + "\n"
+        txt += "/* Copy all parameters of a block at once. A snapshot returns false if no consistent copy could be made. */\n"
+        for block in [b for b in self._datamodel.children if self.has_parameter_getters(b)]:
+            txt += self.generate_block_copy_function(block) + "\n"
+            if block.is_cached:
+                txt += self.generate_block_restore_function(block) + "\n"
+
         return txt
 
     def generate_MEEM_GenInterface_c(self) -> str:
@@ -209,17 +325,212 @@ class CodeGen_MEEM(CodeGenerator):
 
         txt += self.to_comment_box("   Public global variables", self.TextAlignment.Left) + "\n"
         txt += self.generate_parameter_caches(False) + "\n"
+
+        if self.is_memory_mapped_used():
+            txt += self.generate_mapped_data(False) + "\n"
+
+        if self._settings.seqlock_reads:
+            txt += "volatile uint8_t MEEM_block_sequence[MEEM_BLOCK_COUNT];\n"
         return txt
 
+    def generate_MEEM_GenInterface_hpp(self) -> str:
+        txt = "#ifndef __cplusplus\n"
+        txt += '#error "MEEM_GenInterface.hpp is a C++20 header. C code uses MEEM_GenInterface.h."\n'
+        txt += "#endif\n"
+        txt += "\n"
+        txt += self.to_comment_box("   Dependencies", self.TextAlignment.Left) + "\n"
+        txt += "#include <cstddef>\n"
+        txt += "#include <cstdint>\n"
+        txt += "#include <type_traits>\n"
+        txt += '#include "MEEM.h"\n'
+        txt += "\n"
+
+        txt += self.to_comment_box("   Types", self.TextAlignment.Left) + "\n"
+        txt += "namespace meem\n"
+        txt += "{\n"
+        txt += "/* Management type of a block */\n"
+        txt += "enum class management : uint8_t {\n"
+        txt += ",\n".join(f"    {self.to_cpp_management_type(mt)}" for mt in Block.ManagementTypes) + "\n"
+        txt += "};\n"
+        txt += "\n"
+        txt += "/* Compile-time description of a block */\n"
+        txt += "struct block_descriptor {\n"
+        txt += "    uint8_t              id;\n"
+        txt += "    const char*          name;\n"
+        txt += "    management           management_type;\n"
+        txt += "    uint8_t              device_id;\n"
+        txt += "    MEEM_eepromOffset_t  offset_in_eeprom;\n"
+        txt += "    MEEM_eepromSize_t    size_in_eeprom;\n"
+        txt += "    uint16_t             data_size;\n"
+        txt += "    uint16_t             instance_count;\n"
+        txt += "    bool                 cached;\n"
+        txt += "};\n"
+        txt += "\n"
+        txt += "/* Typed facade of a block. Specialized for each block below. */\n"
+        txt += "template <uint8_t ID>\n"
+        txt += "struct block;\n"
+        txt += "\n"
+        txt += "/* A parameter tag, which belongs to the block B */\n"
+        txt += "template <typename P, typename B>\n"
+        txt += "concept parameter_of = std::is_same_v<typename P::block_type, B>;\n"
+        txt += "}  // namespace meem\n"
+        txt += "\n"
+
+        for block in self._datamodel.children:
+            txt += self.to_comment_box(f"   Block '{block.name}'", self.TextAlignment.Left) + "\n"
+            if self.has_parameter_getters(block):
+                txt += self.generate_cpp_parameter_tags(block) + "\n"
+            txt += self.generate_cpp_block_facade(block) + "\n"
+
+        txt += self.to_comment_box("   All blocks", self.TextAlignment.Left) + "\n"
+        txt += "namespace meem\n"
+        txt += "{\n"
+        txt += "/* Descriptors of all blocks, indexed by block ID */\n"
+        txt += "inline constexpr block_descriptor descriptors[MEEM_BLOCK_COUNT] = {\n"
+        txt += ",\n".join(f"    block<MEEM_BLOCK_{b.name}_ID>::descriptor" for b in self._datamodel.children) + "\n"
+        txt += "};\n"
+        txt += "}  // namespace meem\n"
+        txt += "\n"
+
+        txt += self.to_comment_box("   Layout checks", self.TextAlignment.Left) + "\n"
+        txt += self.generate_cpp_layout_checks()
+        return txt
+
+    def generate_cpp_parameter_tags(self, block: Block) -> str:
+        """Each parameter (or bitfield) is a tag type, which forwards to the C getter/setter, so the facade has no overhead."""
+        txt = f"namespace meem::params::{block.name}\n"
+        txt += "{\n"
+        offset = int(block.has_sequence_counter)
+
+        for param in block.children:
+            array_index_type = "uint16_t" if param.multiplicity > 255 else "uint8_t"
+            index_arg = f"{array_index_type} index" if param.multiplicity > 1 else ""
+            index = "index" if param.multiplicity > 1 else ""
+            accessors = [(param.name, param.name, param.description, None)]
+            if len(param.children) > 0:
+                accessors = [(f"{param.name}_{bf.name}", f"{param.name}_{bf.name}", bf.description, bf.size_in_bits) for bf in param.children]
+
+            for tag, accessor, description, bits in accessors:
+                txt += f"/* {self.sanitize_description(description)} */\n" if description else ""
+                txt += f"struct {tag} {{\n"
+                txt += f"    using block_type = block<MEEM_BLOCK_{block.name}_ID>;\n"
+                txt += f"    using value_type = {str(param.data_type)};\n"
+                txt += f"    static constexpr uint16_t offset       = {offset}u;\n"
+                txt += f"    static constexpr uint16_t multiplicity = {param.multiplicity}u;\n"
+                if bits is not None:
+                    txt += f"    static constexpr uint8_t  size_in_bits = {bits}u;\n"
+                txt += "\n"
+                txt += f"    static value_type get({index_arg}) {{ return MEEM_Get_{block.name}_{accessor}({index}); }}\n"
+                if block.is_cached:
+                    setter_index_arg = f", {index_arg}" if index_arg else ""
+                    setter_index = f", {index}" if index else ""
+                    txt += f"    static void set(value_type value{setter_index_arg}) {{ MEEM_Set_{block.name}_{accessor}(value{setter_index}); }}\n"
+                txt += "};\n"
+                txt += "\n"
+            offset += param.size
+
+        txt = txt.rstrip("\n") + "\n"
+        txt += f"}}  // namespace meem::params::{block.name}\n"
+        return txt
+
+    def generate_cpp_block_facade(self, block: Block) -> str:
+        block_id = f"MEEM_BLOCK_{block.name}_ID"
+        txt = "namespace meem\n"
+        txt += "{\n"
+        txt += "template <>\n"
+        txt += f"struct block<{block_id}> {{\n"
+        txt += f"    using params_type = MEEM_params_{block.name}_t;\n"
+        txt += "\n"
+        txt += "    static constexpr block_descriptor descriptor{\n"
+        txt += f"        /* .id = */ {block_id},\n"
+        txt += f'        /* .name = */ "{block.name}",\n'
+        txt += f"        /* .management_type = */ management::{self.to_cpp_management_type(block.management_type)},\n"
+        txt += f"        /* .device_id = */ {block.device_id}u,\n"
+        txt += f"        /* .offset_in_eeprom = */ {self.to_str(block.offset_in_eeprom)}u,\n"  # type:ignore
+        txt += f"        /* .size_in_eeprom = */ {self.to_str(block.size_in_eeprom)}u,\n"  # type:ignore
+        txt += f"        /* .data_size = */ {block.data_size}u,\n"
+        txt += f"        /* .instance_count = */ {get_physical_instance_count(block)}u,\n"
+        txt += f"        /* .cached = */ {str(block.is_cached).lower()},\n"
+        txt += "    };\n"
+
+        if self.has_parameter_getters(block):
+            txt += "\n"
+            txt += "    template <parameter_of<block> P, typename... Index>\n"
+            txt += "    static typename P::value_type get(Index... index) { return P::get(index...); }\n"
+        if block.is_cached:
+            txt += "\n"
+            txt += "    template <parameter_of<block> P, typename... Index>\n"
+            txt += "    static void set(typename P::value_type value, Index... index) { P::set(value, index...); }\n"
+            txt += "\n"
+            txt += f"    static bool write() {{ return MEEM_InitiateBlockWrite({block_id}); }}\n"
+
+        txt += "\n"
+        txt += f"    static MEEM_blockStatus_t status() {{ return MEEM_GetBlockStatus({block_id}); }}\n"
+        txt += "};\n"
+        txt += "\n"
+        txt += "namespace blocks\n"
+        txt += "{\n"
+        txt += f"    using {block.name} = block<{block_id}>;\n"
+        txt += "}\n"
+        txt += "}  // namespace meem\n"
+        return txt
+
+    def generate_cpp_layout_checks(self) -> str:
+        txt = "/* Generated block types must be byte-aligned packed structures! If any of these fails, check the struct pack directive/attribute. */\n"
+        for block in self._datamodel.children:
+            params_type = self.get_image_type_name(block)
+            txt += f'static_assert(sizeof({params_type}) == {block.data_size}u, "Block \'{block.name}\' is not packed");\n'
+            offset = int(block.has_sequence_counter)
+            for param in block.children:
+                txt += f'static_assert(offsetof({params_type}, {param.name}) == {offset}u, "Parameter \'{block.name}.{param.name}\' is misplaced");\n'
+                offset += param.size
+            if self._settings.zero_copy_writes and block.is_cached:
+                txt += f'static_assert(sizeof(MEEM_image_{block.name}_t) == (sizeof(MEEM_checksum_t) + {block.data_size}u), "Image of block \'{block.name}\' is not packed");\n'
+
+        txt += "\n"
+        txt += "/* Blocks fit their device and don't overlap */\n"
+        for device_id in range(len(self._settings.devices) + 1):
+            capacity = "MEEM_AVAILABLE_EEPROM_BYTES" if device_id == 0 else f"MEEM_DEVICE_{self._settings.devices[device_id - 1].name}_AVAILABLE_BYTES"
+            blocks = sorted([b for b in self._datamodel.children if b.device_id == device_id], key=lambda b: b.offset_in_eeprom)  # type:ignore
+            for block, following in zip(blocks, blocks[1:] + [None]):
+                this = f"meem::blocks::{block.name}::descriptor"
+                end = f"{this}.offset_in_eeprom + {this}.size_in_eeprom"
+                if following is None:
+                    txt += f'static_assert(({end}) <= {capacity}, "Block \'{block.name}\' exceeds its device");\n'
+                else:
+                    txt += f'static_assert(({end}) <= meem::blocks::{following.name}::descriptor.offset_in_eeprom, "Block \'{block.name}\' overlaps \'{following.name}\'");\n'
+        return txt
+
+    def to_cpp_management_type(self, management_type: Block.ManagementTypes) -> str:
+        return str(management_type).removeprefix("MEEM_MGMT_").lower()
+
+    def is_aligned_caches_used(self) -> bool:
+        return self._settings.aligned_caches and any(self.get_cached_blocks())
+
+    def is_aligned_cache(self, block: Block) -> bool:
+        return self._settings.aligned_caches and block.is_cached
+
+    def get_image_type_name(self, block: Block) -> str:
+        """Type with the layout of the block's data in the EEPROM. The same as the type of the cache, unless the cache is aligned."""
+        return f"MEEM_packed_{block.name}_t" if self.is_aligned_cache(block) else f"MEEM_params_{block.name}_t"
+
+    def has_parameter_getters(self, block: Block) -> bool:
+        return block.is_cached or (block.management_type == Block.ManagementTypes.MemoryMapped)
+
     def generate_timestamp(self) -> int:
         return int((datetime.now() - datetime(year=2025, month=1, day=1)).total_seconds())
 
-    def generate_block_type(self, block: Block) -> str:
-        attr = (self._settings.compiler_directives.pack_attribute + " ") if self._settings.compiler_directives.pack_attribute else ""
-        txt = f"/* {self.sanitize_description(block.description)} */\n" if block.description else ""
+    def generate_block_type(self, block: Block, type_name: str, packed: bool) -> str:
+        """A packed type has the layout of the block's data in the EEPROM. An aligned cache has its own type, with natural alignment."""
+        attr = (self._settings.compiler_directives.pack_attribute + " ") if (self._settings.compiler_directives.pack_attribute and packed) else ""
+        txt = ""
+        if self.is_aligned_cache(block) and packed:
+            txt += f"/* Data of '{block.name}', as written to the EEPROM. Its cache is unpacked - see MEEM_UnpackCache(). */\n"
+        elif block.description:
+            txt += f"/* {self.sanitize_description(block.description)} */\n"
         txt += f"typedef struct {attr}{{\n"
 
-        if block.management_type == Block.ManagementTypes.WearLeveling:
+        if block.has_sequence_counter:
             txt += f"    {str(Parameter.DataTypes.uint8)}  do_not_use_me;\n"
 
         for param in block.children:
@@ -239,11 +550,21 @@ class CodeGen_MEEM(CodeGenerator):
                 description = f" /* {self.sanitize_description(param.description)} */" if param.description else ""
                 txt += f"    {str(param.data_type)}  {param.name}{array_suffix};{description}\n"
 
-        txt += f"}} MEEM_params_{block.name}_t;\n"
+        txt += f"}} {type_name};\n"
+        return txt
+
+    def generate_block_image_type(self, block: Block) -> str:
+        """With zero-copy writes, the cache is preceded by the checksum, so they form the image, written to the EEPROM."""
+        attr = (self._settings.compiler_directives.pack_attribute + " ") if self._settings.compiler_directives.pack_attribute else ""
+        txt = f"/* Image of '{block.name}', as written to the EEPROM. Its data is the cache. */\n"
+        txt += f"typedef struct {attr}{{\n"
+        txt += f"    MEEM_checksum_t  checksum;\n"
+        txt += f"    MEEM_params_{block.name}_t  data;\n"
+        txt += f"}} MEEM_image_{block.name}_t;\n"
         return txt
 
     def generate_parameter_getter_function(self, block: Block, param: Parameter) -> str:
-        source_memory = f"MEEM_cache_{block.name}"
+        source_memory = self.generate_block_cache_object_name(block) if block.is_cached else self.generate_block_mapped_object_name(block)
         array_suffix = "[index]" if param.multiplicity > 1 else ""
         array_index_type = f'{"uint16_t" if param.multiplicity > 255 else "uint8_t"}'
         array_arg = f'{(array_index_type + "  index") if param.multiplicity > 1 else ""}'
@@ -270,31 +591,183 @@ class CodeGen_MEEM(CodeGenerator):
 
         if len(param.children) == 0:
             txt += f"static inline void MEEM_Set_{block.name}_{param.name}({str(param.data_type)} value{array_arg}) {{\n"
-            txt += f"    MEEM_cache_{block.name}.{param.name}{array_suffix} = value;\n"
+            if block.write_behind_delay_ms > 0:
+                txt += f"    if (MEEM_cache_{block.name}.{param.name}{array_suffix} != value) {{\n"
+                txt += self.indent(self.generate_cache_update(block, f"{param.name}{array_suffix} = value;"))
+                txt += f"        MEEM_MarkBlockDirty(MEEM_BLOCK_{block.name}_ID);\n"
+                txt += f"    }}\n"
+            else:
+                txt += self.generate_cache_update(block, f"{param.name}{array_suffix} = value;")
             txt += f"}}\n"
         else:
             for bf in param.children:
                 txt += f"static inline void MEEM_Set_{block.name}_{param.name}_{bf.name}({str(param.data_type)} value{array_arg}) {{\n"
-                txt += f"    MEEM_cache_{block.name}.{param.name}{array_suffix}.{bf.name} = value;\n"
+                if block.write_behind_delay_ms > 0:
+                    # Compare the whole container, as the value may not fit in the bitfield
+                    txt += f"    const {str(param.data_type)} previous = MEEM_cache_{block.name}.{param.name}{array_suffix}.all;\n"
+                    txt += self.generate_cache_update(block, f"{param.name}{array_suffix}.{bf.name} = value;")
+                    txt += f"    if (MEEM_cache_{block.name}.{param.name}{array_suffix}.all != previous) {{\n"
+                    txt += f"        MEEM_MarkBlockDirty(MEEM_BLOCK_{block.name}_ID);\n"
+                    txt += f"    }}\n"
+                else:
+                    txt += self.generate_cache_update(block, f"{param.name}{array_suffix}.{bf.name} = value;")
                 txt += f"}}\n"
         return txt
 
+    def indent(self, txt: str) -> str:
+        return "".join(("    " + line) if line.strip() else line for line in txt.splitlines(keepends=True))
+
+    def generate_cache_update(self, block: Block, assignment: str) -> str:
+        """Generates the body of a setter. With seqlock, the store is volatile and enclosed by sequence counter updates."""
+        if not self._settings.seqlock_reads:
+            return f"    MEEM_cache_{block.name}.{assignment}\n"
+
+        txt = f"    MEEM_BeginCacheUpdate(MEEM_BLOCK_{block.name}_ID);\n"
+        txt += f"    ((volatile MEEM_params_{block.name}_t*) &MEEM_cache_{block.name})->{assignment}\n"
+        txt += f"    MEEM_EndCacheUpdate(MEEM_BLOCK_{block.name}_ID);\n"
+        return txt
+
+    def generate_seqlock_operations(self) -> str:
+        txt = "/* Sequence counters of block caches. Odd value means an update in progress. */\n"
+        txt += "EXTERN_C volatile uint8_t MEEM_block_sequence[MEEM_BLOCK_COUNT];\n"
+        txt += "\n"
+        txt += "/* Copies a region of a block's cache, retrying on concurrent update. Returns false if no consistent copy could be made. */\n"
+        txt += "EXTERN_C bool MEEM_ReadConsistent(uint8_t block_id, const volatile void* source, void* destination, uint16_t size);\n"
+        txt += "\n"
+        txt += "/* Updates of a block's cache must be enclosed by these. Updates of the same block must not preempt each other. */\n"
+        txt += "static inline void MEEM_BeginCacheUpdate(uint8_t block_id) {\n"
+        txt += "    MEEM_block_sequence[block_id] = (uint8_t) (MEEM_block_sequence[block_id] + 1u);\n"
+        txt += "    MEEM_MemoryBarrier();\n"
+        txt += "}\n"
+        txt += "\n"
+        txt += "static inline void MEEM_EndCacheUpdate(uint8_t block_id) {\n"
+        txt += "    MEEM_MemoryBarrier();\n"
+        txt += "    MEEM_block_sequence[block_id] = (uint8_t) (MEEM_block_sequence[block_id] + 1u);\n"
+        txt += "}\n"
+        return txt
+
+    def generate_block_snapshot_function(self, block: Block) -> str:
+        txt = f"static inline bool MEEM_Read_{block.name}(MEEM_params_{block.name}_t* snapshot) {{\n"
+        txt += f"    return MEEM_ReadConsistent(MEEM_BLOCK_{block.name}_ID, &MEEM_cache_{block.name}, snapshot, sizeof(MEEM_params_{block.name}_t));\n"
+        txt += f"}}\n"
+        return txt
+
+    def generate_parameter_snapshot_function(self, block: Block, param: Parameter) -> str:
+        array_suffix = "[index]" if param.multiplicity > 1 else ""
+        array_index_type = f'{"uint16_t" if param.multiplicity > 255 else "uint8_t"}'
+        array_arg = f'{(", " + array_index_type + "  index") if param.multiplicity > 1 else ""}'
+
+        txt = f"static inline bool MEEM_Read_{block.name}_{param.name}({str(param.data_type)}* value{array_arg}) {{\n"
+        txt += f"    return MEEM_ReadConsistent(MEEM_BLOCK_{block.name}_ID, &MEEM_cache_{block.name}.{param.name}{array_suffix}, value, sizeof(*value));\n"
+        txt += f"}}\n"
+        return txt
+
+    def generate_range_clamping(self, param: Parameter) -> str:
+        """Bounds a range to the array, so a range accessor never copies past its end."""
+        array_index_type = f'{"uint16_t" if param.multiplicity > 255 else "uint8_t"}'
+        txt = f"    if (first >= {param.multiplicity}u) {{\n"
+        txt += f"        return 0u;\n"
+        txt += f"    }}\n"
+        txt += f"    if (count > ({param.multiplicity}u - first)) {{\n"
+        txt += f"        count = ({array_index_type}) ({param.multiplicity}u - first);\n"
+        txt += f"    }}\n"
+        return txt
+
+    def generate_parameter_range_getter_function(self, block: Block, param: Parameter) -> str:
+        array_index_type = f'{"uint16_t" if param.multiplicity > 255 else "uint8_t"}'
+        txt = f"static inline {array_index_type} MEEM_GetRange_{block.name}_{param.name}({str(param.data_type)}* destination, {array_index_type} first, {array_index_type} count) {{\n"
+        txt += self.generate_range_clamping(param)
+
+        if not block.is_cached:
+            # Mapped data is read-only, so it can't be torn
+            txt += f"    (void) memcpy(destination, &{self.generate_block_mapped_object_name(block)}.{param.name}[first], count * sizeof(*destination));\n"
+            txt += f"    return count;\n"
+        elif self._settings.seqlock_reads:
+            txt += f"    return MEEM_ReadConsistent(MEEM_BLOCK_{block.name}_ID, &MEEM_cache_{block.name}.{param.name}[first], destination, (uint16_t) (count * sizeof(*destination))) ? count : 0u;\n"
+        else:
+            txt += f"    MEEM_EnterCriticalSection();\n"
+            txt += f"    (void) memcpy(destination, &MEEM_cache_{block.name}.{param.name}[first], count * sizeof(*destination));\n"
+            txt += f"    MEEM_ExitCriticalSection();\n"
+            txt += f"    return count;\n"
+        txt += f"}}\n"
+        return txt
+
+    def generate_parameter_range_setter_function(self, block: Block, param: Parameter) -> str:
+        array_index_type = f'{"uint16_t" if param.multiplicity > 255 else "uint8_t"}'
+        txt = f"static inline {array_index_type} MEEM_SetRange_{block.name}_{param.name}(const {str(param.data_type)}* source, {array_index_type} first, {array_index_type} count) {{\n"
+        txt += self.generate_range_clamping(param)
+        txt += self.generate_cache_copy(block, f"&MEEM_cache_{block.name}.{param.name}[first]", "source", "count * sizeof(*source)")
+        txt += f"    return count;\n"
+        txt += f"}}\n"
+        return txt
+
+    def generate_block_copy_function(self, block: Block) -> str:
+        txt = f"static inline bool MEEM_Snapshot_{block.name}(MEEM_params_{block.name}_t* snapshot) {{\n"
+
+        if not block.is_cached:
+            txt += f"    (void) memcpy(snapshot, &{self.generate_block_mapped_object_name(block)}, sizeof(*snapshot));\n"
+            txt += f"    return true;\n"
+        elif self._settings.seqlock_reads:
+            txt += f"    return MEEM_Read_{block.name}(snapshot);\n"
+        else:
+            txt += f"    MEEM_EnterCriticalSection();\n"
+            txt += f"    (void) memcpy(snapshot, &MEEM_cache_{block.name}, sizeof(*snapshot));\n"
+            txt += f"    MEEM_ExitCriticalSection();\n"
+            txt += f"    return true;\n"
+        txt += f"}}\n"
+        return txt
+
+    def generate_block_restore_function(self, block: Block) -> str:
+        # The sequence counter belongs to the core, so a snapshot never overwrites it
+        first_param = block.children[0].name
+        txt = f"static inline void MEEM_Restore_{block.name}(const MEEM_params_{block.name}_t* snapshot) {{\n"
+        if block.has_sequence_counter:
+            size = f"sizeof(*snapshot) - offsetof(MEEM_params_{block.name}_t, {first_param})"
+            txt += self.generate_cache_copy(block, f"&MEEM_cache_{block.name}.{first_param}", f"&snapshot->{first_param}", size)
+        else:
+            txt += self.generate_cache_copy(block, f"&MEEM_cache_{block.name}", "snapshot", "sizeof(*snapshot)")
+        txt += f"}}\n"
+        return txt
+
+    def generate_cache_copy(self, block: Block, destination: str, source: str, size: str) -> str:
+        """Generates a bulk update of a cache: under a single critical section, or enclosed by sequence counter updates with seqlock."""
+        begin, end = ("MEEM_BeginCacheUpdate", "MEEM_EndCacheUpdate") if self._settings.seqlock_reads else ("MEEM_EnterCriticalSection", "MEEM_ExitCriticalSection")
+        begin_call = f"{begin}(MEEM_BLOCK_{block.name}_ID);" if self._settings.seqlock_reads else f"{begin}();"
+        end_call = f"{end}(MEEM_BLOCK_{block.name}_ID);" if self._settings.seqlock_reads else f"{end}();"
+        update = f"    {begin_call}\n"
+        update += f"    (void) memcpy((void*) {destination}, {source}, {size});\n"
+        update += f"    {end_call}\n"
+
+        if block.write_behind_delay_ms == 0:
+            return update
+
+        txt = f"    if (memcmp((const void*) {destination}, {source}, {size}) != 0) {{\n"
+        txt += self.indent(update)
+        txt += f"        MEEM_MarkBlockDirty(MEEM_BLOCK_{block.name}_ID);\n"
+        txt += f"    }}\n"
+        return txt
+
     def generate_wrappers_of_external_operations(self) -> str:
         txt = f"#define MEEM_EnterCriticalSection()    {'' if self._settings.enter_critical_section_operation is None else self._settings.enter_critical_section_operation}\n"
         txt += f"#define MEEM_ExitCriticalSection()     {'' if self._settings.exit_critical_section_operation is None else self._settings.exit_critical_section_operation}\n"
+        txt += f"#define MEEM_MemoryBarrier()           {'' if self._settings.memory_barrier_operation is None else self._settings.memory_barrier_operation + '()'}\n"
+        if self._settings.seqlock_reads:
+            txt += f"#define MEEM_SeqlockWait()             {'' if self._settings.seqlock_wait_operation is None else self._settings.seqlock_wait_operation + '()'}\n"
         return txt
 
     def generate_parameter_caches(self, for_prototype: bool) -> str:
         txt = ""
         ext = "EXTERN_C " if for_prototype else ""
 
-        for block in self._datamodel.children:
+        for block in self.get_cached_blocks():
             if (block.name in self._settings.compiler_directives.block_placement_directives) and for_prototype:
                 directive = self._settings.compiler_directives.block_placement_directives[block.name].directive_for_cache
                 if directive:
                     txt += directive + "\n"
 
             txt += f"{ext}{self.generate_parameter_cache(block, for_prototype)};\n"
+            if self._settings.zero_copy_writes and for_prototype:
+                txt += f"#define {self.generate_block_cache_object_name(block)}    ({self.generate_block_image_object_name(block)}.data)\n"
         return txt
 
     def generate_parameter_cache(self, block: Block, for_prototype: bool) -> str:
@@ -304,21 +777,37 @@ class CodeGen_MEEM(CodeGenerator):
             if attr:
                 attribute = attr + " "
 
+        if self._settings.zero_copy_writes:
+            return f"MEEM_image_{block.name}_t {attribute}{self.generate_block_image_object_name(block)}"
         return f"MEEM_params_{block.name}_t {attribute}{self.generate_block_cache_object_name(block)}"
 
+    def generate_mapped_data(self, for_prototype: bool) -> str:
+        """Memory-mapped blocks are read where the device maps them. Until MEEM_Init() validates them, and if invalid, they're read as defaults."""
+        if not for_prototype:
+            views = [
+                f"(const uint8_t*)&MEEM_defaults_{b.name}" if b.management_type == Block.ManagementTypes.MemoryMapped else "NULL" for b in self._datamodel.children
+            ]
+            return "const uint8_t* MEEM_mapped_data[MEEM_BLOCK_COUNT] = {\n" + ",\n".join(f"    {v}" for v in views) + "\n};"
+
+        txt = "/* Data of the memory-mapped blocks, as seen by their getters. Set by MEEM_Init(). NULL for the other blocks. */\n"
+        txt += "EXTERN_C const uint8_t* MEEM_mapped_data[MEEM_BLOCK_COUNT];\n"
+        for block in [b for b in self._datamodel.children if b.management_type == Block.ManagementTypes.MemoryMapped]:
+            txt += f"#define {self.generate_block_mapped_object_name(block)}    (*(const MEEM_params_{block.name}_t*) MEEM_mapped_data[MEEM_BLOCK_{block.name}_ID])\n"
+        return txt
+
     def generate_default_objects(self, for_prototype: bool) -> str:
         txt = ""
 
         for block in self._datamodel.children:
-            if block.default_pattern is None:
+            if self.get_compressed_defaults(block) is None:
                 txt += (
-                    f"EXTERN_C const MEEM_params_{block.name}_t  MEEM_defaults_{block.name};"
+                    f"EXTERN_C const {self.get_image_type_name(block)}  MEEM_defaults_{block.name};"
                     if for_prototype
                     else self.generate_definition_of_defaults_as_struct(block)
                 )
             else:
                 txt += (
-                    f"EXTERN_C const uint8_t  MEEM_defaults_{block.name}[{len(block.default_pattern)}];"
+                    f"EXTERN_C const uint8_t  MEEM_defaults_{block.name}[{len(self.get_compressed_defaults(block))}];"
                     if for_prototype
                     else self.generate_definition_of_defaults_as_bytes(block)
                 )
@@ -338,9 +827,9 @@ class CodeGen_MEEM(CodeGenerator):
             if directive is not None:
                 txt += directive + "\n"
 
-        txt += f"const MEEM_params_{block.name}_t{placement_attribute}  MEEM_defaults_{block.name} = {{\n"
+        txt += f"const {self.get_image_type_name(block)}{placement_attribute}  MEEM_defaults_{block.name} = {{\n"
 
-        if block.management_type == Block.ManagementTypes.WearLeveling:
+        if block.has_sequence_counter:
             txt += "    /* .do_not_use_me = */ 0,\n"
 
         for param in block.children:
@@ -365,10 +854,15 @@ class CodeGen_MEEM(CodeGenerator):
         if placement_directive is not None:
             txt += placement_directive + "\n"
 
-        assert block.default_pattern != None
-        txt += f'const uint8_t {placement_attribute}MEEM_defaults_{block.name}[{len(block.default_pattern)}] = {{ {", ".join(f"0x{b:02X}" for b in block.default_pattern)} }};'
+        compressed_defaults = self.get_compressed_defaults(block)
+        assert compressed_defaults != None
+        txt += f'const uint8_t {placement_attribute}MEEM_defaults_{block.name}[{len(compressed_defaults)}] = {{ {", ".join(f"0x{b:02X}" for b in compressed_defaults)} }};'
         return txt
 
+    def get_compressed_defaults(self, block: Block) -> Optional[bytes]:
+        """The default pattern or the run-length encoded defaults of a block. None, if its defaults are not compressed."""
+        return block.default_pattern if block.encoded_defaults is None else block.encoded_defaults
+
     def generate_definition_of_defaults_for_parameter(self, param: Parameter) -> str:
         txt = f"    /* .{param.name} = */ "
 
@@ -401,44 +895,147 @@ class CodeGen_MEEM(CodeGenerator):
 
         return txt
 
-    def generate_config_validator_function(self) -> str:
-        txt = "void MEEM_ValidateConfiguration(void)\n"
-        txt += "{\n"
-        txt += (
-            "    /* If any of the following assertions fails, you probably missed to specify a struct pack directive/attribute in the platform settings. */\n"
-        )
-        txt += "    /* Generated block types must be byte-aligned packed structures! */\n"
+    def generate_layout_checks(self) -> str:
+        """Checks the layout at compile time, in any C dialect: the array size of a typedef is negative, if a check fails."""
+        txt = "/* If any of the following checks fails to compile, you probably missed to specify a struct pack directive/attribute in the platform settings. */\n"
+        txt += "/* Generated block types must be byte-aligned packed structures! */\n"
         for block in self._datamodel.children:
-            txt += f"    assert(sizeof(MEEM_params_{block.name}_t) == {block.data_size});\n"
-        txt += "}"
+            txt += f"typedef char MEEM_packed_{block.name}[(sizeof({self.get_image_type_name(block)}) == {block.data_size}U) ? 1 : -1];\n"
+            if self._settings.zero_copy_writes and block.is_cached:
+                txt += f"typedef char MEEM_packed_image_{block.name}[(sizeof(MEEM_image_{block.name}_t) == (sizeof(MEEM_checksum_t) + {block.data_size}U)) ? 1 : -1];\n"
+
+        if self.is_aligned_caches_used():
+            txt += "\n"
+            txt += "/* Parameters of aligned caches are packed/unpacked as a whole. Their sizes must match the ones in the EEPROM. */\n"
+            for block in [b for b in self._datamodel.children if self.is_aligned_cache(b)]:
+                for param in block.children:
+                    txt += f"typedef char MEEM_aligned_{block.name}_{param.name}[(sizeof({self.generate_block_cache_object_name(block)}.{param.name}) == {param.size}U) ? 1 : -1];\n"
         return txt
 
+    def generate_cache_packing_functions(self) -> str:
+        """Parameters are copied one by one, between their offsets in the image and in the aligned cache. A cache is unpacked in reverse order,
+        by memmove(), so it may be unpacked in place - no parameter moves back, as the cache only adds padding."""
+        pack = "void MEEM_PackCache(uint8_t block_id, uint8_t* dest)\n{\n    switch (block_id)\n    {\n"
+        unpack = "void MEEM_UnpackCache(uint8_t block_id, const uint8_t* source)\n{\n    switch (block_id)\n    {\n"
+
+        for block in [b for b in self._datamodel.children if self.is_aligned_cache(b)]:
+            cache = self.generate_block_cache_object_name(block)
+            members = [("do_not_use_me", 0, 1)] if block.has_sequence_counter else []
+            offset = int(block.has_sequence_counter)
+            for param in block.children:
+                members.append((param.name, offset, param.size))
+                offset += param.size
+
+            pack += f"        case MEEM_BLOCK_{block.name}_ID:\n"
+            unpack += f"        case MEEM_BLOCK_{block.name}_ID:\n"
+            for name, offset, size in members:
+                pack += f"            (void) memcpy(&dest[{offset}], &{cache}.{name}, {size}u);\n"
+            for name, offset, size in reversed(members):
+                unpack += f"            (void) memmove(&{cache}.{name}, &source[{offset}], {size}u);\n"
+            pack += "            break;\n"
+            unpack += "            break;\n"
+
+        pack += "        default:\n            break;\n    }\n}"
+        unpack += "        default:\n            break;\n    }\n}"
+        return pack + "\n\n" + unpack
+
     def generate_block_config_struct(self, for_prototype: bool) -> str:
         if for_prototype:
             return "EXTERN_C const MEEM_blockConfig_t   MEEM_block_config[ MEEM_BLOCK_COUNT ];"
 
         configs = []
         for block in self._datamodel.children:
-            cast = "(const uint8_t*)&" if block.default_pattern is None else ""
+            cast = "(const uint8_t*)&" if self.get_compressed_defaults(block) is None else ""
+            cache = f"(uint8_t*)&{self.generate_block_cache_object_name(block)}" if block.is_cached else "NULL"
+
+            fields = [
+                f"/* .cache = */ {cache}",
+                f"/* .defaults = */ {cast}MEEM_defaults_{block.name}",
+                f"/* .offset_in_eeprom = */ {self.to_str(block.offset_in_eeprom)}",  # type:ignore
+                f"/* .data_size = */ {block.data_size}",
+            ]
+            if self.is_aligned_caches_used():
+                fields.append(f"/* .cache_size = */ {f'sizeof({self.generate_block_cache_object_name(block)})' if block.is_cached else 0}")
+            fields += [
+                f"/* .default_pattern_length = */ {0 if block.default_pattern is None else len(block.default_pattern)}",
+                f"/* .instance_count = */ {get_physical_instance_count(block)}",
+                f"/* .management_type = */ {str(block.management_type)}",
+                f"/* .data_recovery_strategy = */ {str(block.data_recovery_strategy)}",
+            ]
+            if self.is_run_length_defaults_used():
+                fields.append(f"/* .run_length_defaults = */ {int(block.encoded_defaults is not None)}")
+            if self.is_flash_emulation_used():
+                fields.append(f"/* .slots_per_sector = */ {block.slots_per_sector}")
+            if self.is_read_through_used():
+                fields.append(f"/* .chunk_size = */ {block.chunk_size if block.management_type == Block.ManagementTypes.ReadThrough else 0}")
+            if self.is_write_behind_used():
+                fields.append(f"/* .write_behind_delay = */ {get_write_behind_delay_ticks(block, self._settings)}")
+            if self.is_write_throttling_used():
+                fields.append(f"/* .coalescing_window = */ {get_coalescing_window_ticks(block, self._settings)}")
+                fields.append(f"/* .write_budget = */ {block.max_writes_per_hour}")
+                fields.append(f"/* .write_budget_period = */ {get_write_budget_period_ticks(block, self._settings)}UL")
+            if self.is_transactions_used():
+                fields.append(f"/* .journal_offset = */ {self.to_str(block.journal_offset or 0)}")
+            if self.is_flush_planner_used():
+                fields.append(f"/* .flush_priority = */ {block.flush_priority}")
+            if self.is_multiple_devices_used():
+                fields.append(f"/* .device_id = */ {block.device_id}")
 
             txt = f"    /* Block '{block.name}' */\n"
             txt += f"    {{\n"
-            txt += f"        /* .cache = */ (uint8_t*)&MEEM_cache_{block.name},\n"
-            txt += f"        /* .defaults = */ {cast}MEEM_defaults_{block.name},\n"
-            txt += f"        /* .offset_in_eeprom = */ {self.to_str(block.offset_in_eeprom)},\n"  # type:ignore
-            txt += f"        /* .data_size = */ {block.data_size},\n"
-            txt += f"        /* .default_pattern_length = */ {0 if block.default_pattern is None else len(block.default_pattern)},\n"
-            txt += f"        /* .instance_count = */ {block.instance_count},\n"
-            txt += f"        /* .management_type = */ {str(block.management_type)},\n"
-            txt += f"        /* .data_recovery_strategy = */ {str(block.data_recovery_strategy)}\n"
+            txt += ",\n".join(f"        {field}" for field in fields) + "\n"
             txt += f"    }}"
             configs.append(txt)
 
         return "const MEEM_blockConfig_t   MEEM_block_config[ MEEM_BLOCK_COUNT ] = {\n" + ",\n".join(configs) + "\n};"
 
+    def generate_device_driver_prototypes(self) -> str:
+        txt = ""
+        for device in self._settings.devices:
+            prefix = device.eeaif_prefix
+            txt += f"EXTERN_C void           {prefix}_Init(void);\n"
+            txt += f"EXTERN_C void           {prefix}_DeInit(void);\n"
+            txt += f"EXTERN_C void           {prefix}_Task(void);\n"
+            txt += f"EXTERN_C bool           {prefix}_BeginRead(MEEM_eepromOffset_t offset_in_eeprom, uint8_t* dest, MEEM_eepromSize_t size);\n"
+            txt += f"EXTERN_C bool           {prefix}_BeginWrite(MEEM_eepromOffset_t offset_in_eeprom, const uint8_t* source, MEEM_eepromSize_t size);\n"
+            txt += f"EXTERN_C EEAIF_status_t {prefix}_GetStatus(void);\n"
+        return txt
+
+    def generate_device_config_struct(self) -> str:
+        drivers = [("EEAIF", self._settings.eeprom_page_size, self._settings.page_write_time_us, "primary")]
+        drivers += [(d.eeaif_prefix, d.eeprom_page_size, d.page_write_time_us, d.name) for d in self._settings.devices]
+
+        configs = []
+        for prefix, page_size, page_write_time_us, name in drivers:
+            fields = [
+                f"/* .init = */ {prefix}_Init",
+                f"/* .deinit = */ {prefix}_DeInit",
+                f"/* .task = */ {prefix}_Task",
+                f"/* .begin_read = */ {prefix}_BeginRead",
+                f"/* .begin_write = */ {prefix}_BeginWrite",
+                f"/* .get_status = */ {prefix}_GetStatus",
+            ]
+            if self.is_flush_planner_used():
+                fields.append(f"/* .page_size = */ {self.to_str(page_size)}")
+                fields.append(f"/* .page_write_time_us = */ {self.to_str(page_write_time_us)}")
+
+            txt = f"    /* Device '{name}' */\n"
+            txt += f"    {{\n"
+            txt += ",\n".join(f"        {field}" for field in fields) + "\n"
+            txt += f"    }}"
+            configs.append(txt)
+
+        return "const MEEM_deviceConfig_t  MEEM_device_config[ MEEM_DEVICE_COUNT ] = {\n" + ",\n".join(configs) + "\n};"
+
     def generate_block_cache_object_name(self, block: Block) -> str:
         return f"MEEM_cache_{block.name}"
 
+    def generate_block_image_object_name(self, block: Block) -> str:
+        return f"MEEM_image_{block.name}"
+
+    def generate_block_mapped_object_name(self, block: Block) -> str:
+        return f"MEEM_mapped_{block.name}"
+
     def sanitize_description(self, comment: str) -> str:
         return comment.replace("//", "").replace("/*", "").replace("*/", "").replace("\n", " ").replace("\r", " ").strip()
 
@@ -450,14 +1047,102 @@ class CodeGen_MEEM(CodeGenerator):
         return Parameter.DataTypes.uint32
 
     def get_max_wl_instance_count(self) -> int:
-        instance_counts = [b.instance_count for b in self._datamodel.children if b.management_type == Block.ManagementTypes.WearLeveling]
+        instance_counts = [get_physical_instance_count(b) for b in self._datamodel.children if b.has_sequence_counter]
 
         if instance_counts:
             return max(instance_counts)
         return 0
 
+    def is_write_behind_used(self) -> bool:
+        return any(b.write_behind_delay_ms > 0 for b in self._datamodel.children)
+
+    def is_write_throttling_used(self) -> bool:
+        return any((b.write_coalescing_window_ms > 0) or (b.max_writes_per_hour > 0) for b in self._datamodel.children)
+
+    def is_transactions_used(self) -> bool:
+        return any(b.transactional for b in self._datamodel.children)
+
+    def is_flush_planner_used(self) -> bool:
+        return self._settings.page_write_time_us > 0
+
+    def is_multiple_devices_used(self) -> bool:
+        return len(self._settings.devices) > 0
+
+    def is_flash_emulation_used(self) -> bool:
+        return any(b.management_type == Block.ManagementTypes.FlashEmulation for b in self._datamodel.children)
+
+    def is_read_through_used(self) -> bool:
+        return any(b.management_type == Block.ManagementTypes.ReadThrough for b in self._datamodel.children)
+
+    def is_memory_mapped_used(self) -> bool:
+        return any(b.management_type == Block.ManagementTypes.MemoryMapped for b in self._datamodel.children)
+
+    def generate_core_specialization(self) -> str:
+        blocks = self._datamodel.children
+        accessors = [
+            ("MEEM_ManagementType", "management_type", [str(b.management_type) for b in blocks]),
+            ("MEEM_DataRecoveryStrategy", "data_recovery_strategy", [str(b.data_recovery_strategy) for b in blocks]),
+            ("MEEM_DefaultPatternLength", "default_pattern_length", [f"{0 if b.default_pattern is None else len(b.default_pattern)}u" for b in blocks]),
+            ("MEEM_InstanceCount", "instance_count", [f"{get_physical_instance_count(b)}u" for b in blocks]),
+        ]
+
+        txt = ""
+        for name, field, values in accessors:
+            # A folded value still takes the configuration, so the variables, which hold it, aren't reported as unused
+            folded = f"((void) (block_cfg), {values[0]})" if all(v == values[0] for v in values) else f"((block_cfg)->{field})"
+            txt += f"#define {name}(block_cfg)    {folded}\n"
+
+        # The per-tick scans visit only the blocks they apply to
+        scans = [
+            ("THROTTLED", [get_coalescing_window_ticks(b, self._settings) > 0 or b.max_writes_per_hour > 0 for b in blocks]),
+            ("FLASH_EMULATION", [b.management_type == Block.ManagementTypes.FlashEmulation for b in blocks]),
+        ]
+        for name, applies in scans:
+            ids = [str(i) for i, a in enumerate(applies) if a]
+            if len(ids) > 0:
+                txt += f"#define MEEM_{name}_BLOCK_COUNT    {len(ids)}u\n"
+                txt += f"#define MEEM_{name}_BLOCK_IDS    {{ {', '.join(ids)} }}\n"
+        return txt
+
+    def is_run_length_defaults_used(self) -> bool:
+        return any(b.encoded_defaults is not None for b in self._datamodel.children)
+
+    def get_cached_blocks(self) -> List[Block]:
+        return [b for b in self._datamodel.children if b.is_cached]
+
+    def is_32bit_addressing_used(self) -> bool:
+        return any(get_device_eeprom_size(device_id, self._settings) > 0x10000 for device_id in range(len(self._settings.devices) + 1))
+
+    def get_address_data_type(self) -> str:
+        return "uint32_t" if self.is_32bit_addressing_used() else "uint16_t"
+
+    def is_write_batching_used(self) -> bool:
+        return (self._settings.write_batch_size > 0) and (len([b for b in self._datamodel.children if b.management_type == Block.ManagementTypes.Basic]) > 1)
+
+    def get_max_instance_count(self) -> int:
+        return max([get_physical_instance_count(b) for b in self._datamodel.children])
+
+    def get_largest_image_size(self) -> int:
+        """Read-through blocks are transferred chunk by chunk, so their images are the chunks. Memory-mapped blocks are never transferred."""
+        sizes = [
+            b.chunk_size if b.management_type == Block.ManagementTypes.ReadThrough else b.data_size
+            for b in self._datamodel.children
+            if b.management_type != Block.ManagementTypes.MemoryMapped
+        ]
+        return self._datamodel.checksum_size + max(sizes, default=0)
+
     def calculate_workbuffer_size(self) -> int:
-        return self._datamodel.checksum_size + max([b.data_size for b in self._datamodel.children])
+        if self._settings.streaming_chunk_size > 0:
+            return self._settings.streaming_chunk_size  # Images are transferred chunk by chunk
+
+        size = self.get_largest_image_size()
+
+        if self.is_transactions_used():
+            size = max(size, get_transaction_record_size(self._datamodel))  # The commit record is written from the work buffer, too
+
+        if self.is_write_batching_used():
+            size = max(size, self._settings.write_batch_size)  # Batched writes are assembled in the work buffer
+        return size
 
     def get_default_for_bitfield(self, param: Parameter, array_index: int, bitfield: Bitfield) -> int:
         offset = sum([bf.size_in_bits for bf in param.children[: param.children.index(bitfield)]])
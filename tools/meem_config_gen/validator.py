@@ -7,7 +7,8 @@ sys.path.append(os.path.dirname(os.path.dirname(os.path.dirname(__file__))))
 from colorama import Fore
 from common.data_model import *
 from common.platform_settings import PlatformSettings
-from common.utils import attach_block_metadata
+from common.utils import attach_block_metadata, get_write_behind_delay_ticks, get_coalescing_window_ticks, get_used_eeprom_size, get_layout_savings
+from common.utils import get_device_eeprom_size, get_device_name
 
 
 class CodeGenValidator:
@@ -22,17 +23,71 @@ class CodeGenValidator:
         if len(datamodel.children) > 254:
             errors.append(f"The mEEM doesn't support more than 254 blocks.")
 
-        last_block = datamodel.children[-1]
-        required_eeprom = last_block.offset_in_eeprom + last_block.size_in_eeprom  # type: ignore
+        required_eeprom = get_used_eeprom_size(datamodel)
 
         if required_eeprom > settings.eeprom_size:
             errors.append(f"Your datamodel requires {required_eeprom} bytes of EEPROM, but you have only {settings.eeprom_size} bytes available.")
 
+        for device_id in range(1, len(settings.devices) + 1):
+            required_device_eeprom = get_used_eeprom_size(datamodel, device_id)
+            if required_device_eeprom > get_device_eeprom_size(device_id, settings):
+                errors.append(
+                    f"Your datamodel requires {required_device_eeprom} bytes of device '{get_device_name(device_id, settings)}', but it has only {get_device_eeprom_size(device_id, settings)} bytes available."
+                )
+
+        for block in [b for b in datamodel.children if b.transactional and b.device_id != 0]:
+            errors.append(f"Block '{block.name}' is transactional, so it must be stored in the primary device, along with the transaction journal.")
+
+        for block in [b for b in datamodel.children if b.management_type == Block.ManagementTypes.FlashEmulation]:
+            if settings.flash_sector_size == 0:
+                errors.append(f"Block '{block.name}' is a flash emulation block, which requires 'flash_sector_size' in the platform settings.")
+            elif block.slots_per_sector == 0:
+                errors.append(f"Block '{block.name}' doesn't fit in a FLASH sector of {settings.flash_sector_size} bytes!")
+            if block.device_id != 0:
+                errors.append(f"Block '{block.name}' is a flash emulation block, so it must be stored in the primary device, which is erased with EEAIF_BeginErase().")
+
+        for block in [b for b in datamodel.children if b.management_type == Block.ManagementTypes.MemoryMapped and b.device_id != 0]:
+            errors.append(f"Block '{block.name}' is a memory-mapped block, so it must be stored in the primary device, which is mapped with EEAIF_GetMappedAddress().")
+
+        if settings.streaming_chunk_size > 0:
+            if settings.streaming_chunk_size < datamodel.checksum_size + 2:
+                errors.append(f"'streaming_chunk_size' should be at least {datamodel.checksum_size + 2} bytes - a checksum and some data.")
+            if any([b for b in datamodel.children if b.transactional]):
+                errors.append(f"Streaming I/O can't be used with transactional blocks, whose journal is assembled in the work buffer.")
+            if (settings.write_batch_size > 0) and (len([b for b in datamodel.children if b.management_type == Block.ManagementTypes.Basic]) > 1):
+                errors.append(f"Streaming I/O can't be used with write batching, which assembles several blocks in the work buffer. Set 'write_batch_size' to 0.")
+            if any([b for b in datamodel.children if b.management_type == Block.ManagementTypes.FlashEmulation]):
+                errors.append(f"Streaming I/O can't be used with flash emulation blocks, whose slots are checked for being blank in the work buffer.")
+
+        for block in [b for b in datamodel.children if b.management_type == Block.ManagementTypes.ReadThrough]:
+            if (settings.streaming_chunk_size > 0) and (settings.streaming_chunk_size < datamodel.checksum_size + block.chunk_size):
+                errors.append(f"Block '{block.name}' is a read-through block, whose chunks must fit in the work buffer. Set 'streaming_chunk_size' to at least {datamodel.checksum_size + block.chunk_size} bytes.")
+
+        if settings.zero_copy_writes:
+            if not settings.seqlock_reads:
+                errors.append(f"Zero-copy writes require 'seqlock_reads', whose sequence counters tell if a cache was updated, while it was written.")
+            if (settings.write_batch_size > 0) and (len([b for b in datamodel.children if b.management_type == Block.ManagementTypes.Basic]) > 1):
+                errors.append(f"Zero-copy writes can't be used with write batching, which assembles several blocks in the work buffer. Set 'write_batch_size' to 0.")
+            if any([b for b in datamodel.children if b.management_type == Block.ManagementTypes.FlashEmulation]):
+                errors.append(f"Zero-copy writes can't be used with flash emulation blocks, whose slots can't be written again, if the cache was updated meanwhile.")
+
+        if settings.aligned_caches:
+            if settings.streaming_chunk_size > 0:
+                errors.append(f"Aligned caches can't be used with streaming I/O, which transfers a cache as it is, chunk by chunk. Set 'streaming_chunk_size' to 0.")
+            if settings.zero_copy_writes:
+                errors.append(f"Aligned caches can't be used with zero-copy writes, which write a cache as it is.")
+
         for block in [b for b in datamodel.children if b.default_pattern != None and len(b.default_pattern) > 255]:
             errors.append(
                 f"Block '{block.name}' has too large default pattern (> 255 bytes)! You may either reduce the block size or disable the compression of defaults."
             )
 
+        for block in [b for b in datamodel.children if get_write_behind_delay_ticks(b, settings) > 0xFFFF]:
+            errors.append(f"Block '{block.name}' has too long write-behind delay! It must not exceed 65535 task periods.")
+
+        for block in [b for b in datamodel.children if get_coalescing_window_ticks(b, settings) > 0xFFFF]:
+            errors.append(f"Block '{block.name}' has too long coalescing window! It must not exceed 65535 task periods.")
+
         # Check block alignments to EEPROM's page
         if settings.eeprom_page_size > 0:
             block_names = [block.name for block in datamodel.children]
@@ -45,7 +100,7 @@ class CodeGenValidator:
             for block in [b for b in datamodel.children if b.management_type == Block.ManagementTypes.WearLeveling]:
                 instance_size = block.data_size + datamodel.checksum_size
 
-                if (not align_all_blocks) and block.name not in settings.page_aligned_blocks:
+                if (not align_all_blocks) and (block.name not in settings.page_aligned_blocks) and (not settings.optimize_layout):
                     print(
                         f"{Fore.YELLOW}:Warning: it's highly recommended block '{block.name}' to be aligned to EEPROM page boundary! Add it to platform settings -> page_aligned_blocks[]."
                     )
@@ -54,8 +109,17 @@ class CodeGenValidator:
                         f"{Fore.YELLOW}:Warning: block '{block.name}'s data size is not multiple of EEPROM page size! You may add a dummy parameter with a size of {settings.eeprom_page_size - (instance_size % settings.eeprom_page_size)} bytes to fill in."
                     )
 
+        if settings.keep_block_order and not settings.optimize_layout:
+            print(f"{Fore.YELLOW}:Warning: 'keep_block_order' has no effect without 'optimize_layout'.")
+
         if errors:
             raise Exception("\n".join(f"- {error}" for error in errors))
 
         # No exceptions at this point, print report
         print(f"{Fore.BLUE}Your configuration requires {required_eeprom} bytes of EEPROM")
+
+        if settings.optimize_layout:
+            savings = get_layout_savings(datamodel, settings)
+            print(f"{Fore.BLUE}Layout optimization saves {sum(s[1] for s in savings)} bytes of EEPROM, compared to the definition order:")
+            for block, bytes_saved, page_writes_saved in savings:
+                print(f"{Fore.BLUE}  '{block.name}' at {block.offset_in_eeprom}: {bytes_saved} bytes, {page_writes_saved:.2f} page writes per write saved")